@@ -0,0 +1,32 @@
+#!/bin/sh
+#
+# Residual fill time against points per edge, with and without the
+# sum-factorized spectral element kernels ("Use Sum Factorization").
+#
+# Usage: ./benchmark.sh [AlbanyT executable] [max element degree]
+#
+# Runs input_24elesSpectralT.xml for element degrees 1..max (points per
+# edge = degree + 1) and prints the "> Albany Fill: Residual" timer
+# (total time and number of calls) of each run.
+
+ALBANY=${1:-AlbanyT}
+MAXDEGREE=${2:-8}
+INPUT=input_24elesSpectralT.xml
+
+printf "%-16s %-16s %s\n" "points_per_edge" "sum_factorized" "residual fill time (calls)"
+
+degree=1
+while [ $degree -le $MAXDEGREE ]; do
+  for sumfact in false true; do
+    run=benchmark_np$((degree+1))_$sumfact
+    sed -e "s|\"Element Degree\" type=\"int\" value=\"[0-9]*\"|\"Element Degree\" type=\"int\" value=\"$degree\"|" \
+        -e "s|\"Use Sum Factorization\" type=\"bool\" value=\"[a-z]*\"|\"Use Sum Factorization\" type=\"bool\" value=\"$sumfact\"|" \
+        -e "s|\"Number of Comparisons\" type=\"int\" value=\"[0-9]*\"|\"Number of Comparisons\" type=\"int\" value=\"0\"|" \
+        -e "s|spectral_24eles_sumfact_out.exo|$run.exo|" \
+        $INPUT > $run.xml
+    $ALBANY $run.xml > $run.log 2>&1
+    time=`grep "> Albany Fill: Residual" $run.log | head -1 | sed -e 's|.*Albany Fill: Residual *||'`
+    printf "%-16s %-16s %s\n" $((degree+1)) $sumfact "${time:-failed, see $run.log}"
+  done
+  degree=$((degree+1))
+done
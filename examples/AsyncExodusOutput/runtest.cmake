@@ -0,0 +1,32 @@
+# Run AlbanyT with synchronous and asynchronous exodus output and compare
+# the two files with exodiff
+
+foreach(INPUT inputSyncT.xml inputAsyncT.xml)
+  message("Running the command:")
+  message("${TEST_PROG} " " ${INPUT}")
+
+  EXECUTE_PROCESS(COMMAND ${TEST_PROG} ${INPUT}
+                  RESULT_VARIABLE HAD_ERROR)
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "Albany didn't run on ${INPUT}: test failed")
+  endif()
+endforeach()
+
+if (NOT SEACAS_EXODIFF)
+  message(FATAL_ERROR "Cannot find exodiff")
+endif()
+
+SET(EXODIFF_TEST ${SEACAS_EXODIFF} th1d_sync.exo th1d_async.exo)
+
+message("Running the command:")
+message("${EXODIFF_TEST}")
+
+EXECUTE_PROCESS(
+    COMMAND ${EXODIFF_TEST}
+    OUTPUT_FILE exodiff.out
+    RESULT_VARIABLE HAD_ERROR)
+
+if(HAD_ERROR)
+  message(FATAL_ERROR "Asynchronous exodus output differs from the synchronous one: test failed")
+endif()
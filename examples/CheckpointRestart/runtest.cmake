@@ -0,0 +1,39 @@
+# Run AlbanyT on an input file and return the mean value of its final
+# solution, failing if the run or its regression comparisons fail
+
+function(run_albany INPUT MEAN_VALUE)
+  message("Running the command:")
+  message("${TEST_PROG} " " ${INPUT}")
+
+  EXECUTE_PROCESS(COMMAND ${TEST_PROG} ${INPUT}
+                  OUTPUT_VARIABLE OUTPUT
+                  RESULT_VARIABLE HAD_ERROR)
+  message("${OUTPUT}")
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "Albany didn't run on ${INPUT}: test failed")
+  endif()
+
+  STRING(REGEX MATCH "MeanValue of final solution ([^\n]*)" MATCHED "${OUTPUT}")
+  if(NOT MATCHED)
+    message(FATAL_ERROR "No final solution in the output of ${INPUT}: test failed")
+  endif()
+  set(${MEAN_VALUE} ${CMAKE_MATCH_1} PARENT_SCOPE)
+endfunction()
+
+# 1. Uninterrupted run to t = 1
+run_albany(inputT.xml FULL_MEAN)
+
+# 2. Run to t = 0.5 writing checkpoints, then restart from the last one
+file(GLOB OLD_CHECKPOINTS th1d_checkpoint.*)
+if(OLD_CHECKPOINTS)
+  file(REMOVE ${OLD_CHECKPOINTS})
+endif()
+run_albany(inputWriteT.xml WRITE_MEAN)
+run_albany(inputRestartT.xml RESTART_MEAN)
+
+# 3. The restarted run has to end on the solution of the uninterrupted one
+if(NOT FULL_MEAN STREQUAL RESTART_MEAN)
+  message(FATAL_ERROR "Restarted mean value ${RESTART_MEAN} differs from "
+                      "uninterrupted ${FULL_MEAN}: test failed")
+endif()
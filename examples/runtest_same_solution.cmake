@@ -0,0 +1,31 @@
+# Run TEST_PROG on each input file of TEST_INPUTS and check that all the runs
+# end on the same solution: the mean values of their final solutions have
+# to be printed identically
+
+set(REFERENCE_INPUT "")
+foreach(INPUT ${TEST_INPUTS})
+  message("Running the command:")
+  message("${TEST_PROG} " " ${INPUT}")
+
+  EXECUTE_PROCESS(COMMAND ${TEST_PROG} ${INPUT}
+                  OUTPUT_VARIABLE OUTPUT
+                  RESULT_VARIABLE HAD_ERROR)
+  message("${OUTPUT}")
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "Albany didn't run on ${INPUT}: test failed")
+  endif()
+
+  STRING(REGEX MATCH "MeanValue of final solution ([^\n]*)" MATCHED "${OUTPUT}")
+  if(NOT MATCHED)
+    message(FATAL_ERROR "No final solution in the output of ${INPUT}: test failed")
+  endif()
+
+  if(NOT REFERENCE_INPUT)
+    set(REFERENCE_INPUT ${INPUT})
+    set(REFERENCE_MEAN ${CMAKE_MATCH_1})
+  elseif(NOT CMAKE_MATCH_1 STREQUAL REFERENCE_MEAN)
+    message(FATAL_ERROR "Mean value ${CMAKE_MATCH_1} of ${INPUT} differs from "
+                        "${REFERENCE_MEAN} of ${REFERENCE_INPUT}: test failed")
+  endif()
+endforeach()
@@ -9,6 +9,10 @@
 #include "ATO_TopoTools.hpp"
 #include "ATO_Types.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 /* GAH FIXME - Silence warning:
 TRILINOS_DIR/../../../include/pecos_global_defs.hpp:17:0: warning: 
         "BOOST_MATH_PROMOTE_DOUBLE_POLICY" redefined [enabled by default]
@@ -335,10 +339,7 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
   // initialize/build the filter operators. these are built once.
   int nFilters = filters.size();
   for(int ifltr=0; ifltr<nFilters; ifltr++){
-    filters[ifltr]->buildOperator(
-      _subProblems[0].app, 
-      overlapNodeMap, localNodeMap,
-      importer, exporter); 
+    filters[ifltr]->buildOperator(_subProblems[0].app, localNodeMap);
   }
 
 
@@ -1721,10 +1722,7 @@ ATO::Solver::CreateSubSolverData(const ATO::SolverSubSolver& sub) const
 void
 ATO::SpatialFilter::buildOperator(
              Teuchos::RCP<Albany::Application> app,
-             Teuchos::RCP<Epetra_Map>          overlapNodeMap,
-             Teuchos::RCP<Epetra_Map>          localNodeMap,
-             Teuchos::RCP<Epetra_Import>       importer,
-             Teuchos::RCP<Epetra_Export>       exporter)
+             Teuchos::RCP<Epetra_Map>          localNodeMap)
 /******************************************************************************/
 {
 
@@ -1771,80 +1769,79 @@ ATO::SpatialFilter::buildOperator(
       }
     }
   
-    std::map< GlobalPoint, std::set<GlobalPoint> > neighbors;
-  
-    double filter_radius_sqrd = filterRadius*filterRadius;
-    // awful n^2 search... all against all
+    // gather the nodes that can be filter neighbors, i.e., nodes in the 
+    // filtered blocks that aren't excluded, and the nodes that need a row.
+    std::vector<GlobalPoint> points;
+    std::vector<GlobalPoint> homeNodes;
+    std::set<int> pointGIDs, homeGIDs;
     size_t dimension   = app->getDiscretization()->getNumDim();
-    GlobalPoint homeNode;
     size_t num_worksets = coords.size();
-    for (size_t home_ws=0; home_ws<num_worksets; home_ws++) {
-      int home_num_cells = coords[home_ws].size();
-      for (int home_cell=0; home_cell<home_num_cells; home_cell++) {
-        size_t num_nodes = coords[home_ws][home_cell].size();
-        for (int home_node=0; home_node<num_nodes; home_node++) {
-          homeNode.gid = wsElNodeID[home_ws][home_cell][home_node];
-          if(neighbors.find(homeNode)==neighbors.end()) {  // if this node was already accessed just skip
-            for (int dim=0; dim<dimension; dim++)  {
-              homeNode.coords[dim] = coords[home_ws][home_cell][home_node][dim];
-            }
-            std::set<GlobalPoint> my_neighbors;
-            if( excludeNodes.find(homeNode.gid) == excludeNodes.end() ){
-              for (size_t trial_ws=0; trial_ws<num_worksets; trial_ws++) {
-                if( blocks.size() > 0 && 
-                    find(blocks.begin(), blocks.end(), wsEBNames[trial_ws]) == blocks.end() ) continue;
-                int trial_num_cells = coords[trial_ws].size();
-                for (int trial_cell=0; trial_cell<trial_num_cells; trial_cell++) {
-                  size_t trial_num_nodes = coords[trial_ws][trial_cell].size();
-                  for (int trial_node=0; trial_node<trial_num_nodes; trial_node++) {
-                    int gid = wsElNodeID[trial_ws][trial_cell][trial_node];
-                    if( excludeNodes.find(gid) != excludeNodes.end() ) continue; // don't add excluded nodes
-                    double tmp;
-                    double delta_norm_sqr = 0.;
-                    for (int dim=0; dim<dimension; dim++)  { //individual coordinates
-                      tmp = homeNode.coords[dim]-coords[trial_ws][trial_cell][trial_node][dim];
-                      delta_norm_sqr += tmp*tmp;
-                    }
-                    if(delta_norm_sqr<=filter_radius_sqrd) {
-                      GlobalPoint newIntx;
-                      newIntx.gid = wsElNodeID[trial_ws][trial_cell][trial_node];
-                      for (int dim=0; dim<dimension; dim++) 
-                        newIntx.coords[dim] = coords[trial_ws][trial_cell][trial_node][dim];
-                      my_neighbors.insert(newIntx);
-                    }
-                  }
-                }
-              }
-            }
-            neighbors.insert( std::pair<GlobalPoint,std::set<GlobalPoint> >(homeNode,my_neighbors) );
-          }
+    for (size_t ws=0; ws<num_worksets; ws++) {
+      bool inBlocks = ( blocks.size() == 0 || 
+                        find(blocks.begin(), blocks.end(), wsEBNames[ws]) != blocks.end() );
+      int num_cells = coords[ws].size();
+      for (int cell=0; cell<num_cells; cell++) {
+        size_t num_nodes = coords[ws][cell].size();
+        for (int node=0; node<num_nodes; node++) {
+          GlobalPoint newPoint;
+          newPoint.gid = wsElNodeID[ws][cell][node];
+          for (int dim=0; dim<dimension; dim++)
+            newPoint.coords[dim] = coords[ws][cell][node][dim];
+          if( localNodeMap->MyGID(newPoint.gid) && homeGIDs.insert(newPoint.gid).second )
+            homeNodes.push_back(newPoint);
+          if( !inBlocks || excludeNodes.find(newPoint.gid) != excludeNodes.end() ) continue;
+          if( pointGIDs.insert(newPoint.gid).second )
+            points.push_back(newPoint);
         }
       }
     }
 
-    // communicate neighbor data
-    importNeighbors(neighbors,importer,exporter);
+    // add off processor nodes within the filter radius of this processor's nodes
+    importGhostPoints(points, pointGIDs);
 
-    
-    // for each interior node, search boundary nodes for additional interactions off processor.
-    
+    // find neighbors.  The result is in compressed row format: the neighbors
+    // of homeNodes[i] are points[neighbors[k]] for k in [offsets[i], offsets[i+1]).
+    std::vector<int> offsets(homeNodes.size()+1, 0);
+    std::vector<int> neighbors;
+    {
+      PointGrid grid(points, filterRadius);
+      double filter_radius_sqrd = filterRadius*filterRadius;
+      std::vector<int> candidates;
+      int numHomeNodes = homeNodes.size();
+      for (int home=0; home<numHomeNodes; home++) {
+        const GlobalPoint& homeNode = homeNodes[home];
+        if( excludeNodes.find(homeNode.gid) == excludeNodes.end() ){
+          grid.getCandidates(homeNode.coords, candidates);
+          int numCandidates = candidates.size();
+          for (int i=0; i<numCandidates; i++) {
+            const double* trial_coords = points[candidates[i]].coords;
+            double tmp;
+            double delta_norm_sqr = 0.;
+            for (int dim=0; dim<3; dim++)  { //individual coordinates
+              tmp = homeNode.coords[dim]-trial_coords[dim];
+              delta_norm_sqr += tmp*tmp;
+            }
+            if(delta_norm_sqr<=filter_radius_sqrd) neighbors.push_back(candidates[i]);
+          }
+        }
+        offsets[home+1] = neighbors.size();
+      }
+    }
   
     // now build filter operator
     int numnonzeros = 0;
     filterOperator = Teuchos::rcp(new Epetra_CrsMatrix(Copy,*localNodeMap,numnonzeros));
-    for (std::map<GlobalPoint,std::set<GlobalPoint> >::iterator 
-        it=neighbors.begin(); it!=neighbors.end(); ++it) { 
-      GlobalPoint homeNode = it->first;
+    int numHomeNodes = homeNodes.size();
+    for (int home=0; home<numHomeNodes; home++) {
+      const GlobalPoint& homeNode = homeNodes[home];
       int home_node_gid = homeNode.gid;
-      std::set<GlobalPoint> connected_nodes = it->second;
-      if( connected_nodes.size() > 0 ){
-        for (std::set<GlobalPoint>::iterator 
-             set_it=connected_nodes.begin(); set_it!=connected_nodes.end(); ++set_it) {
-           int neighbor_node_gid = set_it->gid;
-           const double* coords = &(set_it->coords[0]);
+      if( offsets[home+1] > offsets[home] ){
+        for (int k=offsets[home]; k<offsets[home+1]; k++) {
+           const GlobalPoint& neighbor = points[neighbors[k]];
+           int neighbor_node_gid = neighbor.gid;
            double distance = 0.0;
            for (int dim=0; dim<dimension; dim++) 
-             distance += (coords[dim]-homeNode.coords[dim])*(coords[dim]-homeNode.coords[dim]);
+             distance += (neighbor.coords[dim]-homeNode.coords[dim])*(neighbor.coords[dim]-homeNode.coords[dim]);
            distance = (distance > 0.0) ? sqrt(distance) : 0.0;
            double weight = filterRadius - distance;
            filterOperator->InsertGlobalValues(home_node_gid,1,&weight,&neighbor_node_gid);
@@ -1883,228 +1880,155 @@ ATO::SpatialFilter::SpatialFilter( Teuchos::ParameterList& params )
 
 /******************************************************************************/
 void 
-ATO::SpatialFilter::importNeighbors( 
-  std::map< ATO::GlobalPoint, std::set<ATO::GlobalPoint> >& neighbors,
-  Teuchos::RCP<Epetra_Import> importer,
-  Teuchos::RCP<Epetra_Export> exporter)
+ATO::SpatialFilter::importGhostPoints( 
+  std::vector<ATO::GlobalPoint>& points,
+  std::set<int>& pointGIDs)
 /******************************************************************************/
 {
-  // get from the exporter the node global ids and the associated processor ids
-  std::map<int, std::set<int> > boundaryNodesByProc;
-
-  const int* exportLIDs = exporter->ExportLIDs();
-  const int* exportPIDs = exporter->ExportPIDs();
-  int numExportIDs = exporter->NumExportIDs();
-
-  const Epetra_BlockMap& expNodeMap = exporter->SourceMap();
-
-  std::map<int, std::set<int> >::iterator procIter;
-  for(int i=0; i<numExportIDs; i++){
-    procIter = boundaryNodesByProc.find(exportPIDs[i]);
-    int exportGID = expNodeMap.GID(exportLIDs[i]);
-    if( procIter == boundaryNodesByProc.end() ){
-      std::set<int> newSet;
-      newSet.insert(exportGID);
-      boundaryNodesByProc.insert( std::pair<int,std::set<int> >(exportPIDs[i],newSet) );
-    } else {
-      procIter->second.insert(exportGID);
+  // Each processor sends to each other processor the points that are within
+  // the filter radius of the other processor's bounding box.  Only the
+  // processors whose boxes are within the filter radius of each other 
+  // communicate, so the exchange is limited to a ghost layer one filter 
+  // radius wide.
+
+  int numProcs, myProc;
+  MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+  MPI_Comm_rank(MPI_COMM_WORLD, &myProc);
+  if( numProcs == 1 ) return;
+
+  // bounding box of local points: {xmin, ymin, zmin, xmax, ymax, zmax}
+  const double big = std::numeric_limits<double>::max();
+  double myBox[6] = {big, big, big, -big, -big, -big};
+  int numLocalPoints = points.size();
+  for(int i=0; i<numLocalPoints; i++){
+    for(int dim=0; dim<3; dim++){
+      myBox[dim]   = std::min(myBox[dim],   points[i].coords[dim]);
+      myBox[dim+3] = std::max(myBox[dim+3], points[i].coords[dim]);
     }
   }
 
-  const Epetra_BlockMap& impNodeMap = importer->SourceMap();
-
-  exportLIDs = importer->ExportLIDs();
-  exportPIDs = importer->ExportPIDs();
-  numExportIDs = importer->NumExportIDs();
+  std::vector<double> boxes(6*numProcs);
+  MPI_Allgather(myBox, 6, MPI_DOUBLE, &boxes[0], 6, MPI_DOUBLE, MPI_COMM_WORLD);
 
-  for(int i=0; i<numExportIDs; i++){
-    procIter = boundaryNodesByProc.find(exportPIDs[i]);
-    int exportGID = impNodeMap.GID(exportLIDs[i]);
-    if( procIter == boundaryNodesByProc.end() ){
-      std::set<int> newSet;
-      newSet.insert(exportGID);
-      boundaryNodesByProc.insert( std::pair<int,std::set<int> >(exportPIDs[i],newSet) );
-    } else {
-      procIter->second.insert(exportGID);
+  // squared distance from a point to a box.  
+  auto boxDistanceSqrd = [](const double* box, const double* x) {
+    double d2 = 0.0;
+    for(int dim=0; dim<3; dim++){
+      double d = std::max(std::max(box[dim]-x[dim], x[dim]-box[dim+3]), 0.0);
+      d2 += d*d;
+    }
+    return d2;
+  };
+
+  double filter_radius_sqrd = filterRadius*filterRadius;
+  std::vector<int> partners;
+  for(int proc=0; proc<numProcs; proc++){
+    if( proc == myProc || numLocalPoints == 0 ) continue;
+    const double* box = &boxes[6*proc];
+    if( box[0] > box[3] ) continue; // no points on proc
+    // distance between boxes.  This is symmetric so both processors agree.
+    double d2 = 0.0;
+    for(int dim=0; dim<3; dim++){
+      double d = std::max(std::max(box[dim]-myBox[dim+3], myBox[dim]-box[dim+3]), 0.0);
+      d2 += d*d;
     }
+    if( d2 <= filter_radius_sqrd ) partners.push_back(proc);
   }
 
-  int newPoints = 1;
-  
-  while(newPoints > 0){
-    newPoints = 0;
+  // determine the points to be sent to each partner and communicate sizes
+  int numPartners = partners.size();
+  std::vector<std::vector<ATO::GlobalPoint> > sendPoints(numPartners);
+  std::vector<int> numSend(numPartners), numRecv(numPartners);
+  std::vector<MPI_Request> requests(2*numPartners);
+  for(int p=0; p<numPartners; p++){
+    const double* box = &boxes[6*partners[p]];
+    for(int i=0; i<numLocalPoints; i++)
+      if( boxDistanceSqrd(box, points[i].coords) <= filter_radius_sqrd )
+        sendPoints[p].push_back(points[i]);
+    numSend[p] = sendPoints[p].size();
+    MPI_Irecv(&numRecv[p], 1, MPI_INT, partners[p], 0, MPI_COMM_WORLD, &requests[2*p]);
+    MPI_Isend(&numSend[p], 1, MPI_INT, partners[p], 0, MPI_COMM_WORLD, &requests[2*p+1]);
+  }
+  if( numPartners > 0 )
+    MPI_Waitall(2*numPartners, &requests[0], MPI_STATUSES_IGNORE);
+
+  // communicate ghost points
+  std::vector<std::vector<ATO::GlobalPoint> > recvPoints(numPartners);
+  for(int p=0; p<numPartners; p++){
+    recvPoints[p].resize(numRecv[p]);
+    MPI_Irecv(recvPoints[p].data(), numRecv[p], MPI_GlobalPoint, partners[p], 1, 
+              MPI_COMM_WORLD, &requests[2*p]);
+    MPI_Isend(sendPoints[p].data(), numSend[p], MPI_GlobalPoint, partners[p], 1, 
+              MPI_COMM_WORLD, &requests[2*p+1]);
+  }
+  if( numPartners > 0 )
+    MPI_Waitall(2*numPartners, &requests[0], MPI_STATUSES_IGNORE);
+
+  // add new points.  Nodes shared between processors are received more than once.
+  for(int p=0; p<numPartners; p++){
+    int nrecv = recvPoints[p].size();
+    for(int i=0; i<nrecv; i++)
+      if( pointGIDs.insert(recvPoints[p][i].gid).second )
+        points.push_back(recvPoints[p][i]);
+  }
+}
 
-    int numNeighborProcs = boundaryNodesByProc.size();
-    std::vector<std::vector<int> > numNeighbors_send(numNeighborProcs);
-    std::vector<std::vector<int> > numNeighbors_recv(numNeighborProcs);
-    
- 
-    // determine number of neighborhood nodes to be communicated
-    int index = 0;
-    std::map<int, std::set<int> >::iterator boundaryNodesIter;
-    for( boundaryNodesIter=boundaryNodesByProc.begin(); 
-         boundaryNodesIter!=boundaryNodesByProc.end(); 
-         boundaryNodesIter++){
-   
-      int send_to = boundaryNodesIter->first;
-      int recv_from = send_to;
-  
-      std::set<int>& boundaryNodes = boundaryNodesIter->second; 
-      int numNodes = boundaryNodes.size();
-  
-      numNeighbors_send[index].resize(numNodes);
-      numNeighbors_recv[index].resize(numNodes);
-  
-      ATO::GlobalPoint sendPoint;
-      std::map< ATO::GlobalPoint, std::set<ATO::GlobalPoint> >::iterator sendPointIter;
-      int localIndex = 0;
-      std::set<int>::iterator boundaryNodeGID;
-      for(boundaryNodeGID=boundaryNodes.begin(); 
-          boundaryNodeGID!=boundaryNodes.end();
-          boundaryNodeGID++){
-        sendPoint.gid = *boundaryNodeGID;
-        sendPointIter = neighbors.find(sendPoint);
-        TEUCHOS_TEST_FOR_EXCEPT( sendPointIter == neighbors.end() );
-        std::set<ATO::GlobalPoint>& sendPointSet = sendPointIter->second;
-        numNeighbors_send[index][localIndex] = sendPointSet.size();
-        localIndex++;
-      }
-  
-      MPI_Status status;
-      MPI_Sendrecv(&(numNeighbors_send[index][0]), numNodes, MPI_INT, send_to, 0,
-                   &(numNeighbors_recv[index][0]), numNodes, MPI_INT, recv_from, 0,
-                   MPI_COMM_WORLD, &status);
-      index++;
-    }
-  
-    // new neighbors can't be immediately added to the neighbor map or they'll be
-    // found and added to the list that's communicated to other procs.  This causes
-    // problems because the message length has already been communicated.  
-    std::map< ATO::GlobalPoint, std::set<ATO::GlobalPoint> > newNeighbors;
-  
-    // communicate neighborhood nodes
-    index = 0;
-    for( boundaryNodesIter=boundaryNodesByProc.begin(); 
-         boundaryNodesIter!=boundaryNodesByProc.end(); 
-         boundaryNodesIter++){
-   
-      // determine total message size
-      int totalNumEntries_send = 0;
-      int totalNumEntries_recv = 0;
-      std::vector<int>& send = numNeighbors_send[index];
-      std::vector<int>& recv = numNeighbors_recv[index];
-      int totalNumNodes = send.size();
-      for(int i=0; i<totalNumNodes; i++){
-        totalNumEntries_send += send[i];
-        totalNumEntries_recv += recv[i];
-      }
-  
-      int send_to = boundaryNodesIter->first;
-      int recv_from = send_to;
-  
-      ATO::GlobalPoint* GlobalPoints_send = new ATO::GlobalPoint[totalNumEntries_send];
-      ATO::GlobalPoint* GlobalPoints_recv = new ATO::GlobalPoint[totalNumEntries_recv];
-      
-      // copy into contiguous memory
-      std::set<int>& boundaryNodes = boundaryNodesIter->second;
-      ATO::GlobalPoint sendPoint;
-      std::map< ATO::GlobalPoint, std::set<ATO::GlobalPoint> >::iterator sendPointIter;
-      std::set<int>::iterator boundaryNodeGID;
-      int numNodes = boundaryNodes.size();
-      int offset = 0;
-      for(boundaryNodeGID=boundaryNodes.begin(); 
-          boundaryNodeGID!=boundaryNodes.end();
-          boundaryNodeGID++){
-        // get neighbors for boundary node i
-        sendPoint.gid = *boundaryNodeGID;
-        sendPointIter = neighbors.find(sendPoint);
-        TEUCHOS_TEST_FOR_EXCEPT( sendPointIter == neighbors.end() );
-        std::set<ATO::GlobalPoint>& sendPointSet = sendPointIter->second;
-        // copy neighbors into contiguous memory
-        for(std::set<ATO::GlobalPoint>::iterator igp=sendPointSet.begin(); 
-            igp!=sendPointSet.end(); igp++){
-          GlobalPoints_send[offset] = *igp;
-          offset++;
-        }
-      }
-  
-      MPI_Status status;
-      MPI_Sendrecv(GlobalPoints_send, totalNumEntries_send, MPI_GlobalPoint, send_to, 0,
-                   GlobalPoints_recv, totalNumEntries_recv, MPI_GlobalPoint, recv_from, 0,
-                   MPI_COMM_WORLD, &status);
-  
-      // copy out of contiguous memory
-      ATO::GlobalPoint recvPoint;
-      std::map< ATO::GlobalPoint, std::set<ATO::GlobalPoint> >::iterator recvPointIter;
-      offset = 0;
-      int localIndex=0;
-      for(boundaryNodeGID=boundaryNodes.begin(); 
-          boundaryNodeGID!=boundaryNodes.end();
-          boundaryNodeGID++){
-        recvPoint.gid = *boundaryNodeGID;
-        recvPointIter = newNeighbors.find(recvPoint);
-        if( recvPointIter == newNeighbors.end() ){ // not found, add.
-          std::set<ATO::GlobalPoint> newPointSet;
-          int nrecv = recv[localIndex];
-          for(int j=0; j<nrecv; j++){
-            newPointSet.insert(GlobalPoints_recv[offset]);
-            offset++;
-          }
-          newNeighbors.insert( std::pair<ATO::GlobalPoint,std::set<ATO::GlobalPoint> >(recvPoint,newPointSet) );
-        } else {
-          int nrecv = recv[localIndex];
-          for(int j=0; j<nrecv; j++){
-            recvPointIter->second.insert(GlobalPoints_recv[offset]);
-            offset++;
-          }
-        }
-        localIndex++;
-      }
-   
-      delete [] GlobalPoints_send;
-      delete [] GlobalPoints_recv;
-      
-      index++;
-    }
-  
-    // add newNeighbors map to neighbors map
-    std::map< ATO::GlobalPoint, std::set<ATO::GlobalPoint> >::iterator new_nbr;
-    std::map< ATO::GlobalPoint, std::set<ATO::GlobalPoint> >::iterator nbr;
-    std::set< ATO::GlobalPoint >::iterator newPoint;
-    // loop on total neighbor list
-    for(nbr=neighbors.begin(); nbr!=neighbors.end(); nbr++){
-  
-      std::set<ATO::GlobalPoint>& pointSet = nbr->second;
-      int pointSetSize = pointSet.size();
-  
-      ATO::GlobalPoint home_point = nbr->first;
-      double* home_coords = &(home_point.coords[0]);
-      std::map< ATO::GlobalPoint, std::set<ATO::GlobalPoint> >::iterator nbrs;
-      std::set< ATO::GlobalPoint >::iterator remote_point;
-      for(nbrs=newNeighbors.begin(); nbrs!=newNeighbors.end(); nbrs++){
-        std::set<ATO::GlobalPoint>& remote_points = nbrs->second;
-        for(remote_point=remote_points.begin(); 
-            remote_point!=remote_points.end();
-            remote_point++){
-          const double* remote_coords = &(remote_point->coords[0]);
-          double distance = 0.0;
-          for(int i=0; i<3; i++)
-            distance += (remote_coords[i]-home_coords[i])*(remote_coords[i]-home_coords[i]);
-          distance = (distance > 0.0) ? sqrt(distance) : 0.0;
-          if( distance < filterRadius )
-            pointSet.insert(*remote_point);
-        }
-      }
-      // see if any new points where found off processor.  
-      newPoints += (pointSet.size() - pointSetSize);
+/******************************************************************************/
+ATO::PointGrid::PointGrid(const std::vector<GlobalPoint>& points, double cellSize) :
+  _cellSize(cellSize)
+/******************************************************************************/
+{
+  int numPoints = points.size();
+  for(int dim=0; dim<3; dim++){ _origin[dim] = 0.0; _numCells[dim] = 1; }
+  if( numPoints == 0 ) return;
+
+  for(int dim=0; dim<3; dim++){
+    double lo = points[0].coords[dim], hi = lo;
+    for(int i=1; i<numPoints; i++){
+      lo = std::min(lo, points[i].coords[dim]);
+      hi = std::max(hi, points[i].coords[dim]);
     }
-    int globalNewPoints=0;
-    impNodeMap.Comm().SumAll(&newPoints, &globalNewPoints, 1);
-    newPoints = globalNewPoints;
+    _origin[dim] = lo;
+    _numCells[dim] = (long long)((hi-lo)/_cellSize) + 1;
   }
+
+  _cells.resize(numPoints);
+  for(int i=0; i<numPoints; i++){
+    long long ijk[3];
+    for(int dim=0; dim<3; dim++)
+      ijk[dim] = std::min((long long)((points[i].coords[dim]-_origin[dim])/_cellSize), 
+                          _numCells[dim]-1);
+    _cells[i] = std::make_pair(key(ijk), i);
+  }
+  std::sort(_cells.begin(), _cells.end());
+}
+
+/******************************************************************************/
+void
+ATO::PointGrid::getCandidates(const double* x, std::vector<int>& candidates) const
+/******************************************************************************/
+{
+  candidates.clear();
+  if( _cells.size() == 0 ) return;
+
+  // cell range that contains all points within one cell size of x
+  long long lo[3], hi[3];
+  for(int dim=0; dim<3; dim++){
+    double s = (x[dim]-_origin[dim])/_cellSize;
+    if( s < -1.0 || s >= _numCells[dim]+1.0 ) return;
+    long long c = (long long)std::floor(s);
+    lo[dim] = std::max(c-1, 0LL);
+    hi[dim] = std::min(c+1, _numCells[dim]-1);
+  }
+
+  long long ijk[3];
+  for(ijk[0]=lo[0]; ijk[0]<=hi[0]; ijk[0]++)
+    for(ijk[1]=lo[1]; ijk[1]<=hi[1]; ijk[1]++)
+      for(ijk[2]=lo[2]; ijk[2]<=hi[2]; ijk[2]++){
+        std::pair<long long,int> first(key(ijk), 0);
+        std::vector<std::pair<long long,int> >::const_iterator it;
+        it = std::lower_bound(_cells.begin(), _cells.end(), first);
+        for(; it!=_cells.end() && it->first==first.first; it++)
+          candidates.push_back(it->second);
+      }
 }
-  
-  
-  
-  
-  
@@ -39,6 +39,22 @@ namespace ATO {
   } GlobalPoint;
   bool operator< (GlobalPoint const & a, GlobalPoint const & b);
 
+  //! Uniform grid over a set of points with cells of the given size.  All
+  //! points within one cell size of x are among the candidates returned for x.
+  class PointGrid {
+    public:
+      PointGrid(const std::vector<GlobalPoint>& points, double cellSize);
+      void getCandidates(const double* x, std::vector<int>& candidates) const;
+    private:
+      long long key(const long long* ijk) const
+        { return (ijk[0]*_numCells[1] + ijk[1])*_numCells[2] + ijk[2]; }
+      double _cellSize;
+      double _origin[3];
+      long long _numCells[3];
+      //! (cell key, point index) sorted by cell key
+      std::vector<std::pair<long long,int> > _cells;
+  };
+
   // eventually make this a base class and derive from it to make
   // various kernels.  Also add a factory.
   class SpatialFilter{
@@ -46,17 +62,13 @@ namespace ATO {
       SpatialFilter(Teuchos::ParameterList& params);
       void buildOperator(
              Teuchos::RCP<Albany::Application> app,
-             Teuchos::RCP<Epetra_Map>          overlapNodeMap,
-             Teuchos::RCP<Epetra_Map>          localNodeMap,
-             Teuchos::RCP<Epetra_Import>       importer,
-             Teuchos::RCP<Epetra_Export>       exporter);
+             Teuchos::RCP<Epetra_Map>          localNodeMap);
       Teuchos::RCP<Epetra_CrsMatrix> FilterOperator(){return filterOperator;}
       int getNumIterations(){return iterations;}
     protected:
-      void importNeighbors(
-             std::map< GlobalPoint, std::set<GlobalPoint> >& neighbors,
-             Teuchos::RCP<Epetra_Import>       importer,
-             Teuchos::RCP<Epetra_Export>       exporter);
+      void importGhostPoints(
+             std::vector<GlobalPoint>& points,
+             std::set<int>&            pointGIDs);
 
       Teuchos::RCP<Epetra_CrsMatrix> filterOperator;
       int iterations;
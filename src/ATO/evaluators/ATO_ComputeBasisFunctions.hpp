@@ -13,6 +13,7 @@
 #include "Phalanx_MDField.hpp"
 
 #include "Albany_Layouts.hpp"
+#include "PHAL_GeometryCache.hpp"
 
 #include "Intrepid2_CellTools.hpp"
 #include "Intrepid2_Cubature.hpp"
@@ -72,6 +73,10 @@ private:
   PHX::MDField<MeshScalarT,Cell,Node,QuadPoint,Dim> GradBF;
   PHX::MDField<MeshScalarT,Cell,Node,QuadPoint,Dim> wGradBF;
 
+  //! Geometry-only outputs (jacobian_det, BF, GradBF) of previous evaluations;
+  //! the weights depend on the topology and are always recomputed.
+  PHAL::GeometryCache<EvalT, Traits> geometryCache;
+
   bool m_isStatic;
 };
 }
@@ -121,9 +121,16 @@ evaluateFields(typename Traits::EvalData workset)
   typedef typename Intrepid2::CellTools<MeshScalarT>   ICT;
   typedef Intrepid2::FunctionSpaceTools                IFST;
 
-  Intrepid2::CellTools<RealType>::setJacobian(jacobian, refPoints, coordVec, cubature->getBasis());
-  ICT::setJacobianInv (jacobian_inv, jacobian);
-  ICT::setJacobianDet (jacobian_det, jacobian);
+  const bool haveGeometry = geometryCache.haveStoredData(workset);
+  if (haveGeometry) {
+    geometryCache.load(jacobian_det);
+    geometryCache.load(BF);
+    geometryCache.load(GradBF);
+  } else {
+    Intrepid2::CellTools<RealType>::setJacobian(jacobian, refPoints, coordVec, cubature->getBasis());
+    ICT::setJacobianInv (jacobian_inv, jacobian);
+    ICT::setJacobianDet (jacobian_det, jacobian);
+  }
 
   bool isSet = false;
   Albany::MDArray savedWeights;
@@ -166,9 +173,16 @@ evaluateFields(typename Traits::EvalData workset)
     (*workset.stateArrayPtr)["isSet"](0,0) = 1;
   }
 
-  IFST::HGRADtransformVALUE<RealType>   (BF, val_at_cub_points);
+  if (!haveGeometry) {
+    IFST::HGRADtransformVALUE<RealType>   (BF, val_at_cub_points);
+    IFST::HGRADtransformGRAD<MeshScalarT> (GradBF, jacobian_inv, grad_at_cub_points);
+
+    geometryCache.store(jacobian_det);
+    geometryCache.store(BF);
+    geometryCache.store(GradBF);
+    geometryCache.setStored();
+  }
   IFST::multiplyMeasure<MeshScalarT>    (wBF, weighted_measure, BF);
-  IFST::HGRADtransformGRAD<MeshScalarT> (GradBF, jacobian_inv, grad_at_cub_points);
   IFST::multiplyMeasure<MeshScalarT>    (wGradBF, weighted_measure, GradBF);
 }
 
@@ -8,6 +8,13 @@
 #include "Albany_ModelFactory.hpp"
 #include "Teuchos_TestForException.hpp"
 #include "Teuchos_VerboseObject.hpp"
+#include "Aeras_ShallowWaterConstants.hpp"
+#include "Aeras_SpectralSumFactorization.hpp"
+#include "Aeras_SphericalMap.hpp"
+#include "Albany_ProblemUtils.hpp"
+#include "Intrepid2_CubaturePolylib.hpp"
+#include "Intrepid2_CubatureTensor.hpp"
+#include <cmath>
 #include <sstream>
 
 //uncomment the following to write stuff out to matrix market to debug
@@ -81,7 +88,8 @@ Teuchos::RCP<Tpetra_CrsMatrix> getOnlyNonzeros (const Teuchos::RCP<Tpetra_CrsMat
 Aeras::HVDecorator::HVDecorator(
     const Teuchos::RCP<Albany::Application>& app_,
     const Teuchos::RCP<Teuchos::ParameterList>& appParams)
-    :Albany::ModelEvaluatorT(app_,appParams)
+    :Albany::ModelEvaluatorT(app_,appParams),
+     matrixFree_(false), np_(0), hvScale_(0.0)
 {
 
 #ifdef OUTPUT_TO_SCREEN
@@ -99,11 +107,19 @@ Aeras::HVDecorator::HVDecorator(
 	  mass = createOperatorDiag(1.0, 0.0, 0.0, true);
   if(Hydro_app)
 	  mass = createOperatorDiag(1.0, 0.0, 0.0, false);
+  Teuchos::ParameterList& problemParams = *app->getProblemPL();
+  Teuchos::ParameterList& hvParams =
+    problemParams.sublist(SW_app ? "Shallow Water Problem" : "Hydrostatic Problem");
+  matrixFree_ = hvParams.get<bool>("Matrix-Free Hyperviscosity", false);
+  const bool checkMatrixFree = hvParams.get<bool>("Check Matrix-Free Hyperviscosity", false);
+
   Teuchos::RCP<Tpetra_CrsMatrix> laplace;
-  if(SW_app)
+  if (!matrixFree_ || checkMatrixFree) {
+    if(SW_app)
       laplace = createOperator(0.0, 0.0, 1.0, true);
-  if(Hydro_app)
+    if(Hydro_app)
       laplace = createOperator(0.0, 0.0, 1.0, false);
+  }
 
   // Do some preprocessing to speed up subsequent residual calculations.
   // 1. Store the lumped mass diag reciprocal.
@@ -112,9 +128,15 @@ Aeras::HVDecorator::HVDecorator(
   inv_mass_diag_->reciprocal(*inv_mass_diag_);
   // 2. Create a work vector in advance.
   wrk_ = Teuchos::rcp(new Tpetra_Vector(mass->getRowMap()));
-  // 3. Remove the structural nonzeros, numerical zeros, from the Laplace
-  // operator.
-  laplace_ = getOnlyNonzeros(laplace);
+  // 3. Either set up the matrix-free Laplace operator, or remove the
+  // structural nonzeros, numerical zeros, from the assembled one.
+  if (matrixFree_) {
+    setupMatrixFreeLaplace();
+    if (checkMatrixFree)
+      checkMatrixFreeLaplace(laplace);
+  }
+  else
+    laplace_ = getOnlyNonzeros(laplace);
 
 //OG In case of a parallel run by some reason laplace.mm file contains indices
 //out of range with non-trivial entries. I haven't debugged this yet. AB suggested to
@@ -122,7 +144,8 @@ Aeras::HVDecorator::HVDecorator(
 //in case of a parallel and serial run.
 #ifdef WRITE_TO_MATRIX_MARKET_TO_MM_FILE
   Tpetra_MatrixMarket_Writer::writeSparseFile("mass.mm", mass);
-  Tpetra_MatrixMarket_Writer::writeSparseFile("laplace.mm", laplace_);
+  if (Teuchos::nonnull(laplace))
+    Tpetra_MatrixMarket_Writer::writeSparseFile("laplace.mm", laplace);
 #endif
 }
  
@@ -214,6 +237,13 @@ const
   std::cout << "DEBUG: " << __PRETTY_FUNCTION__ << "\n";
 #endif
 
+  if (matrixFree_) {
+    applyLaplaceMatrixFree(*x_in, *x_out);
+    wrk_->elementWiseMultiply(1.0, *inv_mass_diag_, *x_out, 0.0);
+    applyLaplaceMatrixFree(*wrk_, *x_out);
+    return;
+  }
+
   // x_out = laplace_ * x_in
   laplace_->apply(*x_in, *x_out, Teuchos::NO_TRANS, 1.0, 0.0); 
   // wrk_ = inv(M) * x_out
@@ -241,6 +271,250 @@ const
 }
 
 
+namespace {
+// lu = weak Laplacian of the element field u, both np x np with the first
+// index fastest. The nodes are the quadrature points, so the reference
+// gradient along a GLL line is one row of D, and G holds w*Jinv*Jinv^T at
+// each point: O(np^3) per element instead of O(np^4).
+void elementLaplace (const int np, const double* D, const double* G,
+                     const double* u, double* gx, double* gy, double* lu) {
+  for (int j = 0; j < np; ++j)
+    for (int i = 0; i < np; ++i) {
+      double dxi = 0, deta = 0;
+      for (int k = 0; k < np; ++k) {
+        dxi  += D[i*np+k]*u[k+np*j];
+        deta += D[j*np+k]*u[i+np*k];
+      }
+      const double* g = G + 3*(i+np*j);
+      gx[i+np*j] = g[0]*dxi + g[1]*deta;
+      gy[i+np*j] = g[1]*dxi + g[2]*deta;
+    }
+  for (int b = 0; b < np; ++b)
+    for (int a = 0; a < np; ++a) {
+      double val = 0;
+      for (int k = 0; k < np; ++k)
+        val += D[k*np+a]*gx[k+np*b] + D[k*np+b]*gy[a+np*k];
+      lu[a+np*b] = val;
+    }
+}
+} // namespace
+
+//The matrix-free operator reproduces the Laplace operator assembled through
+//the n_coeff (x_dotdot) derivative of ShallowWaterResid and ComputeAndScatterJac:
+//sqrt(tau) times the weak Laplacian for h (shallow water) or for the temperature
+//and the tracers on every level (hydrostatic; no Laplacian for the surface
+//pressure), and K^T*Laplace*K for each velocity pair, K being the lon/lat to
+//xyz transform at the nodes.
+void
+Aeras::HVDecorator::setupMatrixFreeLaplace()
+{
+  const Teuchos::RCP<Albany::AbstractDiscretization> disc = app->getDiscretization();
+  const std::string appname = app->getProblemPL()->get("Name", "");
+  const bool SW_app = (appname == "Aeras Shallow Water 3D");
+  Teuchos::ParameterList& hvParams =
+    app->getProblemPL()->sublist(SW_app ? "Shallow Water Problem" : "Hydrostatic Problem");
+
+  hvScale_ = std::sqrt(hvParams.get<double>("Hyperviscosity Tau", 0.0));
+
+  const int neq = disc->getNumEq();
+  scalarEqs_.clear();
+  vectorEqs_.clear();
+  if (SW_app) {
+    scalarEqs_.push_back(0);
+    if (!hvParams.get<bool>("Use Prescribed Velocity", false))
+      vectorEqs_.push_back(1);
+  }
+  else {
+    // Per node: surface pressure, (u_lambda, u_theta, T) on each level, then
+    // the tracers of each level
+    const int numLevels = hvParams.get<int>("Number of Vertical Levels", 10);
+    const int numTracers = (neq - 1 - 3*numLevels)/numLevels;
+    TEUCHOS_TEST_FOR_EXCEPTION(1 + 3*numLevels + numTracers*numLevels != neq, std::logic_error,
+        "Aeras::HVDecorator: " << neq << " equations do not match " << numLevels << " levels.\n");
+    for (int level = 0; level < numLevels; ++level) {
+      vectorEqs_.push_back(1 + 3*level);
+      scalarEqs_.push_back(1 + 3*level + 2);
+    }
+    for (int level = 0; level < numLevels; ++level)
+      for (int t = 0; t < numTracers; ++t)
+        scalarEqs_.push_back(1 + 3*numLevels + level*numTracers + t);
+  }
+
+  wsElNodeEqID_ = disc->getWsElNodeEqID();
+  const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type&
+    coords = disc->getCoords();
+
+  // D and the GLL weights from the basis and the cubature the problem
+  // builds; SpectralSumFactorization checks that the nodes are the
+  // lexicographically numbered quadrature points this operator assumes
+  typedef Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> FieldContainer;
+  const Albany::MeshSpecsStruct& meshSpecs = *app->getEnrichedMeshSpecs()[0];
+  const Teuchos::RCP<Intrepid2::Basis<RealType, FieldContainer> > basis =
+    Albany::getIntrepid2Basis(meshSpecs.ctd);
+  const Teuchos::RCP<Intrepid2::Cubature<RealType, FieldContainer> > polylib =
+    Teuchos::rcp(new Intrepid2::CubaturePolylib<RealType, FieldContainer>(
+        meshSpecs.cubatureDegree, meshSpecs.cubatureRule));
+  const std::vector<Teuchos::RCP<Intrepid2::Cubature<RealType, FieldContainer> > > cubatures(2, polylib);
+  const Teuchos::RCP<Intrepid2::Cubature<RealType, FieldContainer> > cubature =
+    Teuchos::rcp(new Intrepid2::CubatureTensor<RealType, FieldContainer>(cubatures));
+  const Teuchos::RCP<const Aeras::SpectralSumFactorization> sumFactorization =
+    Aeras::SpectralSumFactorization::create(basis, cubature);
+  TEUCHOS_TEST_FOR_EXCEPTION(sumFactorization.is_null(), std::logic_error,
+      "Aeras::HVDecorator: the matrix-free Laplace operator needs spectral elements with "
+      "quadrature points collocated at the Gauss-Lobatto nodes.\n");
+  np_ = sumFactorization->np();
+  const int numNodes = np_*np_;
+
+  int numElems = 0;
+  for (int ws = 0; ws < wsElNodeEqID_.size(); ++ws) {
+    numElems += wsElNodeEqID_[ws].size();
+    TEUCHOS_TEST_FOR_EXCEPTION(wsElNodeEqID_[ws].size() > 0 && static_cast<int>(wsElNodeEqID_[ws][0].size()) != numNodes,
+        std::logic_error, "Aeras::HVDecorator: elements have " << wsElNodeEqID_[ws][0].size()
+        << " nodes, the basis has " << numNodes << ".\n");
+  }
+
+  gllDeriv_.resize(np_*np_);
+  for (int i = 0; i < np_; ++i)
+    for (int a = 0; a < np_; ++a)
+      gllDeriv_[i*np_+a] = sumFactorization->D(i, a);
+  FieldContainer refPoints(numNodes, 2), refWeights(numNodes);
+  cubature->getCubature(refPoints, refWeights);
+
+  metric_.resize(3*numNodes*numElems);
+  rotation_.resize(5*numNodes*numElems);
+
+  // Metric terms of the (non-HOMME) spherical map of ComputeBasisFunctions
+  // evaluated at the GLL nodes
+  const double earthRadius = Aeras::ShallowWaterConstants::self().earthRadius;
+  const double* D = gllDeriv_.data();
+  int e = 0;
+  for (int ws = 0; ws < wsElNodeEqID_.size(); ++ws)
+    for (int cell = 0; cell < wsElNodeEqID_[ws].size(); ++cell, ++e) {
+      const Teuchos::ArrayRCP<double*>& x = coords[ws][cell];
+      double* G = &metric_[3*numNodes*e];
+      double* K = &rotation_[5*numNodes*e];
+      for (int j = 0; j < np_; ++j)
+        for (int i = 0; i < np_; ++i) {
+          const int q = i + np_*j;
+          const double norm = std::sqrt(x[q][0]*x[q][0] + x[q][1]*x[q][1] + x[q][2]*x[q][2]);
+          double lon, lat;
+          Aeras::sphereCoordinates<double>(x[q][0]/norm, x[q][1]/norm, x[q][2]/norm, lon, lat);
+
+          double dphi[3][2];
+          for (int d = 0; d < 3; ++d) {
+            dphi[d][0] = dphi[d][1] = 0;
+            for (int k = 0; k < np_; ++k) {
+              dphi[d][0] += D[i*np_+k]*x[k+np_*j][d];
+              dphi[d][1] += D[j*np_+k]*x[i+np_*k][d];
+            }
+          }
+          double jac[2][2];
+          Aeras::sphericalMapJacobian<double>(lon, lat, dphi, earthRadius/norm, jac);
+
+          const double det = jac[0][0]*jac[1][1] - jac[0][1]*jac[1][0];
+          const double jinv[2][2] = {{ jac[1][1]/det, -jac[0][1]/det},
+                                     {-jac[1][0]/det,  jac[0][0]/det}};
+          const double w = refWeights(q)*std::abs(det);
+          G[3*q+0] = w*(jinv[0][0]*jinv[0][0] + jinv[0][1]*jinv[0][1]);
+          G[3*q+1] = w*(jinv[0][0]*jinv[1][0] + jinv[0][1]*jinv[1][1]);
+          G[3*q+2] = w*(jinv[1][0]*jinv[1][0] + jinv[1][1]*jinv[1][1]);
+        }
+
+      for (int node = 0; node < numNodes; ++node) {
+        double lam, th;
+        Aeras::sphereCoordinates<double>(x[node][0], x[node][1], x[node][2], lam, th);
+        K[5*node+0] = -std::sin(lam);
+        K[5*node+1] = -std::sin(th)*std::cos(lam);
+        K[5*node+2] =  std::cos(lam);
+        K[5*node+3] = -std::sin(th)*std::sin(lam);
+        K[5*node+4] =  std::cos(th);
+      }
+    }
+
+  importer_ = Teuchos::rcp(new Tpetra_Import(disc->getMapT(), disc->getOverlapMapT()));
+  exporter_ = Teuchos::rcp(new Tpetra_Export(disc->getOverlapMapT(), disc->getMapT()));
+  x_overlap_ = Teuchos::rcp(new Tpetra_Vector(disc->getOverlapMapT()));
+  y_overlap_ = Teuchos::rcp(new Tpetra_Vector(disc->getOverlapMapT()));
+}
+
+//Fused gather -> element Laplacian -> scatter over all elements and
+//equations, then one export to sum the shared nodes.
+void
+Aeras::HVDecorator::applyLaplaceMatrixFree(const Tpetra_Vector& x, Tpetra_Vector& y) const
+{
+  x_overlap_->doImport(x, *importer_, Tpetra::INSERT);
+  y_overlap_->putScalar(0.0);
+  {
+    const Teuchos::ArrayRCP<const ST> xv = x_overlap_->get1dView();
+    const Teuchos::ArrayRCP<ST> yv = y_overlap_->get1dViewNonConst();
+
+    const int numNodes = np_*np_;
+    std::vector<double> work(8*numNodes);
+    double *ux = &work[0], *uy = ux + numNodes, *uz = uy + numNodes,
+           *lx = uz + numNodes, *ly = lx + numNodes, *lz = ly + numNodes,
+           *gx = lz + numNodes, *gy = gx + numNodes;
+    const double* D = gllDeriv_.data();
+
+    int e = 0;
+    for (int ws = 0; ws < wsElNodeEqID_.size(); ++ws)
+      for (int cell = 0; cell < wsElNodeEqID_[ws].size(); ++cell, ++e) {
+        const Teuchos::ArrayRCP<Teuchos::ArrayRCP<LO> >& nodeID = wsElNodeEqID_[ws][cell];
+        const double* G = &metric_[3*numNodes*e];
+        const double* K = &rotation_[5*numNodes*e];
+
+        for (std::size_t s = 0; s < scalarEqs_.size(); ++s) {
+          const int eq = scalarEqs_[s];
+          for (int node = 0; node < numNodes; ++node)
+            ux[node] = xv[nodeID[node][eq]];
+          elementLaplace(np_, D, G, ux, gx, gy, lx);
+          for (int node = 0; node < numNodes; ++node)
+            yv[nodeID[node][eq]] += hvScale_*lx[node];
+        }
+
+        for (std::size_t v = 0; v < vectorEqs_.size(); ++v) {
+          const int eq = vectorEqs_[v];
+          for (int node = 0; node < numNodes; ++node) {
+            const double* k = K + 5*node;
+            const double ulambda = xv[nodeID[node][eq]],
+                         utheta  = xv[nodeID[node][eq+1]];
+            ux[node] = k[0]*ulambda + k[1]*utheta;
+            uy[node] = k[2]*ulambda + k[3]*utheta;
+            uz[node] = k[4]*utheta;
+          }
+          elementLaplace(np_, D, G, ux, gx, gy, lx);
+          elementLaplace(np_, D, G, uy, gx, gy, ly);
+          elementLaplace(np_, D, G, uz, gx, gy, lz);
+          for (int node = 0; node < numNodes; ++node) {
+            const double* k = K + 5*node;
+            yv[nodeID[node][eq]]   += hvScale_*(k[0]*lx[node] + k[2]*ly[node]);
+            yv[nodeID[node][eq+1]] += hvScale_*(k[1]*lx[node] + k[3]*ly[node] + k[4]*lz[node]);
+          }
+        }
+      }
+  }
+  y.putScalar(0.0);
+  y.doExport(*y_overlap_, *exporter_, Tpetra::ADD);
+}
+
+void
+Aeras::HVDecorator::checkMatrixFreeLaplace(const Teuchos::RCP<Tpetra_CrsMatrix>& laplace) const
+{
+  Tpetra_Vector x(laplace->getDomainMap()), y(laplace->getRangeMap()), y_mf(laplace->getRangeMap());
+  x.randomize();
+  laplace->apply(x, y, Teuchos::NO_TRANS, 1.0, 0.0);
+  applyLaplaceMatrixFree(x, y_mf);
+
+  const ST norm = y.norm2();
+  y_mf.update(-1.0, y, 1.0);
+  const ST diff = y_mf.norm2();
+
+  Teuchos::RCP<Teuchos::FancyOStream> out = Teuchos::VerboseObjectBase::getDefaultOStream();
+  *out << "Aeras::HVDecorator: |L_mf x - L x| / |L x| = " << diff/norm << std::endl;
+  TEUCHOS_TEST_FOR_EXCEPTION(diff > 1.0e-10*norm, std::logic_error,
+      "Aeras::HVDecorator: the matrix-free Laplace operator does not match the assembled one, "
+      "set \"Matrix-Free Hyperviscosity\" to false.\n");
+}
+
 //og: do I have to copy/paste this from AMET.cpp?
 namespace {
 // As of early Jan 2015, it seems there is some conflict between Thyra's use of
@@ -14,6 +14,8 @@
 
 #include "Thyra_ModelEvaluatorDefaultBase.hpp"
 
+#include <vector>
+
 namespace Aeras {
 
 ///
@@ -36,6 +38,9 @@ public:
 
   void applyLinvML(Teuchos::RCP<const Tpetra_Vector> x_in, Teuchos::RCP<Tpetra_Vector> x_out) const; 
 
+  //! y = laplace * x, element by element without the assembled matrix
+  void applyLaplaceMatrixFree(const Tpetra_Vector& x, Tpetra_Vector& y) const;
+
 protected:
 
   //! Evaluate model on InArgs
@@ -44,9 +49,31 @@ protected:
       const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const;
 
 private: 
+  //! Precompute the element data of the matrix-free Laplace operator
+  void setupMatrixFreeLaplace();
+
+  //! Compare the matrix-free and the assembled Laplace operators on a random vector
+  void checkMatrixFreeLaplace(const Teuchos::RCP<Tpetra_CrsMatrix>& laplace) const;
+
   //Mass and Laplace operators
   Teuchos::RCP<Tpetra_CrsMatrix> laplace_; 
   Teuchos::RCP<Tpetra_Vector> inv_mass_diag_, wrk_;
+
+  //Matrix-free Laplace operator: the weak Laplacian of each spectral element is
+  //applied through the 1D GLL derivative matrix (sum factorization) with the
+  //metric terms of ComputeBasisFunctions, then scattered and summed over elements.
+  bool matrixFree_;
+  int np_;                        //points per element edge
+  std::vector<double> gllDeriv_;  //np x np, gllDeriv_[i*np+a] = dl_a/dxi(xi_i)
+  std::vector<double> metric_;    //per element and node: w*Jinv*Jinv^T (00, 01, 11)
+  std::vector<double> rotation_;  //per element and node: lon/lat to xyz (k11, k12, k21, k22, k32)
+  std::vector<int> scalarEqs_;    //equations with a scalar Laplacian
+  std::vector<int> vectorEqs_;    //first equation of each (u_lambda, u_theta) pair
+  double hvScale_;                //sqrt(Hyperviscosity Tau)
+  Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<Teuchos::ArrayRCP<LO> > > >::type wsElNodeEqID_;
+  Teuchos::RCP<Tpetra_Import> importer_;
+  Teuchos::RCP<Tpetra_Export> exporter_;
+  Teuchos::RCP<Tpetra_Vector> x_overlap_, y_overlap_;
 };
 
 }
@@ -14,6 +14,8 @@
 
 #include "Aeras_Layouts.hpp"
 #include "Aeras_EvaluatorUtilities.hpp"
+#include "Aeras_SpectralSumFactorization.hpp"
+#include "PHAL_GeometryCache.hpp"
 
 #include "Intrepid2_CellTools.hpp"
 #include "Intrepid2_Cubature.hpp"
@@ -89,7 +91,14 @@ private:
                             const double rrearth=1) const;
   void initialize_grad(Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> &) const;
 
+  //! Non-null if the mapping gradient uses the O(np^3) sum-factorized kernel
+  Teuchos::RCP<const SpectralSumFactorization> sumFactorization;
+
   MDFieldMemoizer<Traits> memoizer_;
+  PHAL::GeometryCache<EvalT, Traits> geometryCache_;
+
+  void loadGeometry();
+  void storeGeometry();
 
   // Kokkos
 #ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
@@ -10,6 +10,7 @@
 
 #include "Intrepid2_FunctionSpaceTools.hpp"
 #include "Aeras_ShallowWaterConstants.hpp"
+#include "Aeras_SphericalMap.hpp"
 
 namespace Aeras {
 
@@ -36,6 +37,9 @@ ComputeBasisFunctions(const Teuchos::ParameterList& p,
   jacobian  (p.get<std::string>  ("Jacobian Name"), dl->qp_tensor ),
   earthRadius(ShallowWaterConstants::self().earthRadius)
 {
+  if (p.isParameter("Sum Factorization"))
+    sumFactorization = p.get<Teuchos::RCP<const SpectralSumFactorization> >("Sum Factorization");
+
   this->addDependentField(coordVec);
   this->addEvaluatedField(weighted_measure);
   this->addEvaluatedField(sphere_coord);
@@ -351,6 +355,10 @@ void ComputeBasisFunctions<EvalT, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
   if (memoizer_.haveStoredData(workset)) return;
+  if (geometryCache_.haveStoredData(workset)) {
+    loadGeometry();
+    return;
+  }
 
   /** The allocated size of the Field Containers must currently 
     * match the full workset size of the allocated PHX Fields, 
@@ -387,25 +395,12 @@ evaluateFields(typename Traits::EvalData workset)
     Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device>  phi(numQPs,spatialDim);
     Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> dphi(numQPs,spatialDim,basisDim);
     Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> norm(numQPs);
-    Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> sinL(numQPs);
-    Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> cosL(numQPs);
-    Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> sinT(numQPs);
-    Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> cosT(numQPs);
-    Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device>   D1(numQPs,basisDim,spatialDim);
-    Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device>   D2(numQPs,spatialDim,spatialDim);
-    Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device>   D3(numQPs,basisDim,spatialDim);
     
     for (int e = 0; e<numelements;      ++e) {
       for (int v = 0; v<numNodes;      ++v) {
-        //  phi(q,d) += coordVec(e,v,d) * val_at_cub_points(v,q);
-        //const MeshScalarT latitude  = std::asin(phi(q,2));  //theta
-        const MeshScalarT latitude  = std::asin(coordVec(e,v,2));  //theta
-
-        //MeshScalarT longitude = std::atan2(phi(q,1),phi(q,0));  //lambda
-        MeshScalarT longitude = std::atan2(coordVec(e,v,1),coordVec(e,v,0));  //lambda
-        if (std::abs(std::abs(latitude)-pi/2) < DIST_THRESHOLD) longitude = 0;
-        else if (longitude < 0) longitude += 2*pi;
-
+        MeshScalarT longitude, latitude;
+        sphereCoordinates<MeshScalarT>(coordVec(e,v,0), coordVec(e,v,1), coordVec(e,v,2),
+                                       longitude, latitude);
         lambda_nodal(e,v) = longitude;
         theta_nodal(e,v) = latitude;
       }
@@ -426,31 +421,34 @@ evaluateFields(typename Traits::EvalData workset)
       phi.initialize(); 
       dphi.initialize(); 
       norm.initialize(); 
-      sinL.initialize(); 
-      cosL.initialize(); 
-      sinT.initialize(); 
-      cosT.initialize(); 
-      D1.initialize(); 
-      D2.initialize(); 
-      D3.initialize();
 
-      for (int q = 0; q<numQPs;          ++q)
-        for (int b1= 0; b1<basisDim;     ++b1)
-          for (int b2= 0; b2<basisDim;   ++b2)
-            for (int d = 0; d<spatialDim;++d)
-              jacobian(e,q,b1,b2) = 0;
-      
 
-      for (int q = 0; q<numQPs;         ++q) 
-        for (int d = 0; d<spatialDim;   ++d) 
-          for (int v = 0; v<numNodes;  ++v)
-            phi(q,d) += coordVec(e,v,d) * val_at_cub_points(v,q);
+      if (sumFactorization != Teuchos::null) {
+        // Collocated nodes and points: only the nodal value contributes to phi
+        for (int q = 0; q<numQPs;         ++q) 
+          for (int d = 0; d<spatialDim;   ++d) 
+            phi(q,d) = coordVec(e,q,d) * val_at_cub_points(q,q);
 
-      for (int v = 0; v<numNodes;      ++v)
-        for (int q = 0; q<numQPs;       ++q) 
-          for (int d = 0; d<spatialDim; ++d) 
-            for (int b = 0; b<basisDim; ++b) 
-              dphi(q,d,b) += coordVec(e,v,d) * grad_at_cub_points(v,q,b);
+        for (int d = 0; d<spatialDim;     ++d)
+          sumFactorization->referenceGradient<MeshScalarT>(
+              [&](const int v) -> MeshScalarT { return coordVec(e,v,d); },
+              [&](const int q, const MeshScalarT& dxi, const MeshScalarT& deta) {
+                dphi(q,d,0) = dxi;
+                dphi(q,d,1) = deta;
+              });
+      }
+      else {
+        for (int q = 0; q<numQPs;         ++q) 
+          for (int d = 0; d<spatialDim;   ++d) 
+            for (int v = 0; v<numNodes;  ++v)
+              phi(q,d) += coordVec(e,v,d) * val_at_cub_points(v,q);
+
+        for (int v = 0; v<numNodes;      ++v)
+          for (int q = 0; q<numQPs;       ++q) 
+            for (int d = 0; d<spatialDim; ++d) 
+              for (int b = 0; b<basisDim; ++b) 
+                dphi(q,d,b) += coordVec(e,v,d) * grad_at_cub_points(v,q,b);
+      }
   
       for (int q = 0; q<numQPs;         ++q) 
         for (int d = 0; d<spatialDim;   ++d) 
@@ -464,73 +462,23 @@ evaluateFields(typename Traits::EvalData workset)
         for (int d = 0; d<spatialDim;   ++d) 
           phi(q,d) /= norm(q);
      
+      // The map and its Jacobian at each point, see Aeras_SphericalMap.hpp
       for (int q = 0; q<numQPs;         ++q) {
-
-        // ==========================================================
-        // enforce three facts:
-        //
-        // 1) lon at poles is defined to be zero
-        //
-        // 2) Grid points must be separated by about .01 Meter (on earth)
-        //   from pole to be considered "not the pole".
-        //
-        // 3) range of lon is { 0<= lon < 2*PI }
-        //
-        // ==========================================================
-
-        const MeshScalarT latitude  = std::asin(phi(q,2));  //theta
-
-        MeshScalarT longitude = std::atan2(phi(q,1),phi(q,0));  //lambda
-        if (std::abs(std::abs(latitude)-pi/2) < DIST_THRESHOLD) longitude = 0;
-        else if (longitude < 0) longitude += 2*pi;
-
-
+        MeshScalarT longitude, latitude;
+        sphereCoordinates<MeshScalarT>(phi(q,0), phi(q,1), phi(q,2), longitude, latitude);
         sphere_coord(e,q,0) = longitude;
         sphere_coord(e,q,1) = latitude;
 
-        sinT(q) = std::sin(latitude);
-        cosT(q) = std::cos(latitude);
-        sinL(q) = std::sin(longitude);
-        cosL(q) = std::cos(longitude);
-      }
-
-      for (int q = 0; q<numQPs;         ++q) {
-        D1(q,0,0) = -sinL(q);
-        D1(q,0,1) =  cosL(q);
-        D1(q,1,2) =        1;
+        MeshScalarT dphi_q[3][2], jac_q[2][2];
+        for (int d = 0; d<spatialDim;   ++d)
+          for (int b = 0; b<basisDim;   ++b)
+            dphi_q[d][b] = dphi(q,d,b);
+        sphericalMapJacobian<MeshScalarT>(longitude, latitude, dphi_q,
+                                          earthRadius/norm(q), jac_q);
+        for (int b1= 0; b1<basisDim;    ++b1)
+          for (int b2= 0; b2<basisDim;  ++b2)
+            jacobian(e,q,b1,b2) = jac_q[b1][b2];
       }
-
-      for (int q = 0; q<numQPs;         ++q) {
-        D2(q,0,0) =  sinL(q)*sinL(q)*cosT(q)*cosT(q) + sinT(q)*sinT(q);
-        D2(q,0,1) = -sinL(q)*cosL(q)*cosT(q)*cosT(q);
-        D2(q,0,2) = -cosL(q)*sinT(q)*cosT(q);
-
-        D2(q,1,0) = -sinL(q)*cosL(q)*cosT(q)*cosT(q); 
-        D2(q,1,1) =  cosL(q)*cosL(q)*cosT(q)*cosT(q) + sinT(q)*sinT(q); 
-        D2(q,1,2) = -sinL(q)*sinT(q)*cosT(q);
-
-        D2(q,2,0) = -cosL(q)*sinT(q);   
-        D2(q,2,1) = -sinL(q)*sinT(q);   
-        D2(q,2,2) =  cosT(q);
-      }
-
-      for (int q = 0; q<numQPs;          ++q) 
-        for (int b = 0; b<basisDim;      ++b) 
-          for (int d = 0; d<spatialDim;  ++d) 
-            for (int j = 0; j<spatialDim;++j) 
-              D3(q,b,d) += D1(q,b,j)*D2(q,j,d);
-
-      for (int q = 0; q<numQPs;          ++q) 
-        for (int b1= 0; b1<basisDim;     ++b1) 
-          for (int b2= 0; b2<basisDim;   ++b2) 
-            for (int d = 0; d<spatialDim;++d) 
-              jacobian(e,q,b1,b2) += D3(q,b1,d) *  dphi(q,d,b2);
-
-      for (int q = 0; q<numQPs;          ++q) 
-        for (int b1= 0; b1<basisDim;     ++b1) 
-          for (int b2= 0; b2<basisDim;   ++b2){
-            jacobian(e,q,b1,b2) *= earthRadius/norm(q);
-          }
       //IKT - debug output
       /*if (e == 0) {    
         for (int q = 0; q<numQPs;          ++q)
@@ -776,10 +724,46 @@ evaluateFields(typename Traits::EvalData workset)
 
 #endif // ALBANY_KOKKOS_UNDER_DEVELOPMENT
 
+  storeGeometry();
+
   //IKT, 5/17/16: note that div_check code is not Kokkos-ized.
   //div_check(spatialDim, numelements);
 }
 
+//**********************************************************************
+template<typename EvalT, typename Traits>
+void ComputeBasisFunctions<EvalT, Traits>::loadGeometry()
+{
+  geometryCache_.load(weighted_measure);
+  geometryCache_.load(sphere_coord);
+  geometryCache_.load(lambda_nodal);
+  geometryCache_.load(theta_nodal);
+  geometryCache_.load(jacobian_det);
+  geometryCache_.load(jacobian_inv);
+  geometryCache_.load(jacobian);
+  geometryCache_.load(BF);
+  geometryCache_.load(wBF);
+  geometryCache_.load(GradBF);
+  geometryCache_.load(wGradBF);
+}
+
+template<typename EvalT, typename Traits>
+void ComputeBasisFunctions<EvalT, Traits>::storeGeometry()
+{
+  geometryCache_.store(weighted_measure);
+  geometryCache_.store(sphere_coord);
+  geometryCache_.store(lambda_nodal);
+  geometryCache_.store(theta_nodal);
+  geometryCache_.store(jacobian_det);
+  geometryCache_.store(jacobian_inv);
+  geometryCache_.store(jacobian);
+  geometryCache_.store(BF);
+  geometryCache_.store(wBF);
+  geometryCache_.store(GradBF);
+  geometryCache_.store(wGradBF);
+  geometryCache_.setStored();
+}
+
 
 
 template<typename EvalT, typename Traits>
@@ -13,6 +13,7 @@
 #include "Phalanx_MDField.hpp"
 
 #include "Aeras_Layouts.hpp"
+#include "Aeras_SpectralSumFactorization.hpp"
 
 namespace Aeras {
 /** \brief Finite Element Interpolation Evaluator
@@ -55,6 +56,9 @@ private:
   const int numDims;
   const int numQPs;
 
+  //! Non-null if the line-restricted O(np^3) kernel is used
+  Teuchos::RCP<const SpectralSumFactorization> sumFactorization;
+
 #ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
 public:
   typedef Kokkos::View<int***, PHX::Device>::execution_space ExecutionSpace;
@@ -13,6 +13,7 @@
 #include "Phalanx_MDField.hpp"
 
 #include "Aeras_Layouts.hpp"
+#include "Aeras_SpectralSumFactorization.hpp"
 #include "Aeras_Dimension.hpp"
 
 namespace Aeras {
@@ -57,6 +58,9 @@ private:
   const int numQPs;
   const int numLevels;
 
+  //! Non-null if the line-restricted O(np^3) kernel is used
+  Teuchos::RCP<const SpectralSumFactorization> sumFactorization;
+
 #ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
 public:
   typedef Kokkos::View<int***, PHX::Device>::execution_space ExecutionSpace;
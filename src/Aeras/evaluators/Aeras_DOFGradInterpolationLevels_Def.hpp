@@ -23,7 +23,9 @@ DOFGradInterpolationLevels(Teuchos::ParameterList& p,
   numNodes   (dl->node_scalar             ->dimension(1)),
   numDims    (dl->node_qp_gradient        ->dimension(3)),
   numQPs     (dl->node_qp_scalar          ->dimension(2)),
-  numLevels  (dl->node_scalar_level       ->dimension(2))
+  numLevels  (dl->node_scalar_level       ->dimension(2)),
+  sumFactorization (p.isParameter("Sum Factorization") ?
+                    p.get<Teuchos::RCP<const SpectralSumFactorization> >("Sum Factorization") : Teuchos::null)
 {
   this->addDependentField(val_node);
   this->addDependentField(GradBF);
@@ -102,6 +104,31 @@ evaluateFields(typename Traits::EvalData workset)
   }
   */
 
+  if (sumFactorization != Teuchos::null) {
+    // Only the nodes on the two element lines through qp contribute
+    const int np = sumFactorization->np();
+    for (int cell=0; cell < workset.numCells; ++cell) {
+      for (int qp=0; qp < numQPs; ++qp) {
+        const int j = sumFactorization->etaIndex(qp);
+        for (int level=0; level < numLevels; ++level) {
+          for (int dim=0; dim<numDims; dim++) {
+            typename PHAL::Ref<ScalarT>::type gvqp = grad_val_qp(cell,qp,level,dim) = 0;
+            for (int a=0; a < np; ++a) {
+              const int node = sumFactorization->xiLineNode(qp, a);
+              gvqp += val_node(cell, node, level) * GradBF(cell, node, qp, dim);
+            }
+            for (int b=0; b < np; ++b) {
+              if (b == j) continue;
+              const int node = sumFactorization->etaLineNode(qp, b);
+              gvqp += val_node(cell, node, level) * GradBF(cell, node, qp, dim);
+            }
+          }
+        }
+      }
+    }
+    return;
+  }
+
   for (int cell=0; cell < workset.numCells; ++cell) {
     for (int qp=0; qp < numQPs; ++qp) {
       for (int level=0; level < numLevels; ++level) {
@@ -22,7 +22,9 @@ DOFGradInterpolation(Teuchos::ParameterList& p,
   grad_val_qp (p.get<std::string>   ("Gradient Variable Name"),dl->qp_gradient), 
   numNodes   (dl->node_scalar             ->dimension(1)),
   numDims    (dl->node_qp_gradient        ->dimension(3)),
-  numQPs     (dl->node_qp_scalar          ->dimension(2))
+  numQPs     (dl->node_qp_scalar          ->dimension(2)),
+  sumFactorization (p.isParameter("Sum Factorization") ?
+                    p.get<Teuchos::RCP<const SpectralSumFactorization> >("Sum Factorization") : Teuchos::null)
 {
   this->addDependentField(val_node);
   this->addDependentField(GradBF);
@@ -71,6 +73,29 @@ evaluateFields(typename Traits::EvalData workset)
   // for (int i=0; i < grad_val_qp.size() ; i++) grad_val_qp[i] = 0.0;
   // Intrepid2::FunctionSpaceTools:: evaluate<ScalarT>(grad_val_qp, val_node, GradBF);
 
+  if (sumFactorization != Teuchos::null) {
+    // Only the nodes on the two element lines through qp contribute
+    const int np = sumFactorization->np();
+    for (int cell=0; cell < workset.numCells; ++cell) {
+      for (int qp=0; qp < numQPs; ++qp) {
+        const int j = sumFactorization->etaIndex(qp);
+        for (int dim=0; dim<numDims; dim++) {
+          typename PHAL::Ref<ScalarT>::type gvqp = grad_val_qp(cell,qp,dim) = 0;
+          for (int a=0; a < np; ++a) {
+            const int node = sumFactorization->xiLineNode(qp, a);
+            gvqp += val_node(cell, node) * GradBF(cell, node, qp, dim);
+          }
+          for (int b=0; b < np; ++b) {
+            if (b == j) continue;
+            const int node = sumFactorization->etaLineNode(qp, b);
+            gvqp += val_node(cell, node) * GradBF(cell, node, qp, dim);
+          }
+        }
+      }
+    }
+    return;
+  }
+
   for (int cell=0; cell < workset.numCells; ++cell) {
     for (int qp=0; qp < numQPs; ++qp) {
       for (int dim=0; dim<numDims; dim++) {
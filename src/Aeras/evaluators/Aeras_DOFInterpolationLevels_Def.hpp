@@ -21,7 +21,9 @@ DOFInterpolationLevels(Teuchos::ParameterList& p,
   val_qp      (p.get<std::string>   ("Variable Name"), dl->qp_scalar_level),
   numNodes   (dl->node_scalar             ->dimension(1)),
   numQPs     (dl->node_qp_scalar          ->dimension(2)),
-  numLevels  (dl->node_scalar_level       ->dimension(2))
+  numLevels  (dl->node_scalar_level       ->dimension(2)),
+  sumFactorization (p.isParameter("Sum Factorization") ?
+                    p.get<Teuchos::RCP<const SpectralSumFactorization> >("Sum Factorization") : Teuchos::null)
 {
   this->addDependentField(val_node);
   this->addDependentField(BF);
@@ -70,6 +72,15 @@ evaluateFields(typename Traits::EvalData workset)
   //Intrepid2 version:
   // for (int i=0; i < val_qp.size() ; i++) val_qp[i] = 0.0;
   // Intrepid2::FunctionSpaceTools:: evaluate<ScalarT>(val_qp, val_node, BF);
+  if (sumFactorization != Teuchos::null) {
+    // Collocated nodes and points: BF(cell, node, qp) vanishes for node != qp
+    for (int cell=0; cell < workset.numCells; ++cell)
+      for (int qp=0; qp < numQPs; ++qp)
+        for (int level=0; level < numLevels; ++level)
+          val_qp(cell,qp,level) = val_node(cell, qp, level) * BF(cell, qp, qp);
+    return;
+  }
+
   for (int cell=0; cell < workset.numCells; ++cell) {
     for (int qp=0; qp < numQPs; ++qp) {
       for (int level=0; level < numLevels; ++level) {
@@ -13,6 +13,7 @@
 #include "Phalanx_MDField.hpp"
 #include "Albany_Layouts.hpp"
 #include "Sacado_ParameterAccessor.hpp"
+#include "Aeras_SpectralSumFactorization.hpp"
 
 #include <Shards_CellTopology.hpp>
 #include <Intrepid2_Basis.hpp>
@@ -136,6 +137,9 @@ private:
 	std::vector<LO> qpToNodeMap;
 	std::vector<LO> nodeToQPMap;
 
+	// Non-null if the gradient, divergence and curl use the O(np^3) sum-factorized kernels
+	Teuchos::RCP<const SpectralSumFactorization> sumFactorization;
+
 #else
 public:
 
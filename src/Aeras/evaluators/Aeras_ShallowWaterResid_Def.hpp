@@ -89,6 +89,11 @@ ShallowWaterResid(const Teuchos::ParameterList& p,
 
   AlphaAngle = shallowWaterList->get<double>("Rotation Angle", 0.0); //Default: 0.0
 
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  if (p.isParameter("Sum Factorization"))
+    sumFactorization = p.get<Teuchos::RCP<const SpectralSumFactorization> >("Sum Factorization");
+#endif
+
   const CellTopologyData *ctd = cellType->getCellTopologyData();
   int nNodes = ctd->node_count;
   int nDim   = ctd->dimension;
@@ -1650,10 +1655,18 @@ ShallowWaterResid<EvalT,Traits>::divergence(const Intrepid2::FieldContainer_Kokk
 			jinv10*fieldAtNodes(node, 0)+ jinv11*fieldAtNodes(node, 1) );
   }
 
-  for (std::size_t qp=0; qp < numQPs; ++qp) {
-    for (std::size_t node=0; node < numNodes; ++node) {
-      div(qp) += vcontra(node, 0)*grad_at_cub_points(node, qp,0)
-               + vcontra(node, 1)*grad_at_cub_points(node, qp,1);
+  if (sumFactorization != Teuchos::null) {
+    sumFactorization->referenceDivergence<ScalarT>(
+        [&](const int node) -> ScalarT { return vcontra(node, 0); },
+        [&](const int node) -> ScalarT { return vcontra(node, 1); },
+        [&](const int qp, const ScalarT& d) { div(qp) = d; });
+  }
+  else {
+    for (std::size_t qp=0; qp < numQPs; ++qp) {
+      for (std::size_t node=0; node < numNodes; ++node) {
+        div(qp) += vcontra(node, 0)*grad_at_cub_points(node, qp,0)
+                 + vcontra(node, 1)*grad_at_cub_points(node, qp,1);
+      }
     }
   }
 
@@ -1682,6 +1695,16 @@ ShallowWaterResid<EvalT,Traits>::gradient(const Intrepid2::FieldContainer_Kokkos
 {
   gradField.initialize();
 
+  if (sumFactorization != Teuchos::null) {
+    sumFactorization->referenceGradient<ScalarT>(
+        [&](const int node) -> ScalarT { return fieldAtNodes(node); },
+        [&](const int qp, const ScalarT& gx, const ScalarT& gy) {
+          gradField(qp, 0) = jacobian_inv(cell, qp, 0, 0)*gx + jacobian_inv(cell, qp, 1, 0)*gy;
+          gradField(qp, 1) = jacobian_inv(cell, qp, 0, 1)*gx + jacobian_inv(cell, qp, 1, 1)*gy;
+        });
+    return;
+  }
+
   for (std::size_t qp=0; qp < numQPs; ++qp) {
     ScalarT gx = 0;
     ScalarT gy = 0;
@@ -1746,12 +1769,21 @@ ShallowWaterResid<EvalT,Traits>::curl(const Intrepid2::FieldContainer_Kokkos<Sca
   }
 
 
-  for (std::size_t qp=0; qp < numQPs; ++qp) {
-    for (std::size_t node=0; node < numNodes; ++node) {
-      curl(qp) += covariantVector(node, 1)*grad_at_cub_points(node, qp,0)
-                - covariantVector(node, 0)*grad_at_cub_points(node, qp,1);
+  if (sumFactorization != Teuchos::null) {
+    // curl = d(v_eta)/dxi - d(v_xi)/deta
+    sumFactorization->referenceDivergence<ScalarT>(
+        [&](const int node) -> ScalarT { return covariantVector(node, 1); },
+        [&](const int node) -> ScalarT { return -covariantVector(node, 0); },
+        [&](const int qp, const ScalarT& c) { curl(qp) = c/jacobian_det(cell,qp); });
+  }
+  else {
+    for (std::size_t qp=0; qp < numQPs; ++qp) {
+      for (std::size_t node=0; node < numNodes; ++node) {
+        curl(qp) += covariantVector(node, 1)*grad_at_cub_points(node, qp,0)
+                  - covariantVector(node, 0)*grad_at_cub_points(node, qp,1);
+      }
+      curl(qp) = curl(qp)/jacobian_det(cell,qp);
     }
-    curl(qp) = curl(qp)/jacobian_det(cell,qp);
   }
 
   /////////// Debugging option, to verufy 3d code
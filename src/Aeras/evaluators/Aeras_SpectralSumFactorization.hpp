@@ -0,0 +1,152 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef AERAS_SPECTRALSUMFACTORIZATION_HPP
+#define AERAS_SPECTRALSUMFACTORIZATION_HPP
+
+#include "Albany_DataTypes.hpp"
+#include "Phalanx_config.hpp"
+
+#include "Teuchos_RCP.hpp"
+
+#include <Intrepid2_Basis.hpp>
+#include <Intrepid2_Cubature.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Aeras {
+
+/** \brief Tensor-product structure of a collocated spectral quadrilateral
+
+    Aeras::SpectralDiscretization numbers the np x np Gauss-Lobatto nodes of
+    an element lexicographically, node = i + np*j, and the quadrature points
+    coincide with the nodes. The reference gradient of a nodal field u then
+    only involves the nodes on the two lines through each point,
+
+      du/dxi (i,j) = sum_a D(i,a) u(a,j),   du/deta (i,j) = sum_b D(j,b) u(i,b),
+
+    with D the 1D derivative matrix, which costs O(np^3) per element instead
+    of the O(np^4) of contracting with the full numNodes x numQPs tables.
+    The same holds for the physical Gradient BF, which is the reference
+    gradient transformed pointwise by the inverse Jacobian.
+
+    D is read off the reference basis gradients, so the results differ from
+    the full contraction only by the roundoff-level entries of the tables
+    off the lines.
+*/
+class SpectralSumFactorization {
+public:
+
+  typedef Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> FieldContainer;
+
+  //! Null if the basis and the cubature do not have the collocated
+  //! tensor-product structure described above
+  static Teuchos::RCP<const SpectralSumFactorization>
+  create(const Teuchos::RCP<Intrepid2::Basis<RealType, FieldContainer> >& basis,
+         const Teuchos::RCP<Intrepid2::Cubature<RealType, FieldContainer> >& cubature)
+  {
+    const int numNodes = basis->getCardinality();
+    const int numQPs   = cubature->getNumPoints();
+    const int np = static_cast<int>(std::sqrt(static_cast<double>(numNodes)) + 0.5);
+    if (cubature->getDimension() != 2 || numNodes != numQPs || np*np != numNodes || np < 2)
+      return Teuchos::null;
+
+    FieldContainer refPoints(numQPs, 2);
+    FieldContainer refWeights(numQPs);
+    FieldContainer val(numNodes, numQPs);
+    FieldContainer grad(numNodes, numQPs, 2);
+    cubature->getCubature(refPoints, refWeights);
+    basis->getValues(val, refPoints, Intrepid2::OPERATOR_VALUE);
+    basis->getValues(grad, refPoints, Intrepid2::OPERATOR_GRAD);
+
+    Teuchos::RCP<SpectralSumFactorization> sf = Teuchos::rcp(new SpectralSumFactorization(np));
+    for (int i = 0; i < np; ++i)
+      for (int a = 0; a < np; ++a)
+        sf->D_[i*np + a] = grad(a, i, 0);
+
+    // Check the full tables against the factored and collocated forms
+    double scale = 0;
+    for (int k = 0; k < np*np; ++k) scale = std::max(scale, std::abs(sf->D_[k]));
+    const double tol = 1.0e-10*scale;
+    for (int n = 0; n < numNodes; ++n) {
+      const int a = n % np, b = n / np;
+      for (int q = 0; q < numQPs; ++q) {
+        const int i = q % np, j = q / np;
+        const double dxi  = (b == j) ? sf->D(i, a) : 0.0;
+        const double deta = (a == i) ? sf->D(j, b) : 0.0;
+        if (std::abs(grad(n, q, 0) - dxi) > tol || std::abs(grad(n, q, 1) - deta) > tol)
+          return Teuchos::null;
+        if (std::abs(val(n, q) - (n == q ? 1.0 : 0.0)) > 1.0e-10)
+          return Teuchos::null;
+      }
+    }
+    return sf;
+  }
+
+  //! Points per edge
+  int np() const { return np_; }
+
+  //! 1D derivative of the a-th Lagrange polynomial at the i-th point
+  double D(const int i, const int a) const { return D_[i*np_ + a]; }
+
+  //! Node a of the xi line through point q
+  int xiLineNode(const int q, const int a) const { return a + np_*(q / np_); }
+
+  //! Node b of the eta line through point q
+  int etaLineNode(const int q, const int b) const { return q % np_ + np_*b; }
+
+  //! Index of point q along its eta line (the node shared by both lines
+  //! through q is etaLineNode(q, etaIndex(q)) == xiLineNode(q, q % np))
+  int etaIndex(const int q) const { return q / np_; }
+
+  //! Reference gradient of u (nodal values, u(node)) at every point q;
+  //! calls out(q, du/dxi, du/deta)
+  template<typename ScalarT, typename NodalValues, typename Output>
+  void referenceGradient(const NodalValues& u, const Output& out) const
+  {
+    for (int j = 0; j < np_; ++j) {
+      for (int i = 0; i < np_; ++i) {
+        ScalarT dxi = 0;
+        ScalarT deta = 0;
+        for (int a = 0; a < np_; ++a) {
+          dxi  += D_[i*np_ + a]*u(a + np_*j);
+          deta += D_[j*np_ + a]*u(i + np_*a);
+        }
+        out(i + np_*j, dxi, deta);
+      }
+    }
+  }
+
+  //! Reference divergence du/dxi + dv/deta of the pair (u, v) at every point q;
+  //! calls out(q, div)
+  template<typename ScalarT, typename NodalValuesU, typename NodalValuesV, typename Output>
+  void referenceDivergence(const NodalValuesU& u, const NodalValuesV& v, const Output& out) const
+  {
+    for (int j = 0; j < np_; ++j) {
+      for (int i = 0; i < np_; ++i) {
+        ScalarT div = 0;
+        for (int a = 0; a < np_; ++a) {
+          div += D_[i*np_ + a]*u(a + np_*j);
+          div += D_[j*np_ + a]*v(i + np_*a);
+        }
+        out(i + np_*j, div);
+      }
+    }
+  }
+
+private:
+
+  explicit SpectralSumFactorization(const int np) : np_(np), D_(np*np, 0.0) {}
+
+  int np_;
+  std::vector<double> D_;
+};
+
+} // namespace Aeras
+
+#endif
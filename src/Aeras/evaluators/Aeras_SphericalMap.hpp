@@ -0,0 +1,77 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef AERAS_SPHERICALMAP_HPP
+#define AERAS_SPHERICALMAP_HPP
+
+#include "Aeras_ShallowWaterConstants.hpp"
+
+#include <cmath>
+
+namespace Aeras {
+
+/** \brief Longitude and latitude of a point on the sphere
+
+    Enforces the conventions of Aeras::ComputeBasisFunctions: the longitude
+    is in [0, 2*pi) and is zero at the poles, points closer to a pole than
+    ShallowWaterConstants::distanceThreshold being the pole. (x, y, z) is
+    expected on the unit sphere.
+*/
+template<typename ScalarT>
+void sphereCoordinates(const ScalarT& x, const ScalarT& y, const ScalarT& z,
+                       ScalarT& longitude, ScalarT& latitude)
+{
+  const double pi = ShallowWaterConstants::self().pi;
+  const double DIST_THRESHOLD = ShallowWaterConstants::self().distanceThreshold;
+
+  latitude  = std::asin(z);
+  longitude = std::atan2(y, x);
+  if (std::abs(std::abs(latitude)-pi/2) < DIST_THRESHOLD) longitude = 0;
+  else if (longitude < 0) longitude += 2*pi;
+}
+
+/** \brief Jacobian of the (non-HOMME) map of a spectral element to the sphere
+
+    dphi[d][b] is the reference gradient of the interpolated Cartesian
+    coordinate d at a point with the given longitude and latitude, and
+    scale is earthRadius over the norm of the interpolated point. jac[b1][b2]
+    is the Jacobian in the lon/lat frame, as ComputeBasisFunctions computes
+    it.
+*/
+template<typename ScalarT>
+void sphericalMapJacobian(const ScalarT& longitude, const ScalarT& latitude,
+                          const ScalarT dphi[3][2], const ScalarT& scale,
+                          ScalarT jac[2][2])
+{
+  const ScalarT sinL = std::sin(longitude), cosL = std::cos(longitude);
+  const ScalarT sinT = std::sin(latitude),  cosT = std::cos(latitude);
+
+  const ScalarT D1[2][3] = {{-sinL, cosL, 0},
+                            {    0,    0, 1}};
+  const ScalarT D2[3][3] = {{ sinL*sinL*cosT*cosT + sinT*sinT, -sinL*cosL*cosT*cosT,            -cosL*sinT*cosT},
+                            {-sinL*cosL*cosT*cosT,             cosL*cosL*cosT*cosT + sinT*sinT, -sinL*sinT*cosT},
+                            {-cosL*sinT,                       -sinL*sinT,                       cosT}};
+
+  ScalarT D3[2][3];
+  for (int b = 0; b<2; ++b)
+    for (int d = 0; d<3; ++d) {
+      D3[b][d] = 0;
+      for (int j = 0; j<3; ++j)
+        D3[b][d] += D1[b][j]*D2[j][d];
+    }
+
+  for (int b1= 0; b1<2; ++b1)
+    for (int b2= 0; b2<2; ++b2) {
+      jac[b1][b2] = 0;
+      for (int d = 0; d<3; ++d)
+        jac[b1][b2] += D3[b1][d] * dphi[d][b2];
+      jac[b1][b2] *= scale;
+    }
+}
+
+} // namespace Aeras
+
+#endif
@@ -47,6 +47,7 @@
 #include "Aeras_Hydrostatic_EtaDot.hpp"
 
 #include "Aeras_ComputeBasisFunctions.hpp"
+#include "Aeras_SpectralSumFactorization.hpp"
 #include "Aeras_GatherCoordinateVector.hpp"
 
 #include "Intrepid2_FieldContainer.hpp"
@@ -180,6 +181,16 @@ Aeras::HydrostaticProblem::constructEvaluators(
   RCP <Intrepid2::CubaturePolylib<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > > polylib = rcp(new Intrepid2::CubaturePolylib<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >(meshSpecs.cubatureDegree, meshSpecs.cubatureRule));
   std::vector< Teuchos::RCP<Intrepid2::Cubature<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout,PHX::Device> > > > cubatures(2, polylib); 
   RCP <Intrepid2::Cubature<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout,PHX::Device> > > cubature = rcp( new Intrepid2::CubatureTensor<RealType,Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout,PHX::Device> >(cubatures));
+
+  const bool useSumFactorization = params->sublist("Hydrostatic Problem").get<bool>("Use Sum Factorization", false);
+  RCP<const Aeras::SpectralSumFactorization> sumFactorization;
+  if (useSumFactorization) {
+    sumFactorization = Aeras::SpectralSumFactorization::create(intrepidBasis, cubature);
+    TEUCHOS_TEST_FOR_EXCEPTION(sumFactorization == Teuchos::null,
+                               Teuchos::Exceptions::InvalidParameter,
+                               "Aeras::HydrostaticProblem: \"Use Sum Factorization\" requires spectral elements " <<
+                               "with quadrature points collocated at the Gauss-Lobatto nodes.");
+  }
   
   const int numQPts = cubature->getNumPoints();
   const int numVertices = cellType->getNodeCount();
@@ -299,6 +310,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Gradient BF Name",       "Grad BF");
     p->set<string>("Gradient Variable Name", dof_names_nodes_gradient[0]);
 
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::DOFGradInterpolation<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -310,6 +322,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Gradient BF Name", "Grad BF");
     p->set<string>("Gradient Variable Name", dof_names_tracers_gradient[t]);
 
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -356,6 +369,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Jacobian Inv Name",          "Jacobian Inv");
     p->set<std::size_t>("spatialDim",            3);
 
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::ComputeBasisFunctions<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -407,6 +421,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Variable Name", dof_names_levels[1]);
     p->set<string>("BF Name", "BF");
     
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::DOFInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -416,6 +431,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Variable Name", dof_names_levels_dot[1]);
     p->set<string>("BF Name", "BF");
     
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::DOFInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -427,6 +443,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Gradient BF Name", "Grad BF");
     p->set<string>("Gradient Variable Name", dof_names_levels_gradient[1]);
     
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -466,6 +483,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Gradient BF Name", "Grad BF");
     p->set<string>("Gradient Variable Name", "KineticEnergy_gradient");
   
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -594,6 +612,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
       p->set<string>("Gradient BF Name"    ,   "Grad BF");
       p->set<string>("Gradient Variable Name",   "Gradient QP Pressure");
     
+      p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
       ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
       fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -686,6 +705,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Variable Name", "Cpstar");
     p->set<string>("BF Name", "BF");
 
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::DOFInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -733,6 +753,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
     p->set<string>("Variable Name", "GeoPotential");
     p->set<string>("BF Name", "BF");
     
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::DOFInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -744,6 +765,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
       p->set<string>("Gradient BF Name",       "Grad BF");
       p->set<string>("Gradient Variable Name", "Gradient QP GeoPotential");
     
+      p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
       ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
       fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -865,6 +887,7 @@ Aeras::HydrostaticProblem::constructEvaluators(
       p->set<string>("Gradient BF Name", "Grad BF");
       p->set<string>("Gradient Variable Name", dof_names_tracers_gradient[t]);
     
+      p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
       ev = rcp(new Aeras::DOFGradInterpolationLevels<EvalT,AlbanyTraits>(*p,dl));
       fm0.template registerEvaluator<EvalT>(ev);
     }
@@ -104,6 +104,7 @@ namespace Aeras {
 #include "Aeras_SurfaceHeight.hpp"
 
 #include "Aeras_ComputeBasisFunctions.hpp"
+#include "Aeras_SpectralSumFactorization.hpp"
 #include "Aeras_GatherCoordinateVector.hpp"
 template <typename EvalT>
 Teuchos::RCP<const PHX::FieldTag>
@@ -135,10 +136,21 @@ Aeras::ShallowWaterProblem::constructEvaluators(
   RCP <Intrepid2::CubaturePolylib<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > > polylib = rcp(new Intrepid2::CubaturePolylib<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >(meshSpecs.cubatureDegree, meshSpecs.cubatureRule));
   std::vector< Teuchos::RCP<Intrepid2::Cubature<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout,PHX::Device> > > > cubatures(2, polylib); 
   RCP <Intrepid2::Cubature<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout,PHX::Device> > > cubature = rcp( new Intrepid2::CubatureTensor<RealType,Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout,PHX::Device> >(cubatures));
+
 //  Regular Gauss Quadrature.
 //  Intrepid2::DefaultCubatureFactory<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > cubFactory;
 //  RCP <Intrepid2::Cubature<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout,PHX::Device> > > cubature = cubFactory.create(*cellType, meshSpecs.cubatureDegree);
 
+  const bool useSumFactorization = params->sublist("Shallow Water Problem").get<bool>("Use Sum Factorization", false);
+  RCP<const Aeras::SpectralSumFactorization> sumFactorization;
+  if (useSumFactorization) {
+    sumFactorization = Aeras::SpectralSumFactorization::create(intrepidBasis, cubature);
+    TEUCHOS_TEST_FOR_EXCEPTION(sumFactorization == Teuchos::null,
+                               Teuchos::Exceptions::InvalidParameter,
+                               "Aeras::ShallowWaterProblem: \"Use Sum Factorization\" requires spectral elements " <<
+                               "with quadrature points collocated at the Gauss-Lobatto nodes.");
+  }
+
 
   const int numQPts     = cubature->getNumPoints();
   const int numVertices = meshSpecs.ctd.node_count;
@@ -251,6 +263,7 @@ Aeras::ShallowWaterProblem::constructEvaluators(
     p->set<string>("Jacobian Inv Name",          "Jacobian Inv");
     p->set<std::size_t>("spatialDim", spatialDim);
 
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::ComputeBasisFunctions<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -300,6 +313,7 @@ Aeras::ShallowWaterProblem::constructEvaluators(
     //Output
     p->set<std::string>("Residual Name",       resid_names[0]);
 
+    p->set<RCP<const Aeras::SpectralSumFactorization> >("Sum Factorization", sumFactorization);
     ev = rcp(new Aeras::ShallowWaterResid<EvalT,AlbanyTraits>(*p,dl));
     fm0.template registerEvaluator<EvalT>(ev);
   }
@@ -11,10 +11,12 @@
 #include "Albany_ProblemFactory.hpp"
 #include "Albany_DiscretizationFactory.hpp"
 #include "Albany_ResponseFactory.hpp"
+#include "utility/PerformanceContext.hpp"
 #ifdef ALBANY_STOKHOS
 #include "Stokhos_OrthogPolyBasis.hpp"
 #endif
 #include "Teuchos_TimeMonitor.hpp"
+#include "Teuchos_CommHelpers.hpp"
 
 #if defined(ALBANY_EPETRA)
 #include "Epetra_LocalMap.h"
@@ -25,6 +27,12 @@
 #endif
 
 #include<string>
+#include<algorithm>
+#include<chrono>
+#include<cmath>
+#include<exception>
+#include<set>
+#include<thread>
 #include "Albany_DataTypes.hpp"
 
 #include "Albany_DummyParameterAccessor.hpp"
@@ -63,6 +71,14 @@ using Teuchos::TimeMonitor;
 using Teuchos::getFancyOStream;
 using Teuchos::rcpFromRef;
 
+namespace {
+// Wall time since start, used to measure the cost of each workset
+double secondsSince(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
 int countJac; //counter which counts instances of Jacobian (for debug output)
 int countRes; //counter which counts instances of residual (for debug output)
 int countScale;
@@ -80,7 +96,24 @@ Application(const RCP<const Teuchos_Comm>& comm_,
   morphFromInit(true), perturbBetaForDirichlets(0.0),
   phxGraphVisDetail(0),
   stateGraphVisDetail(0),
-  params_(params)
+  params_(params),
+  checkpointInterval(1),
+  checkpointCount(0),
+  checkpointRestart(false),
+  checkpointTime(0.0),
+  checkpointStepSize(0.0),
+  checkpointLastTime(0.0),
+  numFillThreads(1),
+  threadedFillWarnedProbes(false),
+  threadedFillWarnedParams(false),
+  wsColorsNumWorksets(-1),
+  wsColorsMeshChangeCount(-1),
+  wsAssembledNumWorksets(-1),
+  wsAssembledMeshChangeCount(-1),
+  residualProbes("Residual"),
+  jacobianProbes("Jacobian"),
+  tangentProbes("Tangent"),
+  distParamDerivProbes("DistParamDeriv")
 {
 #if defined(ALBANY_EPETRA)
   comm = Albany::createEpetraCommFromTeuchosComm(comm_);
@@ -101,7 +134,24 @@ Application(const RCP<const Teuchos_Comm>& comm_) :
     shapeParamsHaveBeenReset(false),
     morphFromInit(true), perturbBetaForDirichlets(0.0),
     phxGraphVisDetail(0),
-    stateGraphVisDetail(0)
+    stateGraphVisDetail(0),
+    checkpointInterval(1),
+    checkpointCount(0),
+    checkpointRestart(false),
+    checkpointTime(0.0),
+    checkpointStepSize(0.0),
+    checkpointLastTime(0.0),
+    numFillThreads(1),
+    threadedFillWarnedProbes(false),
+    threadedFillWarnedParams(false),
+    wsColorsNumWorksets(-1),
+    wsColorsMeshChangeCount(-1),
+    wsAssembledNumWorksets(-1),
+    wsAssembledMeshChangeCount(-1),
+    residualProbes("Residual"),
+    jacobianProbes("Jacobian"),
+    tangentProbes("Tangent"),
+    distParamDerivProbes("DistParamDeriv")
 {
 #if defined(ALBANY_EPETRA)
   comm = Albany::createEpetraCommFromTeuchosComm(comm_);
@@ -134,6 +184,81 @@ int calcTangentDerivDimension (
   }
   return std::max(1, np);
 }
+
+// Fixed steps of size dt left from time to finalTime
+int remainingTimeSteps (const double time, const double finalTime,
+                        const double dt)
+{
+  return std::max(1, static_cast<int>(std::floor((finalTime - time)/dt + 0.5)));
+}
+
+// Keep the step size of a fixed-step integration control on restart
+void setRestartTimeSteps (Teuchos::ParameterList& control, const double time,
+                          const double finalTime, const double dt)
+{
+  if (control.isType<int>("Number of Time Steps") &&
+      control.get<int>("Number of Time Steps") > 0)
+    control.set("Number of Time Steps", remainingTimeSteps(time, finalTime, dt));
+  if (control.isParameter("Fixed dt"))
+    control.set("Fixed dt", dt);
+}
+
+// Start the LOCA, Rythmos or trapezoid rule stepper of piroParams at the
+// time of a checkpoint, with the step size it was written with
+void setCheckpointRestartStepper (Teuchos::ParameterList& piroParams,
+                                  const double time, const double dt)
+{
+  if (piroParams.isSublist("LOCA")) {
+    Teuchos::ParameterList& locaParams = piroParams.sublist("LOCA");
+    locaParams.sublist("Stepper").set("Initial Value", time);
+    if (dt > 0.0 && locaParams.isSublist("Step Size"))
+      locaParams.sublist("Step Size").set("Initial Step Size", dt);
+  }
+
+  if (piroParams.isSublist("Rythmos")) {
+    Teuchos::ParameterList& rythmosParams = piroParams.sublist("Rythmos");
+    rythmosParams.set("Initial Time", time);
+    if (dt > 0.0 && rythmosParams.isParameter("Final Time") &&
+        rythmosParams.isSublist("Rythmos Integration Control"))
+      setRestartTimeSteps(rythmosParams.sublist("Rythmos Integration Control"),
+                          time, rythmosParams.get<double>("Final Time"), dt);
+  }
+
+  if (piroParams.isSublist("Rythmos Solver") &&
+      piroParams.sublist("Rythmos Solver").isSublist("Rythmos")) {
+    Teuchos::ParameterList& rythmosParams =
+      piroParams.sublist("Rythmos Solver").sublist("Rythmos");
+    Teuchos::ParameterList& integratorParams =
+      rythmosParams.sublist("Integrator Settings");
+    integratorParams.set("Initial Time", time);
+    if (dt > 0.0) {
+      if (integratorParams.isParameter("Final Time") &&
+          rythmosParams.isSublist("Integration Control Strategy Selection")) {
+        Teuchos::ParameterList& selection =
+          rythmosParams.sublist("Integration Control Strategy Selection");
+        if (selection.isSublist("Simple Integration Control Strategy"))
+          setRestartTimeSteps(selection.sublist("Simple Integration Control Strategy"),
+                              time, integratorParams.get<double>("Final Time"), dt);
+      }
+      if (rythmosParams.isSublist("Stepper Settings") &&
+          rythmosParams.sublist("Stepper Settings").isSublist("Step Control Settings")) {
+        Teuchos::ParameterList& stepControl = rythmosParams.sublist("Stepper Settings")
+          .sublist("Step Control Settings").sublist("Step Control Strategy Selection");
+        if (stepControl.isSublist("Implicit BDF Stepper Ramping Step Control Strategy"))
+          stepControl.sublist("Implicit BDF Stepper Ramping Step Control Strategy")
+            .set("Initial Step Size", dt);
+      }
+    }
+  }
+
+  if (piroParams.isSublist("Trapezoid Rule")) {
+    Teuchos::ParameterList& trapezoidParams = piroParams.sublist("Trapezoid Rule");
+    trapezoidParams.set("Initial Time", time);
+    if (dt > 0.0 && trapezoidParams.isParameter("Final Time"))
+      trapezoidParams.set("Num Time Steps", remainingTimeSteps(
+          time, trapezoidParams.get<double>("Final Time"), dt));
+  }
+}
 } // namespace
 
 void Albany::Application::initialSetUp(const RCP<Teuchos::ParameterList>& params) {
@@ -195,6 +320,29 @@ void Albany::Application::initialSetUp(const RCP<Teuchos::ParameterList>& params
   // Validate Problem parameters against list for this specific problem
   problemParams->validateParameters(*(problem->getValidProblemParameters()),0);
 
+  if (problemParams->isParameter("Checkpoint File Name")) {
+    checkpoint = rcp(new Checkpoint(
+      problemParams->get<std::string>("Checkpoint File Name"), commT));
+    checkpointInterval = problemParams->get("Checkpoint Write Interval", 1);
+    TEUCHOS_TEST_FOR_EXCEPTION(checkpointInterval < 1, std::logic_error,
+                               "Checkpoint Write Interval must be at least 1");
+  }
+
+  numFillThreads = problemParams->get("Number of Fill Threads", 1);
+  TEUCHOS_TEST_FOR_EXCEPTION(numFillThreads < 1, std::logic_error,
+                             "Number of Fill Threads must be at least 1");
+#if !defined(HAVE_TEUCHOS_THREAD_SAFE)
+  TEUCHOS_TEST_FOR_EXCEPTION(numFillThreads > 1, std::logic_error,
+                             "Number of Fill Threads > 1 requires Trilinos "
+                             "configured with Teuchos_ENABLE_THREAD_SAFE=ON");
+#endif
+#ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  TEUCHOS_TEST_FOR_EXCEPTION(numFillThreads > 1, std::logic_error,
+                             "Number of Fill Threads > 1 is not supported with "
+                             "the Kokkos evaluators; use the Kokkos execution "
+                             "space for threading instead");
+#endif
+
   try {
     tangent_deriv_dim = calcTangentDerivDimension(problemParams);
   } catch (...) {
@@ -373,6 +521,10 @@ void Albany::Application::initialSetUp(const RCP<Teuchos::ParameterList>& params
   if (writeToMatrixMarketRes != 0 || writeToCoutRes != 0)
      countRes = 0; //initiate counter that counts instances of Jacobian matrix to 0
 
+  // Fill instrumentation, summarized by the driver (see util::PerformanceContext)
+  if (debugParams->get("Performance Monitoring", false))
+    util::PerformanceContext::instance().setEnabled(true);
+
   //FIXME: call setScaleBCDofs only on first step rather than at every Newton step.
   //It's called every step now b/c calling it once did not work for Schwarz problems.
   countScale = 0;
@@ -445,6 +597,10 @@ void Albany::Application::buildProblem()   {
 
   problem->buildProblem(meshSpecs, stateMgr);
 
+  // Thread-local field managers must register their states before the
+  // discretization allocates them
+  if (numFillThreads > 1) buildThreadFieldManagers();
+
   neq = problem->numEquations();
   spatial_dimension = problem->spatialDimension();
 
@@ -501,6 +657,11 @@ void Albany::Application::createDiscretization() {
                                            problem->getNullSpace());
   //The following is for Aeras problems.
   explicit_scheme = disc->isExplicitScheme();
+
+  // Colors of the worksets of a previous discretization
+  wsColors.clear();
+  wsColorsNumWorksets = -1;
+  wsColorsMeshChangeCount = -1;
 }
 
 void Albany::Application::finalSetUp(const Teuchos::RCP<Teuchos::ParameterList>& params,
@@ -537,6 +698,27 @@ void Albany::Application::finalSetUp(const Teuchos::RCP<Teuchos::ParameterList>&
       commT));
   if (Teuchos::nonnull(rc_mgr)) rc_mgr->setSolutionManager(solMgrT);
 
+  // Overwrite the initial solution and the states with a binary checkpoint.
+  // The discretization is rebuilt from the input and must be the same as
+  // the one that wrote it. params is the list the solver factory hands to
+  // Piro, so the steppers of both the Epetra and the Tpetra solvers resume
+  // at the checkpoint time with its step size.
+  if (params->sublist("Problem").isParameter("Restart Checkpoint File Name")) {
+    const Checkpoint restart(
+      params->sublist("Problem").get<std::string>("Restart Checkpoint File Name"), commT);
+    const RCP<Tpetra_MultiVector> soln = solMgrT->getInitialSolution();
+    restart.read(*soln, stateMgr, checkpointTime, checkpointStepSize);
+    checkpointRestart = true;
+    disc->writeSolutionMVToMeshDatabase(*soln, checkpointTime);
+    if (paramLib->isParameter("Time"))
+      paramLib->setRealValue<PHAL::AlbanyTraits::Residual>("Time", checkpointTime);
+    setCheckpointRestartStepper(params->sublist("Piro"), checkpointTime, checkpointStepSize);
+    if (commT->getRank() == 0)
+      *out << "Restarted from checkpoint " << restart.manifestFileName()
+           << " at time " << checkpointTime << " with step size "
+           << checkpointStepSize << std::endl;
+  }
+
 #ifdef ALBANY_PERIDIGM
 #if defined(ALBANY_EPETRA)
   if (Teuchos::nonnull(LCM::PeridigmManager::self())){
@@ -629,6 +811,9 @@ void Albany::Application::finalSetUp(const Teuchos::RCP<Teuchos::ParameterList>&
 
   perturbBetaForDirichlets = problemParams->get("Perturb Dirichlet",0.0);
 
+  scatter_jacobian_by_offsets =
+    problemParams->get("Scatter Jacobian By Offsets", false);
+
   is_adjoint =
     problemParams->get("Solve Adjoint", false);
 
@@ -1074,6 +1259,237 @@ void checkDerivatives (Albany::Application& app, const double time,
 }
 } // namespace
 
+void
+Albany::Application::
+buildThreadFieldManagers()
+{
+  // Each thread needs its own evaluators, since Phalanx binds field data to
+  // the field manager that owns it. States are registered again by the
+  // copies; StateManager ignores the duplicate registrations.
+  threadFm.resize(numFillThreads - 1);
+  for (int t = 0; t < threadFm.size(); ++t) {
+    threadFm[t].resize(meshSpecs.size());
+    for (int ps = 0; ps < meshSpecs.size(); ++ps) {
+      threadFm[t][ps] = Teuchos::rcp(new PHX::FieldManager<PHAL::AlbanyTraits>);
+      problem->buildEvaluators(*threadFm[t][ps], *meshSpecs[ps], stateMgr,
+                               BUILD_RESID_FM, Teuchos::null);
+    }
+  }
+}
+
+void
+Albany::Application::
+computeWorksetColors()
+{
+  const WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<Teuchos::ArrayRCP<LO> > > >::type&
+        wsElNodeEqID = disc->getWsElNodeEqID();
+  const int numWorksets = wsElNodeEqID.size();
+  // The workset connectivity changes with the mesh, possibly keeping the
+  // number of worksets
+  const int meshChangeCount = disc->getMeshChangeCount();
+  if (numWorksets == wsColorsNumWorksets &&
+      meshChangeCount == wsColorsMeshChangeCount) return;
+
+  // Worksets touching a given overlapped dof
+  const LO numLIDs = disc->getOverlapMapT()->getNodeNumElements();
+  std::vector<std::vector<int> > lidWorksets(numLIDs);
+  for (int ws = 0; ws < numWorksets; ++ws)
+    for (int cell = 0; cell < wsElNodeEqID[ws].size(); ++cell)
+      for (int node = 0; node < wsElNodeEqID[ws][cell].size(); ++node)
+        for (int eq = 0; eq < wsElNodeEqID[ws][cell][node].size(); ++eq) {
+          std::vector<int>& w = lidWorksets[wsElNodeEqID[ws][cell][node][eq]];
+          if (w.empty() || w.back() != ws) w.push_back(ws);
+        }
+
+  std::vector<std::set<int> > neighbors(numWorksets);
+  for (LO lid = 0; lid < numLIDs; ++lid)
+    for (int i = 0; i < lidWorksets[lid].size(); ++i)
+      for (int j = 0; j < lidWorksets[lid].size(); ++j)
+        if (i != j) neighbors[lidWorksets[lid][i]].insert(lidWorksets[lid][j]);
+
+  // Greedy coloring in workset order
+  std::vector<int> color(numWorksets, -1);
+  wsColors.clear();
+  for (int ws = 0; ws < numWorksets; ++ws) {
+    std::set<int> taken;
+    for (std::set<int>::const_iterator it = neighbors[ws].begin();
+         it != neighbors[ws].end(); ++it)
+      if (color[*it] >= 0) taken.insert(color[*it]);
+    int c = 0;
+    while (taken.count(c)) ++c;
+    color[ws] = c;
+    if (c == wsColors.size()) wsColors.push_back(Teuchos::Array<int>());
+    wsColors[c].push_back(ws);
+  }
+  wsColorsNumWorksets = numWorksets;
+  wsColorsMeshChangeCount = meshChangeCount;
+
+  *out << "Threaded fill: " << numWorksets << " worksets in "
+       << wsColors.size() << " colors on " << numFillThreads << " threads"
+       << std::endl;
+}
+
+void
+Albany::Application::
+setAssemblySample(const Teuchos::ArrayView<const int>& sampleLIDs)
+{
+  assemblySampleLIDs.assign(sampleLIDs.begin(), sampleLIDs.end());
+  assemblySampleMap = disc->getMapT();
+  wsAssembledNumWorksets = -1;
+  wsAssembledMeshChangeCount = -1;
+  updateAssemblySample();
+}
+
+void
+Albany::Application::
+updateAssemblySample()
+{
+  if (assemblySampleMap.is_null()) return;
+
+  const WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<Teuchos::ArrayRCP<LO> > > >::type&
+        wsElNodeEqID = disc->getWsElNodeEqID();
+  const int numWorksets = wsElNodeEqID.size();
+  const int meshChangeCount = disc->getMeshChangeCount();
+  if (numWorksets == wsAssembledNumWorksets &&
+      meshChangeCount == wsAssembledMeshChangeCount) return;
+
+  // The sample dofs are local indices: they only make sense on the map they
+  // were given for. Without them, all the rows are assembled again.
+  if (!disc->getMapT()->isSameAs(*assemblySampleMap)) {
+    *out << "Warning: the solution map changed; assembly is no longer "
+         << "restricted to the sample" << std::endl;
+    wsAssembled.clear();
+    assemblySampleLIDs.clear();
+    assemblySampleMap = Teuchos::null;
+    return;
+  }
+
+  // Mark the sample dofs and import the marks to the overlapped map: the
+  // worksets of other ranks also contribute to the sample rows.
+  Tpetra_Vector sampleT(disc->getMapT());
+  {
+    Teuchos::ArrayRCP<ST> sampleT_data = sampleT.get1dViewNonConst();
+    for (int i = 0; i < assemblySampleLIDs.size(); ++i)
+      sampleT_data[assemblySampleLIDs[i]] = 1.0;
+  }
+  Tpetra_Vector overlapped_sampleT(disc->getOverlapMapT());
+  overlapped_sampleT.doImport(sampleT, *solMgrT->get_importerT(), Tpetra::INSERT);
+  Teuchos::ArrayRCP<const ST> overlapped_sample = overlapped_sampleT.get1dView();
+
+  wsAssembled.assign(numWorksets, false);
+  wsAssembledNumWorksets = numWorksets;
+  wsAssembledMeshChangeCount = meshChangeCount;
+
+  int numAssembled = 0;
+  for (int ws = 0; ws < numWorksets; ++ws) {
+    bool touchesSample = false;
+    for (int cell = 0; cell < wsElNodeEqID[ws].size() && !touchesSample; ++cell)
+      for (int node = 0; node < wsElNodeEqID[ws][cell].size() && !touchesSample; ++node)
+        for (int eq = 0; eq < wsElNodeEqID[ws][cell][node].size(); ++eq)
+          if (overlapped_sample[wsElNodeEqID[ws][cell][node][eq]] != 0.0) {
+            touchesSample = true;
+            break;
+          }
+    wsAssembled[ws] = touchesSample;
+    if (touchesSample) ++numAssembled;
+  }
+
+  int localCounts[2] = {numAssembled, numWorksets}, globalCounts[2];
+  Teuchos::reduceAll<int, int>(*commT, Teuchos::REDUCE_SUM, 2, localCounts, globalCounts);
+  *out << "Assembly restricted to " << globalCounts[0] << " of "
+       << globalCounts[1] << " worksets" << std::endl;
+}
+
+bool
+Albany::Application::
+useThreadedFill(const Teuchos::Array<ParamVec>& p)
+{
+  if (numFillThreads == 1) return false;
+
+  // The performance probes are not thread safe
+  if (util::PerformanceContext::instance().enabled()) {
+    if (!threadedFillWarnedProbes) {
+      *out << "Warning: threaded fill disabled since performance monitoring "
+           << "is enabled; using the serial fill." << std::endl;
+      threadedFillWarnedProbes = true;
+    }
+    return false;
+  }
+
+  // Sacado parameters are attached to the evaluators in fm only; the thread
+  // copies would not see parameter updates.
+  for (int i = 0; i < p.size(); ++i)
+    if (p[i].size() > 0) {
+      if (!threadedFillWarnedParams) {
+        *out << "Warning: threaded fill disabled since the problem has "
+             << "Sacado parameters; using the serial fill." << std::endl;
+        threadedFillWarnedParams = true;
+      }
+      return false;
+    }
+  return true;
+}
+
+template <typename EvalT>
+void
+Albany::Application::
+evaluateWorksetsThreaded(const PHAL::Workset& workset)
+{
+  const WorksetArray<int>::type& wsPhysIndex = disc->getWsPhysIndex();
+
+  computeWorksetColors();
+
+  for (int c = 0; c < wsColors.size(); ++c) {
+    Teuchos::Array<int> wsList;
+    for (int i = 0; i < wsColors[c].size(); ++i)
+      if (isWorksetAssembled(wsColors[c][i])) wsList.push_back(wsColors[c][i]);
+    const int n = wsList.size();
+    if (n == 0) continue;
+    const int nt = std::min(numFillThreads, n);
+
+    // Load the worksets on this thread so that all RCP copies into the
+    // workset structs happen before the threads start.
+    std::vector<PHAL::Workset> worksets(n, workset);
+    for (int i = 0; i < n; ++i)
+      loadWorksetBucketInfo<EvalT>(worksets[i], wsList[i]);
+
+    const bool measureCost = disc->measuresWorksetCost();
+    std::vector<std::exception_ptr> errors(nt);
+    auto worker = [&](const int t) {
+      try {
+        Teuchos::ArrayRCP<Teuchos::RCP<PHX::FieldManager<PHAL::AlbanyTraits> > >&
+          tfm = (t == 0) ? fm : threadFm[t-1];
+        for (int i = t; i < n; i += nt) {
+          const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+          tfm[wsPhysIndex[wsList[i]]]->template evaluateFields<EvalT>(worksets[i]);
+          // Worksets of a color have distinct elements
+          if (measureCost) disc->addWorksetCost(wsList[i], secondsSince(start));
+        }
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < nt; ++t) threads.push_back(std::thread(worker, t));
+    worker(0);
+    for (int t = 0; t < threads.size(); ++t) threads[t].join();
+
+    for (int t = 0; t < nt; ++t)
+      if (errors[t]) std::rethrow_exception(errors[t]);
+  }
+
+  // Neumann evaluators are not replicated per thread
+  if (Teuchos::nonnull(nfm)) {
+    PHAL::Workset nworkset = workset;
+    for (int ws = 0; ws < wsPhysIndex.size(); ++ws) {
+      if (!isWorksetAssembled(ws)) continue;
+      loadWorksetBucketInfo<EvalT>(nworkset, ws);
+      deref_nfm(nfm, wsPhysIndex, ws)->template evaluateFields<EvalT>(nworkset);
+    }
+  }
+}
+
 void
 Albany::Application::
 computeGlobalResidualImplT(
@@ -1157,19 +1573,34 @@ computeGlobalResidualImplT(
                              paramLib->getRealValue<PHAL::AlbanyTraits::Residual>("Time") );
     workset.fT = overlapped_fT;
 
-    for (int ws=0; ws < numWorksets; ws++) {
-      loadWorksetBucketInfo<PHAL::AlbanyTraits::Residual>(workset, ws);
-
-      // FillType template argument used to specialize Sacado
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
-      if (nfm!=Teuchos::null)
-         deref_nfm(nfm, wsPhysIndex, ws)->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+    updateAssemblySample();
+    if (useThreadedFill(p)) {
+      evaluateWorksetsThreaded<PHAL::AlbanyTraits::Residual>(workset);
+    }
+    else {
+      const bool measureCost = disc->measuresWorksetCost();
+      for (int ws=0; ws < numWorksets; ws++) {
+        if (!isWorksetAssembled(ws)) continue;
+        loadWorksetBucketInfo<PHAL::AlbanyTraits::Residual>(workset, ws);
+        util::PerformanceGuard guard(residualProbes.evaluators, workset.numCells);
+
+        // FillType template argument used to specialize Sacado
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+        if (measureCost) disc->addWorksetCost(ws, secondsSince(start));
+        if (nfm!=Teuchos::null)
+           deref_nfm(nfm, wsPhysIndex, ws)->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+      }
     }
   // workset.wsElNodeEqID_kokkos =Kokkos:: View<int****, PHX::Device ("wsElNodeEqID_kokkos",workset. wsElNodeEqID.size(), workset. wsElNodeEqID[0].size(), workset. wsElNodeEqID[0][0].size());
   }
 
   // Assemble the residual into a non-overlapping vector
-  fT->doExport(*overlapped_fT, *exporterT, Tpetra::ADD);
+  {
+    util::PerformanceGuard guard(residualProbes.exporter, 0,
+                                 overlapped_fT->getLocalLength()*sizeof(ST));
+    fT->doExport(*overlapped_fT, *exporterT, Tpetra::ADD);
+  }
 
   //Allocate scaleVec_
   if (scaleVec_ == Teuchos::null && scale != 1.0) {
@@ -1227,6 +1658,7 @@ computeGlobalResidualImplT(
 #endif
 
     // FillType template argument used to specialize Sacado
+    util::PerformanceGuard guard(residualProbes.dirichlet);
     dfm->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
   }
 
@@ -1441,6 +1873,13 @@ computeGlobalJacobianImplT(const double alpha,
   if ( ! overlapped_jacT->isFillActive())
     overlapped_jacT->resumeFill();
 
+#else
+  if (scatter_jacobian_by_offsets) {
+    // Makes getLocalMatrix() valid; ScatterResidual writes into its values.
+    if (overlapped_jacT->isFillActive())
+      overlapped_jacT->fillComplete();
+    overlapped_jacT->resumeFill();
+  }
 #endif
 
   // Set data in Workset struct, and perform fill via field manager
@@ -1457,6 +1896,9 @@ computeGlobalJacobianImplT(const double alpha,
     workset.fT        = overlapped_fT;
     workset.JacT      = overlapped_jacT;
     loadWorksetJacobianInfo(workset, alpha, beta, omega);
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+    workset.scatter_by_offsets = scatter_jacobian_by_offsets;
+#endif
 
    //fill Jacobian derivative dimensions:
    for (int ps=0; ps < fm.size(); ps++){
@@ -1464,17 +1906,30 @@ computeGlobalJacobianImplT(const double alpha,
         PHAL::getDerivativeDimensions<PHAL::AlbanyTraits::Jacobian>(this, ps, explicit_scheme));
    }
 
-
-    for (int ws=0; ws < numWorksets; ws++) {
-      loadWorksetBucketInfo<PHAL::AlbanyTraits::Jacobian>(workset, ws);
-      // FillType template argument used to specialize Sacado
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
-      if (Teuchos::nonnull(nfm))
-        deref_nfm(nfm, wsPhysIndex, ws)->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+    updateAssemblySample();
+    if (useThreadedFill(p)) {
+      evaluateWorksetsThreaded<PHAL::AlbanyTraits::Jacobian>(workset);
+    }
+    else {
+      const bool measureCost = disc->measuresWorksetCost();
+      for (int ws=0; ws < numWorksets; ws++) {
+        if (!isWorksetAssembled(ws)) continue;
+        loadWorksetBucketInfo<PHAL::AlbanyTraits::Jacobian>(workset, ws);
+        util::PerformanceGuard guard(jacobianProbes.evaluators, workset.numCells);
+        // FillType template argument used to specialize Sacado
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+        if (measureCost) disc->addWorksetCost(ws, secondsSince(start));
+        if (Teuchos::nonnull(nfm))
+          deref_nfm(nfm, wsPhysIndex, ws)->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+      }
     }
   }
 
   { TEUCHOS_FUNC_TIME_MONITOR("> Albany Fill: Jacobian Export");
+  util::PerformanceGuard guard(jacobianProbes.exporter, 0,
+    ((Teuchos::nonnull(fT) ? overlapped_fT->getLocalLength() : 0) +
+     overlapped_jacT->getNodeNumEntries())*sizeof(ST));
   //Allocate and populate scaleVec_
   if (scaleVec_ == Teuchos::null && scale != 1.0) {
     scaleVec_ = Teuchos::rcp(new Tpetra_Vector(fT->getMap()));
@@ -1572,6 +2027,7 @@ computeGlobalJacobianImplT(const double alpha,
 #endif
 
     // FillType template argument used to specialize Sacado
+    util::PerformanceGuard guard(jacobianProbes.dirichlet);
     dfm->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
   }
   jacT->fillComplete();
@@ -2035,9 +2491,12 @@ for (unsigned int i=0; i<shapeParams.size(); i++) *out << shapeParams[i] << "  "
 
     workset.coord_deriv_indices = &coord_deriv_indices;
 
+    updateAssemblySample();
     for (int ws=0; ws < numWorksets; ws++) {
+      if (!isWorksetAssembled(ws)) continue;
       loadWorksetBucketInfo<PHAL::AlbanyTraits::Tangent>(workset, ws);
       workset.ws_coord_derivs = ws_coord_derivs[ws];
+      util::PerformanceGuard guard(tangentProbes.evaluators, workset.numCells);
 
       // FillType template argument used to specialize Sacado
       fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Tangent>(workset);
@@ -2054,6 +2513,12 @@ for (unsigned int i=0; i<shapeParams.size(); i++) *out << shapeParams[i] << "  "
 
   params = Teuchos::null;
 
+  {
+  util::PerformanceGuard guard(tangentProbes.exporter, 0,
+    ((Teuchos::nonnull(fT) ? overlapped_fT->getLocalLength() : 0) +
+     (Teuchos::nonnull(JVT) ? overlapped_JVT->getLocalLength()*overlapped_JVT->getNumVectors() : 0) +
+     (Teuchos::nonnull(fpT) ? overlapped_fpT->getLocalLength()*overlapped_fpT->getNumVectors() : 0))*sizeof(ST));
+
   // Assemble global residual
   if (Teuchos::nonnull(fT)) {
     fT->doExport(*overlapped_fT, *exporterT, Tpetra::ADD);
@@ -2066,6 +2531,7 @@ for (unsigned int i=0; i<shapeParams.size(); i++) *out << shapeParams[i] << "  "
   if (Teuchos::nonnull(fpT)) {
     fpT->doExport(*overlapped_fpT, *exporterT, Tpetra::ADD);
   }
+  }
 
   // Apply Dirichlet conditions using dfm (Dirchelt Field Manager)
   if (Teuchos::nonnull(dfm)) {
@@ -2100,6 +2566,7 @@ for (unsigned int i=0; i<shapeParams.size(); i++) *out << shapeParams[i] << "  "
 #endif
 
     // FillType template argument used to specialize Sacado
+    util::PerformanceGuard guard(tangentProbes.dirichlet);
     dfm->evaluateFields<PHAL::AlbanyTraits::Tangent>(workset);
   }
 }
@@ -2312,6 +2779,7 @@ applyGlobalDistParamDerivImplT(const double current_time,
     loadWorksetNodesetInfo(workset);
 
     // FillType template argument used to specialize Sacado
+    util::PerformanceGuard guard(distParamDerivProbes.dirichlet);
     dfm->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(workset);
   }
 
@@ -2346,6 +2814,7 @@ applyGlobalDistParamDerivImplT(const double current_time,
 
     for (int ws=0; ws < numWorksets; ws++) {
       loadWorksetBucketInfo<PHAL::AlbanyTraits::DistParamDeriv>(workset, ws);
+      util::PerformanceGuard guard(distParamDerivProbes.evaluators, workset.numCells);
 
       // FillType template argument used to specialize Sacado
       fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(workset);
@@ -2358,6 +2827,8 @@ applyGlobalDistParamDerivImplT(const double current_time,
   // nfm[0]->writeGraphvizFile<PHAL::AlbanyTraits::DistParamDeriv>(pg.str(),true,true);
 
   { TEUCHOS_FUNC_TIME_MONITOR("> Albany Fill: Distributed Parameter Derivative Export");
+  util::PerformanceGuard guard(distParamDerivProbes.exporter, 0,
+    overlapped_fpVT->getLocalLength()*overlapped_fpVT->getNumVectors()*sizeof(ST));
   // Assemble global df/dp*V
   if (trans) {
     Tpetra_MultiVector temp(*fpVT,Teuchos::Copy);
@@ -2393,6 +2864,7 @@ applyGlobalDistParamDerivImplT(const double current_time,
     loadWorksetNodesetInfo(workset);
 
     // FillType template argument used to specialize Sacado
+    util::PerformanceGuard guard(distParamDerivProbes.dirichlet);
     dfm->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(workset);
   }
 
@@ -3951,6 +4423,23 @@ evaluateStateFieldManagerT(
          xT.getVector(2).ptr(), *xT.getVector(0));
 }
 
+void
+Albany::Application::
+writeCheckpoint(const double time, const Tpetra_MultiVector& soln)
+{
+  if (checkpoint.is_null()) return;
+  // The first observation is the initial (or restarted) state; the step
+  // size read from a restart checkpoint is kept until the next one
+  if (checkpointCount > 0) checkpointStepSize = time - checkpointLastTime;
+  checkpointLastTime = time;
+  if (++checkpointCount % checkpointInterval != 0) return;
+
+  checkpoint->write(time, checkpointStepSize, soln, stateMgr);
+  if (commT->getRank() == 0)
+    *out << "Albany::Application::writeCheckpoint: writing time " << time
+         << " to " << checkpoint->manifestFileName() << std::endl;
+}
+
 void
 Albany::Application::
 evaluateStateFieldManagerT(
@@ -4098,6 +4587,9 @@ postRegSetup(std::string eval)
   if (eval=="Residual") {
     for (int ps=0; ps < fm.size(); ps++)
       fm[ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Residual>(eval);
+    for (int t=0; t < threadFm.size(); t++)
+      for (int ps=0; ps < threadFm[t].size(); ps++)
+        threadFm[t][ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Residual>(eval);
     if (dfm!=Teuchos::null)
       dfm->postRegistrationSetupForType<PHAL::AlbanyTraits::Residual>(eval);
     if (nfm!=Teuchos::null)
@@ -4111,6 +4603,10 @@ postRegSetup(std::string eval)
         PHAL::getDerivativeDimensions<PHAL::AlbanyTraits::Jacobian>(this, ps, explicit_scheme));
       fm[ps]->setKokkosExtendedDataTypeDimensions<PHAL::AlbanyTraits::Jacobian>(derivative_dimensions);
       fm[ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Jacobian>(eval);
+      for (int t=0; t < threadFm.size(); t++) {
+        threadFm[t][ps]->setKokkosExtendedDataTypeDimensions<PHAL::AlbanyTraits::Jacobian>(derivative_dimensions);
+        threadFm[t][ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Jacobian>(eval);
+      }
       if (nfm!=Teuchos::null && ps < nfm.size()) {
         nfm[ps]->setKokkosExtendedDataTypeDimensions<PHAL::AlbanyTraits::Jacobian>(derivative_dimensions);
         nfm[ps]->postRegistrationSetupForType<PHAL::AlbanyTraits::Jacobian>(eval);
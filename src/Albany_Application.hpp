@@ -28,11 +28,13 @@
 #include "Albany_AbstractProblem.hpp"
 #include "Albany_AbstractResponseFunction.hpp"
 #include "Albany_StateManager.hpp"
+#include "Albany_Checkpoint.hpp"
 #if defined(ALBANY_EPETRA)
 #include "AAdapt_AdaptiveSolutionManager.hpp"
 #endif
 #include "AAdapt_AdaptiveSolutionManagerT.hpp"
 #include "Albany_DiscretizationFactory.hpp"
+#include "utility/PerformanceProbe.hpp"
 
 #ifdef ALBANY_CUTR
   #include "CUTR_CubitMeshMover.hpp"
@@ -684,6 +686,19 @@ namespace Albany {
     //! Class to manage state variables (a.k.a. history)
     StateManager& getStateMgr() {return stateMgr; }
 
+    //! Write a binary checkpoint every "Checkpoint Write Interval" calls,
+    //! if "Checkpoint File Name" is set. Call after the states are updated.
+    void writeCheckpoint(const double time, const Tpetra_MultiVector& soln);
+
+    //! True if "Checkpoint File Name" is set
+    bool writesCheckpoints() const {return Teuchos::nonnull(checkpoint); }
+
+    //! True if the initial solution and states were read from a checkpoint
+    bool hasCheckpointRestart() const {return checkpointRestart; }
+
+    //! Time stored in the checkpoint the run restarted from
+    double checkpointRestartTime() const {return checkpointTime; }
+
 #if defined(ALBANY_EPETRA)
     //! Evaluate state field manager
     void evaluateStateFieldManager(const double current_time,
@@ -760,6 +775,23 @@ namespace Albany {
 
     void removeEpetraRelatedPLs(const Teuchos::RCP<Teuchos::ParameterList>& params);
 
+    //! Build the per-thread copies of the volumetric field managers
+    void buildThreadFieldManagers();
+
+    //! Color the worksets so that worksets of one color share no dofs
+    void computeWorksetColors();
+
+    //! Evaluate fm on all worksets, one color at a time, using
+    //! numFillThreads threads; nfm is evaluated serially afterwards
+    template <typename EvalT>
+    void evaluateWorksetsThreaded(const PHAL::Workset& workset);
+
+    //! True if the threaded fill can be used with parameters p
+    bool useThreadedFill(const Teuchos::Array<ParamVec>& p);
+
+    //! Bring wsAssembled up to date with the current mesh
+    void updateAssemblySample();
+
   public:
 
 
@@ -904,6 +936,14 @@ namespace Albany {
 
     void postRegSetup(std::string eval);
 
+    //! Restrict the residual, Jacobian and tangent fills to the worksets
+    //! touching the given owned dofs (local indices in the solution map),
+    //! e.g. the sample dofs of a hyper-reduced model. Only the rows of these
+    //! dofs are assembled completely; the other rows are left partial.
+    //! The workset mask is rebuilt when the mesh changes on the same solution
+    //! map, and dropped (full assembly) when the map changes.
+    void setAssemblySample(const Teuchos::ArrayView<const int>& sampleLIDs);
+
 #ifdef ALBANY_MOR
 #if defined(ALBANY_EPETRA)
     Teuchos::RCP<MORFacade> getMorFacade();
@@ -1066,6 +1106,20 @@ namespace Albany {
     //! Reference configuration (update) manager
     Teuchos::RCP<AAdapt::rc::Manager> rc_mgr;
 
+    //! Binary checkpoint written by writeCheckpoint
+    Teuchos::RCP<Checkpoint> checkpoint;
+    int checkpointInterval;
+    int checkpointCount;
+
+    //! Restart from a binary checkpoint
+    bool checkpointRestart;
+    double checkpointTime;
+
+    //! Step size stored with (or read from) the checkpoint, and the time of
+    //! the last observation it is measured from
+    double checkpointStepSize;
+    double checkpointLastTime;
+
     //! Response functions
     Teuchos::Array< Teuchos::RCP<Albany::AbstractResponseFunction> > responses;
 
@@ -1081,6 +1135,49 @@ namespace Albany {
     //! Phalanx Field Manager for states
     Teuchos::Array< Teuchos::RCP<PHX::FieldManager<PHAL::AlbanyTraits> > > sfm;
 
+    //! Number of threads evaluating worksets concurrently (1 = serial fill)
+    int numFillThreads;
+
+    //! The reasons for falling back to the serial fill are reported once
+    bool threadedFillWarnedProbes;
+    bool threadedFillWarnedParams;
+
+    //! Copies of fm for threads 1..numFillThreads-1 (thread 0 uses fm)
+    Teuchos::Array< Teuchos::ArrayRCP<Teuchos::RCP<PHX::FieldManager<PHAL::AlbanyTraits> > > > threadFm;
+
+    //! Worksets grouped by color; worksets of one color touch disjoint dofs
+    Teuchos::Array< Teuchos::Array<int> > wsColors;
+    int wsColorsNumWorksets;
+    int wsColorsMeshChangeCount;
+
+    //! Worksets assembled by the fills (see setAssemblySample); empty = all
+    std::vector<bool> wsAssembled;
+    int wsAssembledNumWorksets;
+    int wsAssembledMeshChangeCount;
+
+    //! Sample dofs of setAssemblySample and the solution map they index
+    Teuchos::Array<int> assemblySampleLIDs;
+    Teuchos::RCP<const Tpetra_Map> assemblySampleMap;
+
+    //! Instrumentation of the fill of one evaluation type: the volume and
+    //! Neumann field managers, the export and the Dirichlet field manager
+    struct FillProbes {
+      explicit FillProbes(const std::string& evalName) :
+        evaluators("Albany Fill: " + evalName + ": Evaluators"),
+        exporter("Albany Fill: " + evalName + ": Export"),
+        dirichlet("Albany Fill: " + evalName + ": Dirichlet") {}
+      util::PerformanceProbe evaluators;
+      util::PerformanceProbe exporter;
+      util::PerformanceProbe dirichlet;
+    };
+    FillProbes residualProbes;
+    FillProbes jacobianProbes;
+    FillProbes tangentProbes;
+    FillProbes distParamDerivProbes;
+
+    bool isWorksetAssembled(const int ws) const
+      { return wsAssembled.empty() || wsAssembled[ws]; }
+
 #ifdef ALBANY_STOKHOS
     //! Stochastic Galerkin basis
     Teuchos::RCP<const Stokhos::OrthogPolyBasis<int,double> > sg_basis;
@@ -1184,6 +1281,10 @@ namespace Albany {
     bool morphFromInit;
     bool ignore_residual_in_jacobian;
 
+    //! Scatter the Jacobian through precomputed CSR offsets into the local
+    //! matrix of overlapped_jacT rather than per-entry sumIntoLocalValues
+    bool scatter_jacobian_by_offsets;
+
     //! To prevent a singular mass matrix associated with Dirichlet
     //  conditions, optionally add a small perturbation to the diag
     double perturbBetaForDirichlets;
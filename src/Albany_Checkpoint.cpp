@@ -0,0 +1,349 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_Checkpoint.hpp"
+#include "Albany_StateManager.hpp"
+
+#include "Teuchos_CommHelpers.hpp"
+#include "Teuchos_TestForException.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+const char checkpointMagic[8] = {'A','L','B','C','K','P','T','\0'};
+const char manifestMagic[8] = {'A','L','B','C','K','P','M','\0'};
+const int checkpointVersion = 2;
+
+// Relative tolerance of the comparison of the rebuilt mesh coordinates
+const double coordinateTolerance = 1.0e-12;
+
+// Stream buffer size: the blocks are written and read sequentially
+const std::size_t checkpointBufferSize = 8*1024*1024;
+
+template<typename T>
+void writeValue(std::ofstream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T readValue(std::ifstream& is)
+{
+  T value;
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+void writeBlock(std::ofstream& os, const std::string& name,
+                const double* data, const std::size_t size)
+{
+  writeValue<std::uint64_t>(os, name.size());
+  os.write(name.data(), name.size());
+  writeValue<std::uint64_t>(os, size);
+  if (size > 0)
+    os.write(reinterpret_cast<const char*>(data), size*sizeof(double));
+}
+
+// Read the name and the size of the next block, checking that it is name
+std::uint64_t readBlockHeader(std::ifstream& is, const std::string& name)
+{
+  const std::uint64_t nameLength = readValue<std::uint64_t>(is);
+  TEUCHOS_TEST_FOR_EXCEPTION(!is || nameLength > 4096, std::runtime_error,
+      "Error: checkpoint ends or is corrupt before block " << name << std::endl);
+  std::string fileName(nameLength, ' ');
+  if (nameLength > 0) is.read(&fileName[0], nameLength);
+  const std::uint64_t fileSize = readValue<std::uint64_t>(is);
+
+  TEUCHOS_TEST_FOR_EXCEPTION(!is, std::runtime_error,
+      "Error: checkpoint ends before block " << name << std::endl);
+  TEUCHOS_TEST_FOR_EXCEPTION(fileName != name, std::runtime_error,
+      "Error: checkpoint block " << fileName << " found, expected " << name << std::endl);
+  return fileSize;
+}
+
+// Read the next block into data, checking that it is the expected one
+void readBlock(std::ifstream& is, const std::string& name,
+               double* data, const std::size_t size)
+{
+  const std::uint64_t fileSize = readBlockHeader(is, name);
+  TEUCHOS_TEST_FOR_EXCEPTION(fileSize != size, std::runtime_error,
+      "Error: checkpoint block " << name << " (" << fileSize << " values) does not match "
+      << "the " << size << " values of this run" << std::endl);
+
+  if (size > 0)
+    is.read(reinterpret_cast<char*>(data), size*sizeof(double));
+  TEUCHOS_TEST_FOR_EXCEPTION(!is, std::runtime_error,
+      "Error: checkpoint ends inside block " << name << std::endl);
+}
+
+// Read the next block into a new array
+std::vector<double> readBlock(std::ifstream& is, const std::string& name)
+{
+  std::vector<double> data(readBlockHeader(is, name));
+  if (!data.empty())
+    is.read(reinterpret_cast<char*>(data.data()), data.size()*sizeof(double));
+  TEUCHOS_TEST_FOR_EXCEPTION(!is, std::runtime_error,
+      "Error: checkpoint ends inside block " << name << std::endl);
+  return data;
+}
+
+void addStateBlocks(const std::string& prefix, Albany::StateArrays& sa,
+                    std::vector<std::pair<std::string, Albany::MDArray*> >& arrays)
+{
+  for (std::size_t ws = 0; ws < sa.elemStateArrays.size(); ++ws)
+    for (auto& it : sa.elemStateArrays[ws]) {
+      std::ostringstream name;
+      name << prefix << "elem/" << ws << "/" << it.first;
+      arrays.push_back(std::make_pair(name.str(), &it.second));
+    }
+  for (std::size_t ws = 0; ws < sa.nodeStateArrays.size(); ++ws)
+    for (auto& it : sa.nodeStateArrays[ws]) {
+      std::ostringstream name;
+      name << prefix << "node/" << ws << "/" << it.first;
+      arrays.push_back(std::make_pair(name.str(), &it.second));
+    }
+}
+
+// Throw on every rank if the operation failed on any rank
+void checkAllRanks(const Teuchos_Comm& comm, const std::string& error,
+                   const std::string& what)
+{
+  const int localOk = error.empty() ? 1 : 0;
+  int globalOk = 0;
+  Teuchos::reduceAll<int, int>(comm, Teuchos::REDUCE_MIN, localOk, Teuchos::outArg(globalOk));
+  TEUCHOS_TEST_FOR_EXCEPTION(!localOk, std::runtime_error, error);
+  TEUCHOS_TEST_FOR_EXCEPTION(!globalOk, std::runtime_error,
+      "Error: " << what << " failed on another rank" << std::endl);
+}
+
+} // namespace
+
+Albany::Checkpoint::
+Checkpoint(const std::string& fileName_,
+           const Teuchos::RCP<const Teuchos_Comm>& commT_) :
+  fileName(fileName_),
+  commT(commT_),
+  generation(-1)
+{
+}
+
+std::string
+Albany::Checkpoint::manifestFileName() const
+{
+  std::ostringstream name;
+  name << fileName << "." << commT->getSize();
+  return name.str();
+}
+
+std::string
+Albany::Checkpoint::rankFileName(const int slot) const
+{
+  std::ostringstream name;
+  name << fileName << "." << slot << "." << commT->getSize() << "." << commT->getRank();
+  return name.str();
+}
+
+std::uint64_t
+Albany::Checkpoint::readManifest() const
+{
+  const std::string name = manifestFileName();
+
+  std::string error;
+  long long value = 0;
+  if (commT->getRank() == 0) {
+    std::ifstream is(name.c_str(), std::ios::binary);
+    if (is) {
+      char magic[sizeof(manifestMagic)];
+      is.read(magic, sizeof(magic));
+      const std::int32_t numRanks = readValue<std::int32_t>(is);
+      value = readValue<std::uint64_t>(is);
+      if (!is || std::memcmp(magic, manifestMagic, sizeof(magic)) != 0)
+        error = "Error: " + name + " is not a checkpoint manifest\n";
+      else if (numRanks != commT->getSize())
+        error = "Error: checkpoint manifest " + name + " was written by another number of ranks\n";
+    }
+  }
+  checkAllRanks(*commT, error, "reading the checkpoint manifest");
+  Teuchos::broadcast<int, long long>(*commT, 0, Teuchos::outArg(value));
+  return value;
+}
+
+std::vector<Albany::Checkpoint::Block>
+Albany::Checkpoint::getStateBlocks(StateManager& stateMgr) const
+{
+  std::vector<std::pair<std::string, MDArray*> > arrays;
+  addStateBlocks("", stateMgr.getStateArrays(), arrays);
+
+  const Teuchos::RCP<AbstractDiscretization> disc = stateMgr.getDiscretization();
+  for (auto& it : disc->getSideSetDiscretizations())
+    addStateBlocks("sideset/" + it.first + "/", it.second->getStateArrays(), arrays);
+
+  std::vector<Block> blocks(arrays.size());
+  for (std::size_t i = 0; i < arrays.size(); ++i) {
+    blocks[i].name = arrays[i].first;
+    blocks[i].size = arrays[i].second->size();
+    blocks[i].data = blocks[i].size > 0 ? arrays[i].second->contiguous_data() : NULL;
+  }
+  return blocks;
+}
+
+void
+Albany::Checkpoint::write(const double time,
+                          const double stepSize,
+                          const Tpetra_MultiVector& soln,
+                          StateManager& stateMgr) const
+{
+  // Never overwrite the slot of the checkpoint the manifest names, also
+  // if it was left by a previous run
+  if (generation < 0)
+    generation = readManifest();
+  const std::uint64_t next = generation + 1;
+
+  const std::vector<Block> blocks = getStateBlocks(stateMgr);
+  const Teuchos::ArrayRCP<double>& coords = stateMgr.getDiscretization()->getCoordinates();
+  const std::string name = rankFileName(next % 2);
+
+  std::string error;
+  {
+    std::vector<char> buffer(checkpointBufferSize);
+    std::ofstream os;
+    os.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    os.open(name.c_str(), std::ios::binary | std::ios::trunc);
+
+    os.write(checkpointMagic, sizeof(checkpointMagic));
+    writeValue<std::int32_t>(os, checkpointVersion);
+    writeValue<std::int32_t>(os, commT->getSize());
+    writeValue<std::int32_t>(os, commT->getRank());
+    writeValue<std::uint64_t>(os, next);
+    writeValue<double>(os, time);
+    writeValue<double>(os, stepSize);
+    writeValue<std::uint64_t>(os, 1 + soln.getNumVectors() + blocks.size());
+
+    writeBlock(os, "mesh/coordinates", coords.getRawPtr(), coords.size());
+    for (std::size_t j = 0; j < soln.getNumVectors(); ++j) {
+      std::ostringstream vecName;
+      vecName << "solution/" << j;
+      Teuchos::ArrayRCP<const ST> data = soln.getData(j);
+      writeBlock(os, vecName.str(), data.getRawPtr(), soln.getLocalLength());
+    }
+    for (auto& block : blocks)
+      writeBlock(os, block.name, block.data, block.size);
+
+    os.close();
+    if (!os)
+      error = "Error: could not write checkpoint file " + name + "\n";
+  }
+  checkAllRanks(*commT, error, "writing the checkpoint");
+
+  // Every rank has a complete file: commit the new generation
+  if (commT->getRank() == 0) {
+    const std::string manifest = manifestFileName();
+    const std::string tmpName = manifest + ".tmp";
+    std::ofstream os(tmpName.c_str(), std::ios::binary | std::ios::trunc);
+    os.write(manifestMagic, sizeof(manifestMagic));
+    writeValue<std::int32_t>(os, commT->getSize());
+    writeValue<std::uint64_t>(os, next);
+    os.close();
+    if (!os)
+      error = "Error: could not write checkpoint manifest " + tmpName + "\n";
+    else if (std::rename(tmpName.c_str(), manifest.c_str()) != 0)
+      error = "Error: could not rename " + tmpName + " to " + manifest + "\n";
+  }
+  checkAllRanks(*commT, error, "committing the checkpoint");
+
+  generation = next;
+}
+
+void
+Albany::Checkpoint::read(Tpetra_MultiVector& soln,
+                         StateManager& stateMgr,
+                         double& time,
+                         double& stepSize) const
+{
+  const std::uint64_t current = readManifest();
+  TEUCHOS_TEST_FOR_EXCEPTION(current == 0, std::runtime_error,
+      "Error: no checkpoint manifest " << manifestFileName() << std::endl);
+
+  const std::vector<Block> blocks = getStateBlocks(stateMgr);
+  const Teuchos::ArrayRCP<double>& coords = stateMgr.getDiscretization()->getCoordinates();
+  const std::string name = rankFileName(current % 2);
+
+  std::string error;
+  double values[2] = {0.0, 0.0};
+  try {
+    std::vector<char> buffer(checkpointBufferSize);
+    std::ifstream is;
+    is.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    is.open(name.c_str(), std::ios::binary);
+    TEUCHOS_TEST_FOR_EXCEPTION(!is, std::runtime_error,
+        "Error: could not open checkpoint file " << name << std::endl);
+
+    char magic[sizeof(checkpointMagic)];
+    is.read(magic, sizeof(magic));
+    const std::int32_t version = readValue<std::int32_t>(is);
+
+    TEUCHOS_TEST_FOR_EXCEPTION(!is || std::memcmp(magic, checkpointMagic, sizeof(magic)) != 0,
+        std::runtime_error, "Error: " << name << " is not a checkpoint file" << std::endl);
+    TEUCHOS_TEST_FOR_EXCEPTION(version != checkpointVersion, std::runtime_error,
+        "Error: checkpoint " << name << " has version " << version
+        << ", expected " << checkpointVersion << std::endl);
+
+    const std::int32_t numRanks = readValue<std::int32_t>(is);
+    const std::int32_t rank = readValue<std::int32_t>(is);
+    const std::uint64_t fileGeneration = readValue<std::uint64_t>(is);
+    values[0] = readValue<double>(is);
+    values[1] = readValue<double>(is);
+    const std::uint64_t numBlocks = readValue<std::uint64_t>(is);
+    const std::size_t expectedBlocks = 1 + soln.getNumVectors() + blocks.size();
+
+    TEUCHOS_TEST_FOR_EXCEPTION(!is, std::runtime_error,
+        "Error: checkpoint " << name << " ends inside its header" << std::endl);
+    TEUCHOS_TEST_FOR_EXCEPTION(numRanks != commT->getSize() || rank != commT->getRank(),
+        std::runtime_error, "Error: checkpoint " << name << " was written by rank " << rank
+        << " of " << numRanks << std::endl);
+    TEUCHOS_TEST_FOR_EXCEPTION(fileGeneration != current, std::runtime_error,
+        "Error: checkpoint " << name << " has generation " << fileGeneration
+        << ", the manifest names " << current << std::endl);
+    TEUCHOS_TEST_FOR_EXCEPTION(numBlocks != expectedBlocks,
+        std::runtime_error, "Error: checkpoint " << name << " has " << numBlocks
+        << " blocks, this run expects " << expectedBlocks << std::endl);
+
+    // The mesh is rebuilt from the input of this run; it has to be the
+    // one the checkpoint was written on
+    const std::vector<double> fileCoords = readBlock(is, "mesh/coordinates");
+    TEUCHOS_TEST_FOR_EXCEPTION(fileCoords.size() != static_cast<std::size_t>(coords.size()),
+        std::runtime_error, "Error: checkpoint " << name << " has " << fileCoords.size()
+        << " node coordinates, the mesh of this run has " << coords.size() << std::endl);
+    for (std::size_t i = 0; i < fileCoords.size(); ++i)
+      TEUCHOS_TEST_FOR_EXCEPTION(std::abs(fileCoords[i] - coords[i]) >
+          coordinateTolerance*(1.0 + std::abs(fileCoords[i])), std::runtime_error,
+          "Error: the mesh of this run differs from the mesh of checkpoint " << name
+          << " at coordinate " << i << std::endl);
+
+    for (std::size_t j = 0; j < soln.getNumVectors(); ++j) {
+      std::ostringstream vecName;
+      vecName << "solution/" << j;
+      Teuchos::ArrayRCP<ST> data = soln.getDataNonConst(j);
+      readBlock(is, vecName.str(), data.getRawPtr(), soln.getLocalLength());
+    }
+    for (auto& block : blocks)
+      readBlock(is, block.name, block.data, block.size);
+  }
+  catch (const std::exception& e) {
+    error = e.what();
+  }
+  checkAllRanks(*commT, error, "reading the checkpoint");
+
+  time = values[0];
+  stepSize = values[1];
+}
@@ -0,0 +1,88 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_CHECKPOINT_HPP
+#define ALBANY_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Albany_DataTypes.hpp"
+
+namespace Albany {
+
+class StateManager;
+
+/** \brief Binary checkpoint of the solution and of all state arrays
+
+    Each rank writes its owned solution vectors (solution and time
+    derivatives), every element and node state array of the StateManager
+    (including the "_old" states and the side set states), its node
+    coordinates, the time and the last step size to its own file
+    "<name>.<slot>.<nranks>.<rank>" as contiguous blocks, with no field
+    translation. The two slots are written alternately. Once every rank has
+    a complete file, rank 0 atomically replaces the manifest
+    "<name>.<nranks>", which names the generation of the checkpoint; an
+    interrupted write on any rank therefore keeps the previous checkpoint.
+
+    A checkpoint can only be read back by a run with the same number of
+    ranks and the same discretization and state registration; read()
+    throws on all ranks on any mismatch of the block names or sizes, or if
+    the mesh rebuilt by this run is not the one that was checkpointed.
+*/
+class Checkpoint {
+public:
+
+  Checkpoint(const std::string& fileName,
+             const Teuchos::RCP<const Teuchos_Comm>& commT);
+
+  //! Write soln (non-overlapped), the states of stateMgr, time and the
+  //! step size that led to it
+  void write(const double time,
+             const double stepSize,
+             const Tpetra_MultiVector& soln,
+             StateManager& stateMgr) const;
+
+  //! Restore soln and the states of stateMgr, and the checkpoint time
+  //! and step size
+  void read(Tpetra_MultiVector& soln,
+            StateManager& stateMgr,
+            double& time,
+            double& stepSize) const;
+
+  //! Name of the manifest naming the current generation
+  std::string manifestFileName() const;
+
+  //! Name of the file of this rank in slot (0 or 1)
+  std::string rankFileName(const int slot) const;
+
+private:
+
+  struct Block {
+    std::string name;
+    double* data;
+    std::size_t size;
+  };
+
+  //! The state arrays of the discretization and of its side sets, in a
+  //! fixed order
+  std::vector<Block> getStateBlocks(StateManager& stateMgr) const;
+
+  //! Generation named by the manifest on rank 0, broadcast; 0 if none
+  std::uint64_t readManifest() const;
+
+  std::string fileName;
+  Teuchos::RCP<const Teuchos_Comm> commT;
+
+  //! Generation of the last checkpoint; -1 until the manifest is read
+  mutable std::int64_t generation;
+};
+
+} // namespace Albany
+
+#endif // ALBANY_CHECKPOINT_HPP
@@ -23,6 +23,7 @@
 #include "Sacado_ELRFad_DFad.hpp"
 #include "Sacado_ELRCacheFad_DFad.hpp"
 #include "Sacado_Fad_DFad.hpp"
+#include "Sacado_Fad_SFad.hpp"
 #include "Sacado_Fad_SLFad.hpp"
 #include "Sacado_ELRFad_SLFad.hpp"
 #include "Sacado_ELRFad_SFad.hpp"
@@ -68,6 +69,17 @@ typedef Sacado::MP::Vector<MPStorageType> MPType;
   typedef Sacado::Fad::SLFad<RealType, ALBANY_SLFAD_SIZE> FadType;
   typedef Sacado::Fad::SLFad<SGType, ALBANY_SLFAD_SIZE> SGFadType;
   typedef Sacado::Fad::SLFad<MPType, ALBANY_SLFAD_SIZE> MPFadType;
+#elif defined(ALBANY_STATIC_FAD)
+  // Fixed-size derivative arrays: no heap allocation per Fad value. An SFad
+  // always has ALBANY_STATIC_FAD_SIZE derivative components, so this only
+  // fits meshes whose element blocks all have that derivative dimension
+  // (checked in PHAL::getDerivativeDimensions).
+#define ALBANY_FADTYPE_NOTEQUAL_TANFADTYPE
+  typedef Sacado::Fad::SFad<RealType, ALBANY_STATIC_FAD_SIZE> FadType;
+#ifdef ALBANY_STOKHOS
+  typedef Sacado::Fad::SFad<SGType, ALBANY_STATIC_FAD_SIZE> SGFadType;
+  typedef Sacado::Fad::SFad<MPType, ALBANY_STATIC_FAD_SIZE> MPFadType;
+#endif
 #else
 #define ALBANY_SFAD_SIZE 300
   typedef Sacado::Fad::DFad<RealType> FadType;
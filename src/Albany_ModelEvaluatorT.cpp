@@ -23,7 +23,10 @@
 Albany::ModelEvaluatorT::ModelEvaluatorT(
     const Teuchos::RCP<Albany::Application>& app_,
     const Teuchos::RCP<Teuchos::ParameterList>& appParams)
-: app(app_), supports_xdot(false), supports_xdotdot(false)
+: app(app_), supports_xdot(false), supports_xdotdot(false),
+  reuse_residual(false), cache_residual_in_jacobian(false),
+  residual_cache_valid(false), cached_time(0.0), cached_num_state_updates(0),
+  cached_mesh_change_count(0)
 {
 
   Teuchos::RCP<Teuchos::FancyOStream> out =
@@ -209,6 +212,107 @@ Albany::ModelEvaluatorT::ModelEvaluatorT(
 
   timer = Teuchos::TimeMonitor::getNewTimer("Albany: **Total Fill Time**");
 
+  // Residual reuse, off unless requested: the cache key is the state, the
+  // parameters and the mesh, so inputs set from outside (e.g. MPAS fields)
+  // are not seen, and a cached residual skips the state and response
+  // evaluators of the residual fill. Scaling makes the residual depend on
+  // the Jacobian diagonal, and distributed parameters are not part of the
+  // cache key.
+  reuse_residual = problemParams.get("Reuse Residual", false);
+  cache_residual_in_jacobian =
+    problemParams.get("Cache Residual In Jacobian", false);
+  Teuchos::ParameterList& scalingParams = appParams->sublist("Scaling");
+  const bool scaled = scalingParams.get("Scale", 1.0) != 1.0 ||
+    scalingParams.get("Scale BC Dofs", false) ||
+    scalingParams.get<std::string>("Type", "Constant") != "Constant";
+  if ((reuse_residual || cache_residual_in_jacobian) &&
+      (scaled || num_dist_param_vecs > 0 ||
+       problemParams.get("Ignore Residual In Jacobian", false))) {
+    *out << "Warning: residual reuse is disabled with scaling, distributed "
+         << "parameters or \"Ignore Residual In Jacobian\"" << std::endl;
+    reuse_residual = false;
+    cache_residual_in_jacobian = false;
+  }
+  if (cache_residual_in_jacobian) reuse_residual = true;
+}
+
+namespace {
+// True if a and b are both null or have identical entries on all ranks
+bool sameVector(
+    const Teuchos::RCP<const Tpetra_Vector>& a,
+    const Teuchos::RCP<const Tpetra_Vector>& b,
+    Tpetra_Vector& work)
+{
+  if (Teuchos::is_null(a) || Teuchos::is_null(b))
+    return Teuchos::is_null(a) && Teuchos::is_null(b);
+  work.update(1.0, *a, -1.0, *b, 0.0);
+  return work.normInf() == 0.0;
+}
+
+void copyVector(
+    const Teuchos::RCP<const Tpetra_Vector>& src,
+    Teuchos::RCP<Tpetra_Vector>& dst)
+{
+  if (Teuchos::is_null(src))
+    dst = Teuchos::null;
+  else if (Teuchos::is_null(dst))
+    dst = Teuchos::rcp(new Tpetra_Vector(*src, Teuchos::Copy));
+  else
+    dst->update(1.0, *src, 0.0);
+}
+}
+
+bool
+Albany::ModelEvaluatorT::residualCacheMatches(
+    const Teuchos::RCP<const Tpetra_Vector>& xT,
+    const Teuchos::RCP<const Tpetra_Vector>& x_dotT,
+    const Teuchos::RCP<const Tpetra_Vector>& x_dotdotT,
+    const double curr_time) const
+{
+  if (!residual_cache_valid || curr_time != cached_time ||
+      app->getStateMgr().getNumStateUpdates() != cached_num_state_updates ||
+      app->getDiscretization()->getMeshChangeCount() != cached_mesh_change_count)
+    return false;
+
+#if defined(ALBANY_LCM)
+  // Schwarz boundary conditions read the coupled applications' solutions
+  if (app->getApplications().size() > 0)
+    return false;
+#endif
+
+  int k = 0;
+  for (int l = 0; l < sacado_param_vec.size(); ++l)
+    for (unsigned int i = 0; i < sacado_param_vec[l].size(); ++i, ++k)
+      if (k >= cached_params.size() ||
+          sacado_param_vec[l][i].baseValue != cached_params[k])
+        return false;
+  if (k != cached_params.size()) return false;
+
+  if (Teuchos::is_null(cache_workT))
+    cache_workT = Teuchos::rcp(new Tpetra_Vector(xT->getMap()));
+  return sameVector(xT, cached_xT, *cache_workT) &&
+         sameVector(x_dotT, cached_x_dotT, *cache_workT) &&
+         sameVector(x_dotdotT, cached_x_dotdotT, *cache_workT);
+}
+
+void
+Albany::ModelEvaluatorT::setResidualCacheState(
+    const Teuchos::RCP<const Tpetra_Vector>& xT,
+    const Teuchos::RCP<const Tpetra_Vector>& x_dotT,
+    const Teuchos::RCP<const Tpetra_Vector>& x_dotdotT,
+    const double curr_time) const
+{
+  copyVector(xT, cached_xT);
+  copyVector(x_dotT, cached_x_dotT);
+  copyVector(x_dotdotT, cached_x_dotdotT);
+  cached_time = curr_time;
+  cached_num_state_updates = app->getStateMgr().getNumStateUpdates();
+  cached_mesh_change_count = app->getDiscretization()->getMeshChangeCount();
+  cached_params.clear();
+  for (int l = 0; l < sacado_param_vec.size(); ++l)
+    for (unsigned int i = 0; i < sacado_param_vec[l].size(); ++i)
+      cached_params.push_back(sacado_param_vec[l][i].baseValue);
+  residual_cache_valid = true;
 }
 
 void
@@ -247,6 +351,10 @@ Albany::ModelEvaluatorT::allocateVectors()
       else
         this->xDotDot = Teuchos::null;
 
+      // The maps may have changed (e.g., after adaptation)
+      residual_cache_valid = false;
+      cached_fT = Teuchos::null;
+      cached_xT = cached_x_dotT = cached_x_dotdotT = cache_workT = Teuchos::null;
 }
 
 
@@ -625,12 +733,34 @@ Albany::ModelEvaluatorT::evalModelImpl(
   //
   bool f_already_computed = false;
 
+  // f from the residual cache
+  if (reuse_residual && Teuchos::nonnull(fT_out) &&
+      Teuchos::is_null(W_op_out_crsT) && !app->is_adjoint &&
+      residualCacheMatches(xT, x_dotT, x_dotdotT, curr_time)) {
+    fT_out->update(1.0, *cached_fT, 0.0);
+    f_already_computed = true;
+  }
+
   // W matrix
   if (Teuchos::nonnull(W_op_out_crsT)) {
+    // Let the Jacobian fill produce the residual for later residual requests
+    // at the same state
+    Tpetra_Vector* fT_jac = fT_out.get();
+    if (Teuchos::is_null(fT_out) && cache_residual_in_jacobian) {
+      if (Teuchos::is_null(cached_fT))
+        cached_fT = Teuchos::rcp(new Tpetra_Vector(app->getMapT()));
+      fT_jac = cached_fT.get();
+    }
     app->computeGlobalJacobianT(
         alpha, beta, omega, curr_time, x_dotT.get(), x_dotdotT.get(),  *xT,
-        sacado_param_vec, fT_out.get(), *W_op_out_crsT);
+        sacado_param_vec, fT_jac, *W_op_out_crsT);
     f_already_computed = true;
+    if (reuse_residual) {
+      if (fT_jac == fT_out.get() && Teuchos::nonnull(fT_out))
+        copyVector(fT_out, cached_fT);
+      if (fT_jac != NULL)
+        setResidualCacheState(xT, x_dotT, x_dotdotT, curr_time);
+    }
 #ifdef WRITE_MASS_MATRIX_TO_MM_FILE
     //IK, 4/24/15: write mass matrix to matrix market file
     //Warning: to read this in to MATLAB correctly, code must be run in serial.
@@ -685,6 +815,10 @@ Albany::ModelEvaluatorT::evalModelImpl(
       app->computeGlobalResidualT(
           curr_time, x_dotT.get(), x_dotdotT.get(), *xT,
           sacado_param_vec, *fT_out);
+      if (reuse_residual) {
+        copyVector(fT_out, cached_fT);
+        setResidualCacheState(xT, x_dotT, x_dotdotT, curr_time);
+      }
     }
   }
 
@@ -144,6 +144,36 @@ private:
   //! Model uses time integration (accelerations)
   bool supports_xdotdot;
 
+  //! Serve residual requests at an already evaluated state from a cache
+  bool reuse_residual;
+
+  //! Compute and cache the residual during Jacobian fills that do not request it
+  bool cache_residual_in_jacobian;
+
+  //! True if cached_fT holds the residual at the given state
+  bool residualCacheMatches(
+      const Teuchos::RCP<const Tpetra_Vector>& xT,
+      const Teuchos::RCP<const Tpetra_Vector>& x_dotT,
+      const Teuchos::RCP<const Tpetra_Vector>& x_dotdotT,
+      const double curr_time) const;
+
+  //! Record the state at which cached_fT was computed
+  void setResidualCacheState(
+      const Teuchos::RCP<const Tpetra_Vector>& xT,
+      const Teuchos::RCP<const Tpetra_Vector>& x_dotT,
+      const Teuchos::RCP<const Tpetra_Vector>& x_dotdotT,
+      const double curr_time) const;
+
+  //! Residual cache and the state it was computed at
+  mutable bool residual_cache_valid;
+  mutable Teuchos::RCP<Tpetra_Vector> cached_fT;
+  mutable Teuchos::RCP<Tpetra_Vector> cached_xT, cached_x_dotT, cached_x_dotdotT;
+  mutable Teuchos::RCP<Tpetra_Vector> cache_workT;
+  mutable double cached_time;
+  mutable Teuchos::Array<ST> cached_params;
+  mutable int cached_num_state_updates;
+  mutable int cached_mesh_change_count;
+
 };
 
 }
@@ -48,6 +48,10 @@ RCP<EpetraExt::ModelEvaluator> ModelFactory::create() const
     // Wrap a decorator around the original model when a reduced-order computation is requested.
     const RCP<MOR::ReducedOrderModelFactory> romFactory = app_->getMorFacade()->modelFactory();
     model = romFactory->create(model);
+
+    // Hyper-reduced model: only the rows of the sample dofs are read
+    if (romFactory->assemblyRestrictedToSample())
+      app_->setAssemblySample(romFactory->getAssemblySample());
   }
 #endif
 
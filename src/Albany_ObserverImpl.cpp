@@ -60,6 +60,15 @@ void ObserverImpl::observeSolution (
     }
 #endif
 #endif
+
+    if (app_->writesCheckpoints()) {
+      const int numVecs = nonOverlappedSolutionDot.is_null() ? 1 : 2;
+      Epetra_MultiVector soln(nonOverlappedSolution.Map(), numVecs);
+      *soln(0) = nonOverlappedSolution;
+      if (numVecs > 1) *soln(1) = *nonOverlappedSolutionDot;
+      app_->writeCheckpoint(stamp,
+        *Petra::EpetraMultiVector_To_TpetraMultiVector(soln, app_->getComm()));
+    }
   }
 
   //! update distributed parameters in the mesh
@@ -86,6 +95,16 @@ void ObserverImpl::observeSolutionT(
                                    Teuchos::null, nonOverlappedSolutionT);
   app_->getStateMgr().updateStates();
 
+  if (app_->writesCheckpoints()) {
+    const int numVecs = nonOverlappedSolutionDotDotT.is_null() ?
+      (nonOverlappedSolutionDotT.is_null() ? 1 : 2) : 3;
+    Tpetra_MultiVector soln(nonOverlappedSolutionT.getMap(), numVecs, false);
+    soln.getVectorNonConst(0)->assign(nonOverlappedSolutionT);
+    if (numVecs > 1) soln.getVectorNonConst(1)->assign(*nonOverlappedSolutionDotT);
+    if (numVecs > 2) soln.getVectorNonConst(2)->assign(*nonOverlappedSolutionDotDotT);
+    app_->writeCheckpoint(stamp, soln);
+  }
+
   StatelessObserverImpl::observeSolutionT(stamp, nonOverlappedSolutionT,
                                           nonOverlappedSolutionDotT);
 }
@@ -95,6 +114,7 @@ void ObserverImpl::observeSolutionT(
 {
   app_->evaluateStateFieldManagerT(stamp, nonOverlappedSolutionT);
   app_->getStateMgr().updateStates();
+  app_->writeCheckpoint(stamp, nonOverlappedSolutionT);
 
   StatelessObserverImpl::observeSolutionT(stamp, nonOverlappedSolutionT);
 }
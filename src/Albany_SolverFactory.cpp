@@ -744,6 +744,16 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
   // ModelEvaluator specifies.
   albanyApp = app;
 
+  return createSolverT(albanyApp, modelT);
+}
+
+Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST> >
+Albany::SolverFactory::createSolverT(
+  const Teuchos::RCP<Albany::Application>& albanyApp,
+  const Teuchos::RCP<Thyra::ModelEvaluator<ST> >& modelT)
+{
+  RCP<Albany::Application> app = albanyApp;
+
   const RCP<ParameterList> piroParams = Teuchos::sublist(appParams, "Piro");
   const Teuchos::RCP<Teuchos::ParameterList> stratList = Piro::extractStratimikosParams(piroParams);
 
@@ -766,7 +776,7 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
     // Setup linear solver
     Stratimikos::DefaultLinearSolverBuilder linearSolverBuilder;
     enableIfpack2(linearSolverBuilder);
-    enableMueLu(albanyApp, stratList, linearSolverBuilder);
+    enableMueLu(app, stratList, linearSolverBuilder);
 #ifdef ALBANY_TEKO
     Teko::addTekoToStratimikosBuilder(linearSolverBuilder, "Teko");
 #endif
@@ -807,7 +817,7 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
 #endif
   }
   TEUCHOS_TEST_FOR_EXCEPTION(true, std::logic_error,
-        "Reached end of createAndGetAlbanyAppT()" << "\n");
+        "Reached end of createSolverT()" << "\n");
   return Teuchos::null;
 }
 
@@ -86,6 +86,11 @@ namespace Albany {
       const Teuchos::RCP<const Tpetra_Vector>& initial_guess  = Teuchos::null,
       bool createAlbanyApp = true);
 
+    //! Create the Piro solver around a model built by createAlbanyAppAndModelT
+    Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST> > createSolverT(
+      const Teuchos::RCP<Application>& albanyApp,
+      const Teuchos::RCP<Thyra::ModelEvaluator<ST> >& modelT);
+
 #if defined(ALBANY_EPETRA)
     Teuchos::RCP<Thyra::ModelEvaluator<double> > createThyraSolverAndGetAlbanyApp(
       Teuchos::RCP<Application>& albanyApp,
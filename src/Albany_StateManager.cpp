@@ -12,8 +12,35 @@
 #include "Teuchos_VerboseObject.hpp"
 #include "Teuchos_TestForException.hpp"
 
+#include <algorithm>
+
+namespace {
+
+// Copy state "name" into "name_old" on every workset that has both. The
+// arrays are looked up once per workset and copied as contiguous blocks.
+void copyToOldState(Albany::StateArrayVec& sav, const std::string& name,
+                    const std::string& name_old)
+{
+  for (std::size_t ws = 0; ws < sav.size(); ws++) {
+    Albany::StateArray::iterator it = sav[ws].find(name);
+    Albany::StateArray::iterator it_old = sav[ws].find(name_old);
+    if (it == sav[ws].end() || it_old == sav[ws].end()) continue;
+
+    const Albany::MDArray& state = it->second;
+    Albany::MDArray& state_old = it_old->second;
+    TEUCHOS_TEST_FOR_EXCEPTION(state.size() != state_old.size(), std::logic_error,
+        "Error: state " << name << " and " << name_old << " differ in size on workset " << ws << std::endl);
+    if (state.size() > 0)
+      std::copy(state.contiguous_data(), state.contiguous_data() + state.size(),
+                state_old.contiguous_data());
+  }
+}
+
+} // namespace
+
 Albany::StateManager::StateManager() :
   stateVarsAreAllocated (false),
+  numStateUpdates       (0),
   stateInfo             (Teuchos::rcp(new StateInfoStruct))
 {
   // Nothing to be done here
@@ -724,14 +751,16 @@ Albany::StateManager::updateStates()
   // Swap boolean that defines old and new (in terms of state1 and 2) in accessors
   TEUCHOS_TEST_FOR_EXCEPT(!stateVarsAreAllocated);
 
+  ++numStateUpdates;
+
   // Get states from STK mesh
   Albany::StateArrays& sa = disc->getStateArrays();
   Albany::StateArrayVec& esa = sa.elemStateArrays;
   Albany::StateArrayVec& nsa = sa.nodeStateArrays;
-  int numElemWorksets = esa.size();
-  int numNodeWorksets = nsa.size();
 
-  // For each workset, loop over registered states
+  // The old states live in their own STK fields (they are output and
+  // restarted independently), so the buffers cannot simply be swapped;
+  // copy each state in bulk instead.
 
   for (unsigned int i=0; i<stateInfo->size(); i++) {
     if ((*stateInfo)[i]->saveOldState) {
@@ -741,26 +770,20 @@ Albany::StateManager::updateStates()
       switch((*stateInfo)[i]->entity){
 
       case Albany::StateStruct::NodalDataToElemNode :
-        for (int ws = 0; ws < numNodeWorksets; ws++)
-           for (int j = 0; j < nsa[ws][stateName].size(); j++)
-             nsa[ws][stateName_old][j] = nsa[ws][stateName][j];
+        copyToOldState(nsa, stateName, stateName_old);
 
       case Albany::StateStruct::WorksetValue :
       case Albany::StateStruct::ElemData :
       case Albany::StateStruct::QuadPoint :
       case Albany::StateStruct::ElemNode :
 
-        for (int ws = 0; ws < numElemWorksets; ws++)
-          for (int j = 0; j < esa[ws][stateName].size(); j++)
-            esa[ws][stateName_old][j] = esa[ws][stateName][j];
+        copyToOldState(esa, stateName, stateName_old);
 
         break;
 
       case Albany::StateStruct::NodalData :
 
-        for (int ws = 0; ws < numNodeWorksets; ws++)
-          for (int j = 0; j < nsa[ws][stateName].size(); j++)
-            nsa[ws][stateName_old][j] = nsa[ws][stateName][j];
+        copyToOldState(nsa, stateName, stateName_old);
 
         break;
 
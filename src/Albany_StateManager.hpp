@@ -200,6 +200,9 @@ public:
   void setAuxDataT(const Teuchos::RCP<Tpetra_MultiVector>& aux_data);
   bool areStateVarsAllocated() const {return stateVarsAreAllocated;}
 
+  //! Number of calls to updateStates, used to detect a change of the old states
+  int getNumStateUpdates() const {return numStateUpdates;}
+
 private:
   //! Private to prohibit copying
   StateManager(const StateManager&);
@@ -214,6 +217,9 @@ private:
   //! boolean to enforce that allocate gets called once, and after registration and befor gets
   bool stateVarsAreAllocated;
 
+  //! Incremented by updateStates
+  int numStateUpdates;
+
   //! Container to hold the states that have been registered, by element block, to be allocated later
   std::map<std::string, RegisteredStates> statesToStore;
   std::map<std::string,std::map<std::string, RegisteredStates> > sideSetStatesToStore;
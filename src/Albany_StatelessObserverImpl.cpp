@@ -19,7 +19,8 @@ namespace Albany {
 StatelessObserverImpl::
 StatelessObserverImpl (const Teuchos::RCP<Application> &app)
   : app_(app),
-  solOutTime_(Teuchos::TimeMonitor::getNewTimer("Albany: Output to File"))
+  solOutTime_(Teuchos::TimeMonitor::getNewTimer("Albany: Output to File")),
+  solOutProbe_("Albany: Output to File")
 {}
 
 RealType StatelessObserverImpl::
@@ -48,6 +49,8 @@ void StatelessObserverImpl::observeSolution (
   const Teuchos::Ptr<const Epetra_Vector>& nonOverlappedSolutionDot)
 {
   Teuchos::TimeMonitor timer(*solOutTime_);
+  util::PerformanceGuard guard(solOutProbe_, 0,
+                               nonOverlappedSolution.MyLength()*sizeof(double));
   const Teuchos::Ptr<const Epetra_Vector> overlappedSolution(
     app_->getAdaptSolMgr()->getOverlapSolution(nonOverlappedSolution));
   app_->getDiscretization()->writeSolution(*overlappedSolution, stamp,
@@ -60,6 +63,8 @@ void StatelessObserverImpl::observeSolutionT (
   const Teuchos::Ptr<const Tpetra_Vector>& nonOverlappedSolutionDotT)
 {
   Teuchos::TimeMonitor timer(*solOutTime_);
+  util::PerformanceGuard guard(solOutProbe_, 0,
+                               nonOverlappedSolutionT.getLocalLength()*sizeof(ST));
   const Teuchos::RCP<const Tpetra_Vector> overlappedSolutionT =
     app_->getAdaptSolMgrT()->updateAndReturnOverlapSolutionT(nonOverlappedSolutionT);
   app_->getDiscretization()->writeSolutionT(
@@ -70,6 +75,9 @@ void StatelessObserverImpl::observeSolutionT (
   double stamp, const Tpetra_MultiVector &nonOverlappedSolutionT)
 {
   Teuchos::TimeMonitor timer(*solOutTime_);
+  util::PerformanceGuard guard(solOutProbe_, 0,
+                               nonOverlappedSolutionT.getLocalLength()*
+                               nonOverlappedSolutionT.getNumVectors()*sizeof(ST));
   const Teuchos::RCP<const Tpetra_MultiVector> overlappedSolutionT =
     app_->getAdaptSolMgrT()->updateAndReturnOverlapSolutionMV(nonOverlappedSolutionT);
   app_->getDiscretization()->writeSolutionMV(
@@ -19,6 +19,8 @@
 
 #include "Teuchos_Time.hpp"
 
+#include "utility/PerformanceProbe.hpp"
+
 namespace Albany {
 
 /*! \brief Implementation to observe the solution without updating state
@@ -79,6 +81,7 @@ public:
 protected:
   Teuchos::RCP<Application> app_;
   Teuchos::RCP<Teuchos::Time> solOutTime_;
+  util::PerformanceProbe solOutProbe_;
 
 private:
   StatelessObserverImpl(const StatelessObserverImpl&);
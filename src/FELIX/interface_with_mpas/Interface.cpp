@@ -18,7 +18,10 @@
 #include <stk_mesh/base/FieldBase.hpp>
 #include <stk_mesh/base/GetEntities.hpp>
 #include "Piro_PerformSolve.hpp"
+#include "Piro_StratimikosUtils.hpp"
 #include "Albany_OrdinarySTKFieldContainer.hpp"
+#include "Albany_STKDiscretization.hpp"
+#include "Albany_ModelEvaluatorT.hpp"
 
 #ifdef ALBANY_SEACAS
 #include <stk_io/IossBridge.hpp>
@@ -46,6 +49,12 @@ double MPAS_gravity(9.8), MPAS_rho_ice(910.0), MPAS_rho_seawater(1028.0), MPAS_s
 #endif
 bool keptMesh =false;
 
+// With "Persistent Solver", the model and solver built on the first solve are
+// kept for the following solves on the same mesh, together with the Piro
+// solver type they were built for (homotopy may switch it after the first step).
+Teuchos::RCP<Albany::ModelEvaluatorT> albanyModel;
+std::string persistentSolverType;
+
 typedef struct TET_ {
   int verts[4];
   int neighbours[4];
@@ -180,17 +189,47 @@ void velocity_solver_solve_fo(int nLayers, int nGlobalVertices,
 
 
 
+  const bool persistentSolver = paramList->sublist("Problem").get("Persistent Solver", false);
+  const std::string solverType = paramList->sublist("Piro").get("Solver Type", "");
+
+#ifdef MPAS_USE_EPETRA
+  const bool reuseSolver = false;
+#else
+  const bool reuseSolver = persistentSolver && keptMesh && Teuchos::nonnull(albanyModel)
+      && (solverType == persistentSolverType);
+#endif
+
   if(!keptMesh) {
     albanyApp->createDiscretization();
     albanyApp->finalSetUp(paramList); //, albanyApp->getDiscretization()->getSolutionFieldT());
   }
+  else if (reuseSolver) {
+    // Same mesh: only coordinates, fields and initial guess were changed
+    // above, so keep maps, graphs, model and linear solver.
+    Teuchos::rcp_dynamic_cast<Albany::STKDiscretization>(
+        albanyApp->getDiscretization(), true)->updateGeometry();
+  }
   else
     albanyApp->getDiscretization()->updateMesh();
 
 #ifdef MPAS_USE_EPETRA
   solver = slvrfctry->createThyraSolverAndGetAlbanyApp(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
 #else
-   solver = slvrfctry->createAndGetAlbanyAppT(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
+  if (reuseSolver) {
+    albanyApp->getAdaptSolMgrT()->resetInitialSolution();
+    albanyModel->allocateVectors();
+  }
+  else if (persistentSolver) {
+    const Teuchos::RCP<Thyra::ModelEvaluator<double> > model =
+        slvrfctry->createAlbanyAppAndModelT(albanyApp, mpiCommT, Teuchos::null, false);
+    albanyModel = Teuchos::rcp_dynamic_cast<Albany::ModelEvaluatorT>(model);
+    TEUCHOS_TEST_FOR_EXCEPTION(albanyModel.is_null(), std::logic_error,
+        "Error! Persistent Solver requires an Albany::ModelEvaluatorT model.\n");
+    solver = slvrfctry->createSolverT(albanyApp, model);
+    persistentSolverType = solverType;
+  }
+  else
+    solver = slvrfctry->createAndGetAlbanyAppT(albanyApp, mpiCommT, mpiCommT, Teuchos::null, false);
 #endif
 
   Teuchos::ParameterList solveParams;
@@ -274,6 +313,7 @@ void velocity_solver_finalize() {
 
 void velocity_solver_compute_2d_grid(MPI_Comm reducedComm) {
   keptMesh = false;
+  albanyModel = Teuchos::null;
   mpiCommT = Albany::createTeuchosCommFromMpiComm(reducedComm);
 }
 
@@ -388,6 +428,17 @@ void velocity_solver_extrude_3d_grid(int nLayers, int nGlobalTriangles,
 
   discParams = Teuchos::sublist(paramList, "Discretization", true);
 
+  // Let MueLu reuse its hierarchy when the persistent solver sets up the
+  // preconditioner again for a new Jacobian.
+  const std::string mueluReuse = paramList->sublist("Problem").get("Persistent Solver MueLu Reuse", "none");
+  if (paramList->sublist("Problem").get("Persistent Solver", false) && (mueluReuse != "none")) {
+    const Teuchos::RCP<Teuchos::ParameterList> stratList =
+        Piro::extractStratimikosParams(Teuchos::sublist(paramList, "Piro"));
+    if (Teuchos::nonnull(stratList) &&
+        (stratList->get<std::string>("Preconditioner Type", "") == "MueLu"))
+      stratList->sublist("Preconditioner Types").sublist("MueLu").set("reuse: type", mueluReuse);
+  }
+
   Albany::AbstractFieldContainer::FieldContainerRequirements req;
   albanyApp = Teuchos::rcp(new Albany::Application(mpiCommT));
   albanyApp->initialSetUp(paramList);
@@ -136,6 +136,42 @@ protected:
 
   int
   coupled_app_index_;
+
+private:
+
+  // Element of the coupled application that contains a node set node,
+  // and the values of the element basis functions at that node.
+  struct NodeLocation
+  {
+    int
+    workset{-1};
+
+    int
+    element{-1};
+
+    std::vector<double>
+    basis_values;
+  };
+
+  void
+  locateNodes();
+
+  bool
+  nodeLocationsCurrent() const;
+
+  std::vector<NodeLocation>
+  node_locations_;
+
+  // Mesh change counts of this and the coupled discretizations when
+  // node_locations_ was computed.
+  int
+  located_this_mesh_;
+
+  int
+  located_coupled_mesh_;
+
+  int
+  located_dimension_;
 };
 
 //
@@ -7,11 +7,15 @@
 #include "Albany_Application.hpp"
 #include "Albany_GenericSTKMeshStruct.hpp"
 #include "Albany_STKDiscretization.hpp"
+#include "BoundingBoxTree.h"
 #include "Intrepid2_MiniTensor.h"
 #include "Phalanx_DataLayout.hpp"
 #include "Sacado_ParameterRegistration.hpp"
 #include "Teuchos_TestForException.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #if defined(ALBANY_DTK)
 #include "Albany_OrdinarySTKFieldContainer.hpp"
 #endif
@@ -39,7 +43,10 @@ SchwarzBC_Base(Teuchos::ParameterList & p) :
         "Application", Teuchos::null)),
     coupled_apps_(app_->getApplications()),
     coupled_app_name_(p.get<std::string>("Coupled Application", "SELF")),
-    coupled_block_name_(p.get<std::string>("Coupled Block", "NONE"))
+    coupled_block_name_(p.get<std::string>("Coupled Block", "NONE")),
+    located_this_mesh_(-1),
+    located_coupled_mesh_(-1),
+    located_dimension_(0)
 {
   std::string const &
   nodeset_name = this->nodeSetID;
@@ -76,20 +83,16 @@ SchwarzBC_Base(Teuchos::ParameterList & p) :
 }
 
 //
-//
+// Find, for each node of the node set, the element of the coupled
+// application that contains it and the values of the element basis
+// functions at that point. The coupled elements are placed in a bounding
+// box tree so that each node only tests the elements whose boxes contain it.
 //
 template<typename EvalT, typename Traits>
 void
 SchwarzBC_Base<EvalT, Traits>::
-computeBCs(
-    size_t const ns_node,
-    ScalarT & x_val,
-    ScalarT & y_val,
-    ScalarT & z_val)
+locateNodes()
 {
-  Teuchos::RCP<Teuchos::FancyOStream> 
-  out = Teuchos::fancyOStream(Teuchos::VerboseObjectBase::getDefaultOStream());
-
   auto const
   this_app_index = getThisAppIndex();
 
@@ -188,16 +191,11 @@ computeBCs(
   auto const &
   ws_elem_2_node_id = coupled_stk_disc->getWsElNodeID();
 
-  std::vector<Intrepid2::Vector<double>>
-  coupled_element_vertices(coupled_vertex_count);
-
-  std::vector<Intrepid2::Vector<double>>
-  coupled_element_solution(coupled_vertex_count);
+  Teuchos::ArrayRCP<double> const &
+  coupled_coordinates = coupled_stk_disc->getCoordinates();
 
-  for (auto i = 0; i < coupled_vertex_count; ++i) {
-    coupled_element_vertices[i].set_dimension(coupled_dimension);
-    coupled_element_solution[i].set_dimension(coupled_dimension);
-  }
+  Teuchos::RCP<Tpetra_Map const>
+  coupled_overlap_node_map = coupled_stk_disc->getOverlapNodeMapT();
 
   // This tolerance is used for geometric approximations. It will be used
   // to determine whether a node of this_app is inside an element of
@@ -205,54 +203,39 @@ computeBCs(
   double const
   tolerance = 5.0e-2;
 
-  double * const
-  coord = ns_coord[ns_node];
-
-  Intrepid2::Vector<double>
-  point;
-
-  point.set_dimension(coupled_dimension);
-
-  point.fill(coord);
+  Teuchos::RCP<Intrepid2::Basis<double, Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>>>
+  basis;
 
-#if defined(DEBUG_LCM_SCHWARZ)
-  std::cout << "--------------------------------------------------------\n";
-  std::cout << "Current app      : " << this_app_name << '\n';
-  std::cout << "Coupling to app  : " << coupled_app_name << '\n';
-  std::cout << "Coupling to block: " << coupled_block_name << '\n';
-  std::cout << "Node set node    : " << ns_node << '\n';
-  std::cout << "Point            : " << point << '\n';
-  std::cout << "--------------------------------------------------------\n";
-#endif // DEBUG_LCM_SCHWARZ
+  switch (coupled_element_type) {
 
-  // Determine the element that contains this point.
-  bool
-  found = false;
+  default:
+    std::cerr << "\nERROR: " << __PRETTY_FUNCTION__ << '\n';
+    std::cerr << "Unknown element type: " << coupled_element_type << '\n';
+    exit(1);
+    break;
 
-  auto
-  parametric_dimension = 0;
+  case Intrepid2::ELEMENT::TETRAHEDRAL:
+    basis = Teuchos::rcp(new Intrepid2::Basis_HGRAD_TET_C1_FEM<
+        double, Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>>());
+    break;
 
-  Teuchos::RCP<Intrepid2::Basis<double, Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>>>
-  basis;
+  case Intrepid2::ELEMENT::HEXAHEDRAL:
+    basis = Teuchos::rcp(new Intrepid2::Basis_HGRAD_HEX_C1_FEM<
+        double, Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>>());
+    break;
 
-  Teuchos::ArrayRCP<double> const &
-  coupled_coordinates = coupled_stk_disc->getCoordinates();
+  } // switch
 
-  Teuchos::RCP<Tpetra_Vector const>
-  coupled_solution = coupled_stk_disc->getSolutionFieldT();
+  auto const
+  parametric_dimension = 3;
 
-#if defined(DEBUG_LCM_SCHWARZ)
-  if (ns_node == 0) { 
-    *out << "coupled_solution: \n"; 
-    coupled_solution->describe(*out, Teuchos::VERB_EXTREME);  
-  }
-#endif //DEBUG_LCM_SCHWARZ  
- 
-  Teuchos::ArrayRCP<ST const>
-  coupled_solution_view = coupled_solution->get1dView();
+  // Bounding boxes of the coupled elements, enlarged by the containment
+  // tolerance. Element e of the tree is elements[e] = (workset, element).
+  std::vector<std::pair<int, int>>
+  elements;
 
-  Teuchos::RCP<Tpetra_Map const>
-  coupled_overlap_node_map = coupled_stk_disc->getOverlapNodeMapT();
+  std::vector<double>
+  boxes;
 
   for (auto workset = 0; workset < ws_elem_2_node_id.size(); ++workset) {
 
@@ -269,6 +252,107 @@ computeBCs(
 
     for (auto element = 0; element < elements_per_workset; ++element) {
 
+      std::vector<double>
+      lower(coupled_dimension, std::numeric_limits<double>::max());
+
+      std::vector<double>
+      upper(coupled_dimension, -std::numeric_limits<double>::max());
+
+      for (auto node = 0; node < coupled_vertex_count; ++node) {
+
+        auto const
+        global_node_id = ws_elem_2_node_id[workset][element][node];
+
+        auto const
+        local_node_id =
+            coupled_overlap_node_map->getLocalElement(global_node_id);
+
+        for (auto i = 0; i < coupled_dimension; ++i) {
+          double const
+          x = coupled_coordinates[coupled_dimension * local_node_id + i];
+
+          lower[i] = std::min(lower[i], x);
+          upper[i] = std::max(upper[i], x);
+        }
+
+      } // node loop
+
+      double
+      extent = 0.0;
+
+      for (auto i = 0; i < coupled_dimension; ++i) {
+        extent = std::max(extent, upper[i] - lower[i]);
+      }
+
+      // Conservative whether the tolerance is absolute or relative.
+      double const
+      margin = tolerance * std::max(extent, 1.0);
+
+      for (auto i = 0; i < coupled_dimension; ++i) {
+        boxes.push_back(lower[i] - margin);
+      }
+
+      for (auto i = 0; i < coupled_dimension; ++i) {
+        boxes.push_back(upper[i] + margin);
+      }
+
+      elements.push_back(std::make_pair(workset, element));
+
+    } // element loop
+
+  } // workset loop
+
+  BoundingBoxTree
+  element_tree;
+
+  element_tree.build(boxes, coupled_dimension);
+
+  std::vector<Intrepid2::Vector<double>>
+  coupled_element_vertices(coupled_vertex_count);
+
+  for (auto i = 0; i < coupled_vertex_count; ++i) {
+    coupled_element_vertices[i].set_dimension(coupled_dimension);
+  }
+
+  auto const
+  ns_number_nodes = ns_coord.size();
+
+  node_locations_.resize(ns_number_nodes);
+
+  std::vector<int>
+  candidates;
+
+  for (auto ns_node = 0; ns_node < ns_number_nodes; ++ns_node) {
+
+    double * const
+    coord = ns_coord[ns_node];
+
+    Intrepid2::Vector<double>
+    point;
+
+    point.set_dimension(coupled_dimension);
+
+    point.fill(coord);
+
+    // Determine the element that contains this point. Candidates are
+    // tested in workset and element order, so the first element found is
+    // the same as with a search over all elements.
+    element_tree.query(coord, candidates);
+
+    bool
+    found = false;
+
+    NodeLocation &
+    location = node_locations_[ns_node];
+
+    for (auto candidate : candidates) {
+
+      auto const
+      workset = elements[candidate].first;
+
+      auto const
+      element = elements[candidate].second;
+
       for (auto node = 0; node < coupled_vertex_count; ++node) {
 
         auto const
@@ -283,11 +367,6 @@ computeBCs(
 
         coupled_element_vertices[node].fill(pcoord);
 
-        for (auto i = 0; i < coupled_dimension; ++i) {
-          coupled_element_solution[node](i) =
-              coupled_solution_view[coupled_dimension * local_node_id + i];
-        } // dimension loop
-
       } // node loop
 
       bool
@@ -296,17 +375,9 @@ computeBCs(
       switch (coupled_element_type) {
 
       default:
-        std::cerr << "\nERROR: " << __PRETTY_FUNCTION__ << '\n';
-        std::cerr << "Unknown element type: " << coupled_element_type << '\n';
-        exit(1);
         break;
 
       case Intrepid2::ELEMENT::TETRAHEDRAL:
-        parametric_dimension = 3;
-
-        basis = Teuchos::rcp(new Intrepid2::Basis_HGRAD_TET_C1_FEM<
-            double, Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>>());
-
         in_element = Intrepid2::in_tetrahedron(
             point,
             coupled_element_vertices[0],
@@ -317,11 +388,6 @@ computeBCs(
         break;
 
       case Intrepid2::ELEMENT::HEXAHEDRAL:
-        parametric_dimension = 3;
-
-        basis = Teuchos::rcp(new Intrepid2::Basis_HGRAD_HEX_C1_FEM<
-            double, Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>>());
-
         in_element = Intrepid2::in_hexahedron(
             point,
             coupled_element_vertices[0],
@@ -338,72 +404,174 @@ computeBCs(
       } // switch
 
       if (in_element == true) {
+        location.workset = workset;
+        location.element = element;
         found = true;
         break;
       }
 
-    } // element loop
+    } // candidate loop
+
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        found == false, std::runtime_error,
+        "Schwarz BC: node " << ns_node << " of node set " << this->nodeSetID
+        << " at " << point << " is not in any element of coupled application "
+        << coupled_app_name << '\n');
+
+    // We do this element by element
+    auto const
+    number_cells = 1;
 
-    if (found == true) {
-      break;
+    // Container for the parametric coordinates
+    Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>
+    parametric_point(number_cells, parametric_dimension);
+
+    for (auto j = 0; j < parametric_dimension; ++j) {
+      parametric_point(0, j) = 0.0;
     }
 
-  } // workset loop
+    // Container for the physical point
+    Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>
+    physical_coordinates(number_cells, coupled_dimension);
 
-  assert(found == true);
+    for (auto i = 0; i < coupled_dimension; ++i) {
+      physical_coordinates(0, i) = point(i);
+    }
 
-  // We do this element by element
-  auto const
-  number_cells = 1;
+    // Container for the physical nodal coordinates
+    // TODO: matToReference more general, accepts more topologies.
+    // Use it to find if point is contained in element as well.
+    Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>
+    nodal_coordinates(number_cells, coupled_vertex_count, coupled_dimension);
 
-  // Container for the parametric coordinates
-  Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>
-  parametric_point(number_cells, parametric_dimension);
+    for (auto i = 0; i < coupled_vertex_count; ++i) {
+      for (auto j = 0; j < coupled_dimension; ++j) {
+        nodal_coordinates(0, i, j) = coupled_element_vertices[i](j);
+      }
+    }
 
-  for (auto j = 0; j < parametric_dimension; ++j) {
-    parametric_point(0, j) = 0.0;
-  }
+    // Get parametric coordinates
+    Intrepid2::CellTools<double>::mapToReferenceFrame(
+        parametric_point,
+        physical_coordinates,
+        nodal_coordinates,
+        coupled_cell_topology,
+        0
+        );
 
-  // Container for the physical point
-  Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>
-  physical_coordinates(number_cells, coupled_dimension);
+    // Evaluate shape functions at parametric point.
+    auto const
+    number_points = 1;
 
-  for (auto i = 0; i < coupled_dimension; ++i) {
-    physical_coordinates(0, i) = point(i);
-  }
+    Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>
+    basis_values(coupled_vertex_count, number_points);
 
-  // Container for the physical nodal coordinates
-  // TODO: matToReference more general, accepts more topologies.
-  // Use it to find if point is contained in element as well.
-  Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>
-  nodal_coordinates(number_cells, coupled_vertex_count, coupled_dimension);
+    basis->getValues(basis_values, parametric_point, Intrepid2::OPERATOR_VALUE);
 
-  for (auto i = 0; i < coupled_vertex_count; ++i) {
-    for (auto j = 0; j < coupled_dimension; ++j) {
-      nodal_coordinates(0, i, j) = coupled_element_vertices[i](j);
+    location.basis_values.resize(coupled_vertex_count);
+
+    for (auto i = 0; i < coupled_vertex_count; ++i) {
+      location.basis_values[i] = basis_values(i, 0);
     }
+
+  } // node set node loop
+
+  located_dimension_ = coupled_dimension;
+  located_this_mesh_ = this_stk_disc->getMeshChangeCount();
+  located_coupled_mesh_ = coupled_stk_disc->getMeshChangeCount();
+
+  return;
+}
+
+//
+//
+//
+template<typename EvalT, typename Traits>
+bool
+SchwarzBC_Base<EvalT, Traits>::
+nodeLocationsCurrent() const
+{
+  Albany::Application const &
+  this_app = getApplication(getThisAppIndex());
+
+  Albany::Application const &
+  coupled_app = getApplication(getCoupledAppIndex());
+
+  auto *
+  this_stk_disc = static_cast<Albany::STKDiscretization *>(
+      this_app.getDiscretization().get());
+
+  auto *
+  coupled_stk_disc = static_cast<Albany::STKDiscretization *>(
+      coupled_app.getDiscretization().get());
+
+  return
+      located_this_mesh_ == this_stk_disc->getMeshChangeCount() &&
+      located_coupled_mesh_ == coupled_stk_disc->getMeshChangeCount();
+}
+
+//
+// Interpolate the coupled solution at node set node ns_node. The node
+// locations are computed on the first call and again only when either
+// mesh changes.
+//
+template<typename EvalT, typename Traits>
+void
+SchwarzBC_Base<EvalT, Traits>::
+computeBCs(
+    size_t const ns_node,
+    ScalarT & x_val,
+    ScalarT & y_val,
+    ScalarT & z_val)
+{
+  Teuchos::RCP<Teuchos::FancyOStream> 
+  out = Teuchos::fancyOStream(Teuchos::VerboseObjectBase::getDefaultOStream());
+
+  bool const
+  relocate = ns_node == 0 || ns_node >= node_locations_.size();
+
+  if (relocate == true && nodeLocationsCurrent() == false) locateNodes();
+
+  Albany::Application const &
+  coupled_app = getApplication(getCoupledAppIndex());
+
+  Teuchos::RCP<Albany::AbstractDiscretization>
+  coupled_disc = coupled_app.getDiscretization();
+
+  auto *
+  coupled_stk_disc =
+      static_cast<Albany::STKDiscretization *>(coupled_disc.get());
+
+  auto const &
+  ws_elem_2_node_id = coupled_stk_disc->getWsElNodeID();
+
+  Teuchos::RCP<Tpetra_Vector const>
+  coupled_solution = coupled_stk_disc->getSolutionFieldT();
+
+#if defined(DEBUG_LCM_SCHWARZ)
+  if (ns_node == 0) { 
+    *out << "coupled_solution: \n"; 
+    coupled_solution->describe(*out, Teuchos::VERB_EXTREME);  
   }
+#endif //DEBUG_LCM_SCHWARZ  
+ 
+  Teuchos::ArrayRCP<ST const>
+  coupled_solution_view = coupled_solution->get1dView();
 
-  // Get parametric coordinates
-  Intrepid2::CellTools<double>::mapToReferenceFrame(
-      parametric_point,
-      physical_coordinates,
-      nodal_coordinates,
-      coupled_cell_topology,
-      0
-      );
+  Teuchos::RCP<Tpetra_Map const>
+  coupled_overlap_node_map = coupled_stk_disc->getOverlapNodeMapT();
 
-  // Evaluate shape functions at parametric point.
-  auto const
-  number_points = 1;
+  NodeLocation const &
+  location = node_locations_[ns_node];
 
-  Intrepid2::FieldContainer_Kokkos<double, PHX::Layout, PHX::Device>
-  basis_values(coupled_vertex_count, number_points);
+  auto const
+  coupled_dimension = located_dimension_;
 
-  basis->getValues(basis_values, parametric_point, Intrepid2::OPERATOR_VALUE);
+  auto const
+  coupled_vertex_count = location.basis_values.size();
 
   // Evaluate solution at parametric point using values of shape
-  // functions just computed.
+  // functions computed when the node was located.
   Intrepid2::Vector<double>
   value(coupled_dimension, Intrepid2::ZEROS);
 
@@ -413,13 +581,22 @@ computeBCs(
 #endif // DEBUG_LCM_SCHWARZ
 
   for (auto i = 0; i < coupled_vertex_count; ++i) {
-    value += basis_values(i, 0) * coupled_element_solution[i];
+
+    auto const
+    global_node_id = ws_elem_2_node_id[location.workset][location.element][i];
+
+    auto const
+    local_node_id = coupled_overlap_node_map->getLocalElement(global_node_id);
+
+    for (auto j = 0; j < coupled_dimension; ++j) {
+      value(j) += location.basis_values[i] *
+          coupled_solution_view[coupled_dimension * local_node_id + j];
+    }
 
 #if defined(DEBUG_LCM_SCHWARZ)
     std::cout << std::setw(4) << i << ' ';
     std::cout << std::scientific << std::setw(24) << std::setprecision(16);
-    std::cout << basis_values(i, 0) << "    ";
-    std::cout << coupled_element_solution[i] << '\n';
+    std::cout << location.basis_values[i] << '\n';
 #endif // DEBUG_LCM_SCHWARZ
 
   }
@@ -7,6 +7,7 @@
 #if !defined(LCM_J2Model_hpp)
 #define LCM_J2Model_hpp
 
+#include <Intrepid2_MiniTensor.h>
 #include "Phalanx_config.hpp"
 #include "Phalanx_Evaluator_WithBaseImpl.hpp"
 #include "Phalanx_Evaluator_Derived.hpp"
@@ -62,6 +63,16 @@ public:
 
 private:
 
+  ///
+  /// computeState for a static spatial dimension DIM, or for the runtime
+  /// dimension if DIM is Intrepid2::DYNAMIC
+  ///
+  template<Intrepid2::Index DIM>
+  void
+  computeStateImpl(typename Traits::EvalData workset,
+      std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>>& dep_fields,
+      std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>>& eval_fields);
+
   ///
   /// Private to prohibit copying
   ///
@@ -77,6 +88,12 @@ private:
   ///
   RealType sat_mod_, sat_exp_;
 
+  ///
+  /// Use tensors of static dimension ("Static Tensor Dimension", default
+  /// true); false selects the runtime-dimension path, for comparison
+  ///
+  bool static_dims_;
+
  //Kokkos 
   virtual
   void
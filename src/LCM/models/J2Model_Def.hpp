@@ -20,7 +20,8 @@ J2Model(Teuchos::ParameterList* p,
     const Teuchos::RCP<Albany::Layouts>& dl) :
     LCM::ConstitutiveModel<EvalT, Traits>(p, dl),
     sat_mod_(p->get<RealType>("Saturation Modulus", 0.0)),
-    sat_exp_(p->get<RealType>("Saturation Exponent", 0.0))
+    sat_exp_(p->get<RealType>("Saturation Exponent", 0.0)),
+    static_dims_(p->get<bool>("Static Tensor Dimension", true))
 {
   // retrive appropriate field name strings
   std::string cauchy_string = (*field_name_map_)["Cauchy_Stress"];
@@ -105,6 +106,36 @@ void J2Model<EvalT, Traits>::
 computeState(typename Traits::EvalData workset,
     std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>> dep_fields,
     std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>> eval_fields)
+{
+  if (static_dims_ == false) {
+    computeStateImpl<Intrepid2::DYNAMIC>(workset, dep_fields, eval_fields);
+    return;
+  }
+
+  // Dispatch once per workset so that the tensor temporaries have static
+  // dimension and live on the stack.
+  switch (num_dims_) {
+  case 1:
+    computeStateImpl<1>(workset, dep_fields, eval_fields);
+    break;
+  case 2:
+    computeStateImpl<2>(workset, dep_fields, eval_fields);
+    break;
+  case 3:
+    computeStateImpl<3>(workset, dep_fields, eval_fields);
+    break;
+  default:
+    TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument,
+        ">>> ERROR (J2Model): invalid number of dimensions " << num_dims_);
+  }
+}
+//------------------------------------------------------------------------------
+template<typename EvalT, typename Traits>
+template<Intrepid2::Index DIM>
+void J2Model<EvalT, Traits>::
+computeStateImpl(typename Traits::EvalData workset,
+    std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>>& dep_fields,
+    std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>>& eval_fields)
 {
   std::string cauchy_string = (*field_name_map_)["Cauchy_Stress"];
   std::string Fp_string = (*field_name_map_)["Fp"];
@@ -144,12 +175,12 @@ computeState(typename Traits::EvalData workset,
   ScalarT Jm23, trace, smag2, smag, f, p, dgam;
   ScalarT sq23(std::sqrt(2. / 3.));
 
-  Intrepid2::Tensor<ScalarT> F(num_dims_), be(num_dims_), s(num_dims_), sigma(
+  Intrepid2::Tensor<ScalarT, DIM> F(num_dims_), be(num_dims_), s(num_dims_), sigma(
       num_dims_);
-  Intrepid2::Tensor<ScalarT> N(num_dims_), A(num_dims_), expA(num_dims_), Fpnew(
+  Intrepid2::Tensor<ScalarT, DIM> N(num_dims_), A(num_dims_), expA(num_dims_), Fpnew(
       num_dims_);
-  Intrepid2::Tensor<ScalarT> I(Intrepid2::eye<ScalarT>(num_dims_));
-  Intrepid2::Tensor<ScalarT> Fpn(num_dims_), Fpinv(num_dims_), Cpinv(num_dims_);
+  Intrepid2::Tensor<ScalarT, DIM> I(Intrepid2::eye<ScalarT, DIM>(num_dims_));
+  Intrepid2::Tensor<ScalarT, DIM> Fpn(num_dims_), Fpinv(num_dims_), Cpinv(num_dims_);
 
   for (int cell(0); cell < workset.numCells; ++cell) {
     for (int pt(0); pt < num_pts_; ++pt) {
@@ -16,7 +16,8 @@ template<typename EvalT, typename Traits>
 NeohookeanModel<EvalT, Traits>::
 NeohookeanModel(Teuchos::ParameterList* p,
                 const Teuchos::RCP<Albany::Layouts>& dl) :
-  LCM::ConstitutiveModel<EvalT, Traits>(p, dl)
+  LCM::ConstitutiveModel<EvalT, Traits>(p, dl),
+  static_dims_(p->get<bool>("Static Tensor Dimension", true))
 {
   std::string F_string = (*field_name_map_)["F"];
   std::string J_string = (*field_name_map_)["J"];
@@ -49,6 +50,36 @@ void NeohookeanModel<EvalT, Traits>::
 computeState(typename Traits::EvalData workset,
     std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>> dep_fields,
     std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>> eval_fields)
+{
+  if (static_dims_ == false) {
+    computeStateImpl<Intrepid2::DYNAMIC>(workset, dep_fields, eval_fields);
+    return;
+  }
+
+  // Dispatch once per workset so that the tensor temporaries have static
+  // dimension and live on the stack.
+  switch (num_dims_) {
+  case 1:
+    computeStateImpl<1>(workset, dep_fields, eval_fields);
+    break;
+  case 2:
+    computeStateImpl<2>(workset, dep_fields, eval_fields);
+    break;
+  case 3:
+    computeStateImpl<3>(workset, dep_fields, eval_fields);
+    break;
+  default:
+    TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument,
+        ">>> ERROR (NeohookeanModel): invalid number of dimensions " << num_dims_);
+  }
+}
+//------------------------------------------------------------------------------
+template<typename EvalT, typename Traits>
+template<Intrepid2::Index DIM>
+void NeohookeanModel<EvalT, Traits>::
+computeStateImpl(typename Traits::EvalData workset,
+    std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>>& dep_fields,
+    std::map<std::string, Teuchos::RCP<PHX::MDField<ScalarT>>>& eval_fields)
 {
   std::string F_string = (*field_name_map_)["F"];
   std::string J_string = (*field_name_map_)["J"];
@@ -68,13 +99,13 @@ computeState(typename Traits::EvalData workset,
   ScalarT Jm53, Jm23;
   ScalarT smag;
 
-  Intrepid2::Tensor<ScalarT> F(num_dims_), b(num_dims_), sigma(num_dims_);
-  Intrepid2::Tensor<ScalarT> I(Intrepid2::eye<ScalarT>(num_dims_));
-  Intrepid2::Tensor<ScalarT> s(num_dims_), n(num_dims_);
+  Intrepid2::Tensor<ScalarT, DIM> F(num_dims_), b(num_dims_), sigma(num_dims_);
+  Intrepid2::Tensor<ScalarT, DIM> I(Intrepid2::eye<ScalarT, DIM>(num_dims_));
+  Intrepid2::Tensor<ScalarT, DIM> s(num_dims_), n(num_dims_);
 
-  Intrepid2::Tensor4<ScalarT> dsigmadb;
-  Intrepid2::Tensor4<ScalarT> I1(Intrepid2::identity_1<ScalarT>(num_dims_));
-  Intrepid2::Tensor4<ScalarT> I3(Intrepid2::identity_3<ScalarT>(num_dims_));
+  Intrepid2::Tensor4<ScalarT, DIM> dsigmadb;
+  Intrepid2::Tensor4<ScalarT, DIM> I1(Intrepid2::identity_1<ScalarT, DIM>(num_dims_));
+  Intrepid2::Tensor4<ScalarT, DIM> I3(Intrepid2::identity_3<ScalarT, DIM>(num_dims_));
 
   for (int cell(0); cell < workset.numCells; ++cell) {
     for (int pt(0); pt < num_pts_; ++pt) {
@@ -0,0 +1,511 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+//
+// Cost of the J2, Neohookean and CrystalPlasticity models, driven through
+// ConstitutiveModelInterface as in MaterialPointSimulator, for the
+// Jacobian evaluation type. J2 and Neohookean are run in 2D and 3D both
+// with static tensor dimension (the default) and with the runtime
+// dimension path ("Static Tensor Dimension" false); the stresses and
+// their derivatives must agree. CrystalPlasticity always uses
+// CP::MAX_DIM tensors and is only timed. The timings are printed for
+// comparison.
+//
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <Teuchos_GlobalMPISession.hpp>
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Phalanx.hpp>
+
+#include <Intrepid2_MiniTensor.h>
+
+#include "PHAL_AlbanyTraits.hpp"
+#include "Albany_Layouts.hpp"
+#include "Albany_StateManager.hpp"
+#include "Albany_STKDiscretization.hpp"
+#include "Albany_TmplSTKMeshStruct.hpp"
+#include "Albany_Utils.hpp"
+
+#include "ConstitutiveModelInterface.hpp"
+#include "ConstitutiveModelParameters.hpp"
+#include "FieldNameMap.hpp"
+#include "SetField.hpp"
+
+#include "Kokkos_Core.hpp"
+
+// Why is this needed?
+bool TpetraBuild = false;
+
+namespace
+{
+
+using Jacobian = PHAL::AlbanyTraits::Jacobian;
+using Traits = PHAL::AlbanyTraits;
+using ScalarT = Jacobian::ScalarT;
+using Teuchos::ArrayRCP;
+using Teuchos::RCP;
+using Teuchos::rcp;
+
+constexpr int
+WORKSET_SIZE{64};
+
+constexpr int
+NUM_REPEATS{20};
+
+//
+// Stresses at all points of the workset and the wall time per point of
+// one evaluation of the model
+//
+struct Result
+{
+  std::vector<ScalarT>
+  stress;
+
+  double
+  ns_per_point;
+};
+
+RCP<PHX::Evaluator<Traits>>
+setField(
+    std::string const & name,
+    RCP<PHX::DataLayout> const & layout,
+    ArrayRCP<ScalarT> const & values)
+{
+  Teuchos::ParameterList
+  p("SetField " + name);
+
+  p.set<std::string>("Evaluated Field Name", name);
+  p.set<RCP<PHX::DataLayout>>("Evaluated Field Data Layout", layout);
+  p.set<ArrayRCP<ScalarT>>("Field Values", values);
+
+  return rcp(new LCM::SetField<Jacobian, Traits>(p));
+}
+
+//
+// Evaluate the material model of the given parameter list on one workset
+// of quadrilaterals (2D) or hexahedra (3D), each point with a different
+// deformation gradient whose entries are the independent variables.
+//
+Result
+evaluateModel(
+    Teuchos::ParameterList material,
+    int const num_dims,
+    bool const static_dims,
+    std::string const & label)
+{
+  RCP<Teuchos_Comm const>
+  commT = Albany::createTeuchosCommFromMpiComm(Albany_MPI_COMM_WORLD);
+
+  std::string const
+  element_block_name = "Block0";
+
+  LCM::FieldNameMap
+  field_name_map(false);
+
+  RCP<std::map<std::string, std::string>>
+  fnm = field_name_map.getMap();
+
+  material.set<RCP<std::map<std::string, std::string>>>("Name Map", fnm);
+  material.set<bool>("Static Tensor Dimension", static_dims);
+
+  int const
+  num_nodes = num_dims == 2 ? 4 : 8;
+
+  int const
+  num_pts = num_nodes;
+
+  int const
+  num_derivs = num_nodes * num_dims;
+
+  RCP<Albany::Layouts> const
+  dl = rcp(new Albany::Layouts(
+      WORKSET_SIZE, num_nodes, num_nodes, num_pts, num_dims));
+
+  //---------------------------------------------------------------------------
+  // Deformation gradient, its determinant and the time step
+  int const
+  num_entries = num_dims * num_dims;
+
+  ArrayRCP<ScalarT>
+  def_grad(WORKSET_SIZE * num_pts * num_entries);
+
+  ArrayRCP<ScalarT>
+  det_def_grad(WORKSET_SIZE * num_pts);
+
+  for (int cell = 0; cell < WORKSET_SIZE; ++cell) {
+    for (int pt = 0; pt < num_pts; ++pt) {
+      Intrepid2::Tensor<ScalarT>
+      F(num_dims);
+
+      int const
+      base = cell * num_pts + pt;
+
+      for (int i = 0; i < num_dims; ++i) {
+        for (int j = 0; j < num_dims; ++j) {
+          RealType const
+          value = (i == j ? 1.0 : 0.0) + 1.0e-3 * ((base + 3 * i + j) % 7);
+
+          F(i, j) = ScalarT(num_derivs, (num_dims * i + j) % num_derivs, value);
+          def_grad[base * num_entries + num_dims * i + j] = F(i, j);
+        }
+      }
+      det_def_grad[base] = Intrepid2::det(F);
+    }
+  }
+
+  ArrayRCP<ScalarT>
+  delta_time(1);
+
+  delta_time[0] = 1.0e-2;
+
+  //---------------------------------------------------------------------------
+  // Field manager
+  PHX::FieldManager<Traits>
+  field_manager;
+
+  field_manager.registerEvaluator<Jacobian>(
+      setField((*fnm)["F"], dl->qp_tensor, def_grad));
+  field_manager.registerEvaluator<Jacobian>(
+      setField((*fnm)["J"], dl->qp_scalar, det_def_grad));
+  field_manager.registerEvaluator<Jacobian>(
+      setField("Delta Time", dl->workset_scalar, delta_time));
+
+  Teuchos::ParameterList
+  cmpPL;
+
+  cmpPL.set<Teuchos::ParameterList*>("Material Parameters", &material);
+  field_manager.registerEvaluator<Jacobian>(
+      rcp(new LCM::ConstitutiveModelParameters<Jacobian, Traits>(cmpPL, dl)));
+
+  Teuchos::ParameterList
+  cmiPL;
+
+  cmiPL.set<Teuchos::ParameterList*>("Material Parameters", &material);
+
+  RCP<LCM::ConstitutiveModelInterface<Jacobian, Traits>>
+  CMI = rcp(new LCM::ConstitutiveModelInterface<Jacobian, Traits>(cmiPL, dl));
+
+  field_manager.registerEvaluator<Jacobian>(CMI);
+
+  for (auto const & tag : CMI->evaluatedFields()) {
+    field_manager.requireField<Jacobian>(*tag);
+  }
+
+  //---------------------------------------------------------------------------
+  // State variables, which hold the old states read by the models
+  Albany::StateManager
+  state_mgr;
+
+  for (int sv = 0; sv < CMI->getNumStateVars(); ++sv) {
+    CMI->fillStateVariableStruct(sv);
+    state_mgr.registerStateVariable(
+        CMI->getName(),
+        CMI->getLayout(),
+        dl->dummy,
+        element_block_name,
+        CMI->getInitType(),
+        CMI->getInitValue(),
+        CMI->getStateFlag(),
+        CMI->getOutputFlag());
+  }
+
+  std::vector<PHX::index_size_type>
+  derivative_dimensions(1, num_derivs);
+
+  field_manager.setKokkosExtendedDataTypeDimensions<Jacobian>(
+      derivative_dimensions);
+
+  Traits::SetupData
+  setup_data = "Test String";
+
+  field_manager.postRegistrationSetupForType<Jacobian>(setup_data);
+
+  //---------------------------------------------------------------------------
+  // Discretization, as required by the StateManager
+  RCP<Teuchos::ParameterList>
+  disc_params = rcp(new Teuchos::ParameterList("Discretization"));
+
+  disc_params->set<int>("1D Elements", WORKSET_SIZE);
+  disc_params->set<int>("2D Elements", 1);
+  if (num_dims == 3) {
+    disc_params->set<int>("3D Elements", 1);
+  }
+  disc_params->set<std::string>("Method", num_dims == 2 ? "STK2D" : "STK3D");
+  disc_params->set<int>("Number Of Time Derivatives", 0);
+  disc_params->set<int>("Workset Size", WORKSET_SIZE);
+
+  RCP<Albany::GenericSTKMeshStruct>
+  mesh_struct;
+
+  if (num_dims == 2) {
+    mesh_struct = rcp(
+        new Albany::TmplSTKMeshStruct<2>(disc_params, Teuchos::null, commT));
+  } else {
+    mesh_struct = rcp(
+        new Albany::TmplSTKMeshStruct<3>(disc_params, Teuchos::null, commT));
+  }
+
+  Albany::AbstractFieldContainer::FieldContainerRequirements
+  req;
+
+  mesh_struct->setFieldAndBulkData(
+      commT,
+      disc_params,
+      num_dims,
+      req,
+      state_mgr.getStateInfoStruct(),
+      mesh_struct->getMeshSpecs()[0]->worksetSize);
+
+  RCP<Albany::AbstractDiscretization>
+  discretization = rcp(new Albany::STKDiscretization(mesh_struct, commT));
+
+  discretization->updateMesh();
+  state_mgr.setStateArrays(discretization);
+
+  PHAL::Workset
+  workset;
+
+  workset.numCells = WORKSET_SIZE;
+  workset.stateArrayPtr =
+      &state_mgr.getStateArray(Albany::StateManager::ELEM, 0);
+
+  //---------------------------------------------------------------------------
+  // Evaluate once to warm up, then time the repeated evaluations. The old
+  // states are not updated, so every evaluation computes the same values.
+  field_manager.preEvaluate<Jacobian>(workset);
+  field_manager.evaluateFields<Jacobian>(workset);
+  field_manager.postEvaluate<Jacobian>(workset);
+
+  std::chrono::steady_clock::time_point const
+  start = std::chrono::steady_clock::now();
+
+  for (int repeat = 0; repeat < NUM_REPEATS; ++repeat) {
+    field_manager.preEvaluate<Jacobian>(workset);
+    field_manager.evaluateFields<Jacobian>(workset);
+    field_manager.postEvaluate<Jacobian>(workset);
+  }
+
+  double const
+  ns = std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - start).count();
+
+  Result
+  result;
+
+  result.ns_per_point = ns / (NUM_REPEATS * WORKSET_SIZE * num_pts);
+
+  std::cout << label << ": " << result.ns_per_point << " ns/point\n";
+
+  PHX::MDField<ScalarT, Cell, QuadPoint, Dim, Dim>
+  stress((*fnm)["Cauchy_Stress"], dl->qp_tensor);
+
+  field_manager.getFieldData<ScalarT, Jacobian, Cell, QuadPoint, Dim, Dim>(
+      stress);
+
+  for (int cell = 0; cell < WORKSET_SIZE; ++cell) {
+    for (int pt = 0; pt < num_pts; ++pt) {
+      for (int i = 0; i < num_dims; ++i) {
+        for (int j = 0; j < num_dims; ++j) {
+          result.stress.push_back(stress(cell, pt, i, j));
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+//
+// The runtime dimension and the static dimension paths must give the same
+// stresses and derivatives.
+//
+void
+compareDimensionPaths(
+    Teuchos::ParameterList const & material,
+    int const num_dims,
+    std::string const & label)
+{
+  Result const
+  dynamic = evaluateModel(material, num_dims, false, label + " dynamic");
+
+  Result const
+  fixed = evaluateModel(material, num_dims, true, label + " static ");
+
+  ASSERT_EQ(dynamic.stress.size(), fixed.stress.size());
+  ASSERT_GT(dynamic.stress.size(), 0u);
+
+  for (std::size_t k = 0; k < dynamic.stress.size(); ++k) {
+    ScalarT const &
+    d = dynamic.stress[k];
+
+    ScalarT const &
+    f = fixed.stress[k];
+
+    ASSERT_NEAR(d.val(), f.val(), 1.0e-10 * (1.0 + std::abs(d.val())));
+    ASSERT_EQ(d.size(), f.size());
+    for (int i = 0; i < d.size(); ++i) {
+      ASSERT_NEAR(d.dx(i), f.dx(i), 1.0e-10 * (1.0 + std::abs(d.dx(i))));
+    }
+  }
+}
+
+Teuchos::Array<RealType>
+vector3(RealType const x, RealType const y, RealType const z)
+{
+  return Teuchos::Array<RealType>(Teuchos::tuple<RealType>(x, y, z));
+}
+
+Teuchos::ParameterList
+neohookeanParameters()
+{
+  Teuchos::ParameterList
+  p("Neohookean");
+
+  p.sublist("Material Model").set<std::string>("Model Name", "Neohookean");
+  p.sublist("Elastic Modulus").set<RealType>("Value", 200.0e3);
+  p.sublist("Poissons Ratio").set<RealType>("Value", 0.3);
+
+  return p;
+}
+
+//
+// The yield strength is low enough that every point yields.
+//
+Teuchos::ParameterList
+j2Parameters()
+{
+  Teuchos::ParameterList
+  p("J2");
+
+  p.sublist("Material Model").set<std::string>("Model Name", "J2");
+  p.sublist("Elastic Modulus").set<RealType>("Value", 200.0e3);
+  p.sublist("Poissons Ratio").set<RealType>("Value", 0.3);
+  p.sublist("Yield Strength").set<RealType>("Value", 100.0);
+  p.sublist("Hardening Modulus").set<RealType>("Value", 1.0e3);
+
+  return p;
+}
+
+//
+// FCC crystal with the 12 {111}<110> slip systems, as in
+// examples/LCM/CrystalPlasticity/MinisolverStep.
+//
+Teuchos::ParameterList
+crystalPlasticityParameters()
+{
+  Teuchos::ParameterList
+  p("FCC");
+
+  p.sublist("Material Model").set<std::string>(
+      "Model Name", "CrystalPlasticity");
+
+  Teuchos::ParameterList &
+  elasticity = p.sublist("Crystal Elasticity");
+
+  elasticity.set<RealType>("C11", 204.6e3);
+  elasticity.set<RealType>("C12", 137.7e3);
+  elasticity.set<RealType>("C44", 126.2e3);
+  elasticity.set("Basis Vector 1", vector3(1.0, 0.0, 0.0));
+  elasticity.set("Basis Vector 2", vector3(0.0, 1.0, 0.0));
+  elasticity.set("Basis Vector 3", vector3(0.0, 0.0, 1.0));
+
+  p.set<std::string>("Integration Scheme", "Implicit");
+  p.set<std::string>("Nonlinear Solver Step Type", "Newton");
+  p.set<RealType>("Implicit Integration Relative Tolerance", 1.0e-35);
+  p.set<RealType>("Implicit Integration Absolute Tolerance", 1.0e-12);
+  p.set<int>("Implicit Integration Max Iterations", 100);
+
+  Teuchos::ParameterList &
+  family = p.sublist("Slip System Family 0");
+
+  family.sublist("Flow Rule").set<std::string>("Type", "Power Law");
+  family.sublist("Flow Rule").set<RealType>("Reference Slip Rate", 1.0);
+  family.sublist("Flow Rule").set<RealType>("Rate Exponent", 20.0);
+  family.sublist("Hardening Law").set<std::string>(
+      "Type", "Linear Minus Recovery");
+  family.sublist("Hardening Law").set<RealType>("Hardening Modulus", 355.0);
+  family.sublist("Hardening Law").set<RealType>("Recovery Modulus", 2.9);
+  family.sublist("Hardening Law").set<RealType>(
+      "Initial Hardening State", 122.0);
+
+  RealType const
+  directions[12][3] = {
+      {-1.0, 1.0, 0.0}, {0.0, -1.0, 1.0}, {1.0, 0.0, -1.0},
+      {-1.0, -1.0, 0.0}, {1.0, 0.0, 1.0}, {0.0, 1.0, -1.0},
+      {1.0, -1.0, 0.0}, {0.0, 1.0, 1.0}, {-1.0, 0.0, -1.0},
+      {1.0, 1.0, 0.0}, {-1.0, 0.0, 1.0}, {0.0, -1.0, -1.0}};
+
+  RealType const
+  normals[4][3] = {
+      {1.0, 1.0, 1.0}, {-1.0, 1.0, 1.0}, {-1.0, -1.0, 1.0}, {1.0, -1.0, 1.0}};
+
+  p.set<int>("Number of Slip Systems", 12);
+  for (int ss = 0; ss < 12; ++ss) {
+    Teuchos::ParameterList &
+    slip_system = p.sublist(Albany::strint("Slip System", ss + 1));
+
+    slip_system.set("Slip Direction",
+        vector3(directions[ss][0], directions[ss][1], directions[ss][2]));
+    slip_system.set("Slip Normal",
+        vector3(normals[ss / 3][0], normals[ss / 3][1], normals[ss / 3][2]));
+  }
+
+  return p;
+}
+
+TEST(ConstitutiveKernels, Neohookean2D)
+{
+  compareDimensionPaths(neohookeanParameters(), 2, "Neohookean 2D");
+}
+
+TEST(ConstitutiveKernels, Neohookean3D)
+{
+  compareDimensionPaths(neohookeanParameters(), 3, "Neohookean 3D");
+}
+
+TEST(ConstitutiveKernels, J2_2D)
+{
+  compareDimensionPaths(j2Parameters(), 2, "J2 2D");
+}
+
+TEST(ConstitutiveKernels, J2_3D)
+{
+  compareDimensionPaths(j2Parameters(), 3, "J2 3D");
+}
+
+TEST(ConstitutiveKernels, CrystalPlasticity3D)
+{
+  Result const
+  result = evaluateModel(crystalPlasticityParameters(), 3, true,
+      "CrystalPlasticity 3D");
+
+  ASSERT_GT(result.stress.size(), 0u);
+}
+
+} // anonymous namespace
+
+int
+main(int ac, char * av[])
+{
+  Teuchos::GlobalMPISession
+  mpi_session(&ac, &av);
+
+  Kokkos::initialize();
+
+  ::testing::InitGoogleTest(&ac, av);
+
+  int const
+  retval = RUN_ALL_TESTS();
+
+  Kokkos::finalize();
+
+  return retval;
+}
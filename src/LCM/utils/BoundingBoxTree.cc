@@ -0,0 +1,198 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include <algorithm>
+#include <limits>
+
+#include "BoundingBoxTree.h"
+
+namespace LCM
+{
+
+namespace
+{
+
+// Objects per leaf
+constexpr int
+LEAF_SIZE{8};
+
+} // anonymous namespace
+
+//
+//
+//
+BoundingBoxTree::
+BoundingBoxTree() : dimension_(0)
+{
+  return;
+}
+
+//
+//
+//
+void
+BoundingBoxTree::
+build(std::vector<double> const & boxes, int const dimension)
+{
+  dimension_ = dimension;
+
+  boxes_ = boxes;
+
+  nodes_.clear();
+  node_boxes_.clear();
+
+  int const
+  number_objects = boxes.size() / (2 * dimension);
+
+  objects_.resize(number_objects);
+
+  for (int i = 0; i < number_objects; ++i) {
+    objects_[i] = i;
+  }
+
+  if (number_objects > 0) {
+    buildNode(boxes, 0, number_objects);
+  }
+
+  return;
+}
+
+//
+// Build the node covering objects_[begin, end) and return its index.
+//
+int
+BoundingBoxTree::
+buildNode(std::vector<double> const & boxes, int const begin, int const end)
+{
+  int const
+  dimension = dimension_;
+
+  int const
+  index = nodes_.size();
+
+  nodes_.push_back(Node{begin, end, -1, -1});
+
+  // Box of this node
+  double const
+  big = std::numeric_limits<double>::max();
+
+  node_boxes_.insert(node_boxes_.end(), dimension, big);
+  node_boxes_.insert(node_boxes_.end(), dimension, -big);
+
+  double * const
+  box = &node_boxes_[2 * dimension * index];
+
+  for (int i = begin; i < end; ++i) {
+    double const * const
+    object_box = &boxes[2 * dimension * objects_[i]];
+
+    for (int j = 0; j < dimension; ++j) {
+      box[j] = std::min(box[j], object_box[j]);
+      box[dimension + j] = std::max(box[dimension + j], object_box[dimension + j]);
+    }
+  }
+
+  if (end - begin <= LEAF_SIZE) return index;
+
+  // Split at the median of the box centers along the longest axis.
+  int
+  axis = 0;
+
+  for (int j = 1; j < dimension; ++j) {
+    if (box[dimension + j] - box[j] > box[dimension + axis] - box[axis]) {
+      axis = j;
+    }
+  }
+
+  int const
+  middle = begin + (end - begin) / 2;
+
+  auto
+  center = [&](int const object) {
+    double const * const
+    object_box = &boxes[2 * dimension * object];
+    return object_box[axis] + object_box[dimension + axis];
+  };
+
+  std::nth_element(
+      objects_.begin() + begin,
+      objects_.begin() + middle,
+      objects_.begin() + end,
+      [&](int const a, int const b) {return center(a) < center(b);});
+
+  int const
+  left = buildNode(boxes, begin, middle);
+
+  int const
+  right = buildNode(boxes, middle, end);
+
+  nodes_[index].left = left;
+  nodes_[index].right = right;
+
+  return index;
+}
+
+//
+//
+//
+bool
+BoundingBoxTree::
+contains(double const * const box, double const * const point) const
+{
+  for (int j = 0; j < dimension_; ++j) {
+    if (point[j] < box[j] || point[j] > box[dimension_ + j]) return false;
+  }
+  return true;
+}
+
+//
+//
+//
+void
+BoundingBoxTree::
+query(double const * const point, std::vector<int> & objects) const
+{
+  objects.clear();
+
+  if (empty() == true) return;
+
+  std::vector<int>
+  stack(1, 0);
+
+  while (stack.empty() == false) {
+    int const
+    index = stack.back();
+
+    stack.pop_back();
+
+    Node const &
+    node = nodes_[index];
+
+    if (contains(&node_boxes_[2 * dimension_ * index], point) == false) {
+      continue;
+    }
+
+    if (node.left < 0) {
+      for (int i = node.begin; i < node.end; ++i) {
+        int const
+        object = objects_[i];
+
+        if (contains(&boxes_[2 * dimension_ * object], point) == true) {
+          objects.push_back(object);
+        }
+      }
+    } else {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+  }
+
+  std::sort(objects.begin(), objects.end());
+
+  return;
+}
+
+} // namespace LCM
@@ -0,0 +1,85 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#if !defined(LCM_BoundingBoxTree_h)
+#define LCM_BoundingBoxTree_h
+
+#include <vector>
+
+namespace LCM
+{
+
+///
+/// Hierarchy of axis-aligned bounding boxes over a set of objects,
+/// e.g. mesh elements. Returns the objects whose boxes contain a point.
+///
+class BoundingBoxTree
+{
+public:
+
+  BoundingBoxTree();
+
+  ///
+  /// Build the tree. For object i, boxes holds the lower corner followed
+  /// by the upper corner at offset 2 * dimension * i.
+  ///
+  void
+  build(std::vector<double> const & boxes, int const dimension);
+
+  ///
+  /// Indices, in increasing order, of the objects whose boxes contain
+  /// the point.
+  ///
+  void
+  query(double const * const point, std::vector<int> & objects) const;
+
+  bool
+  empty() const
+  {
+    return nodes_.empty();
+  }
+
+private:
+
+  struct Node
+  {
+    // range of objects_ covered by this node
+    int begin;
+    int end;
+
+    // children, -1 for leaves
+    int left;
+    int right;
+  };
+
+  int
+  buildNode(std::vector<double> const & boxes, int const begin, int const end);
+
+  bool
+  contains(double const * const box, double const * const point) const;
+
+  int
+  dimension_;
+
+  // lower and upper corners of the box of each object
+  std::vector<double>
+  boxes_;
+
+  std::vector<Node>
+  nodes_;
+
+  // lower and upper corners of the box of each node
+  std::vector<double>
+  node_boxes_;
+
+  // object indices, permuted so that each node covers a contiguous range
+  std::vector<int>
+  objects_;
+};
+
+} // namespace LCM
+
+#endif // LCM_BoundingBoxTree_h
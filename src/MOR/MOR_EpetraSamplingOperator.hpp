@@ -45,6 +45,9 @@ public:
   virtual bool HasNormInf() const;
   virtual double NormInf() const;
 
+  // Sorted local indices of the sampled entries
+  Teuchos::ArrayView<const int> sampleLIDs() const { return sampleLIDs_(); }
+
 private:
   Epetra_Map map_;
   Teuchos::Array<int> sampleLIDs_;
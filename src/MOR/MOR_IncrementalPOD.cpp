@@ -0,0 +1,248 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include "MOR_IncrementalPOD.hpp"
+
+#include "MOR_MultiVectorOutputFile.hpp"
+
+#include "Epetra_LocalMap.h"
+#include "Epetra_LAPACK.h"
+#include "Epetra_SerialDenseMatrix.h"
+
+#include "Teuchos_TestForException.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace MOR {
+
+using Teuchos::RCP;
+using Teuchos::rcp;
+
+IncrementalPOD::IncrementalPOD(
+    int blockSize,
+    int maxBasisSize,
+    double energyTolerance,
+    const RCP<MultiVectorOutputFile> &basisFile,
+    const RCP<MultiVectorOutputFile> &singularValuesFile) :
+  blockSize_(blockSize),
+  maxBasisSize_(maxBasisSize),
+  energyTolerance_(energyTolerance),
+  basisFile_(basisFile),
+  singularValuesFile_(singularValuesFile),
+  totalEnergy_(0.0),
+  pendingCount_(0)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      blockSize <= 0,
+      std::out_of_range,
+      "blockSize = " << blockSize << ", should have blockSize > 0");
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      maxBasisSize <= 0,
+      std::out_of_range,
+      "maxBasisSize = " << maxBasisSize << ", should have maxBasisSize > 0");
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      energyTolerance < 0.0,
+      std::out_of_range,
+      "energyTolerance = " << energyTolerance << ", should have energyTolerance >= 0");
+}
+
+void IncrementalPOD::addSnapshot(const Epetra_Vector &snapshot)
+{
+  // The basis is built on the map of the first snapshot
+  const Epetra_BlockMap *basisMap =
+    nonnull(basis_) ? &basis_->Map() : (nonnull(pending_) ? &pending_->Map() : NULL);
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      basisMap != NULL && !snapshot.Map().SameAs(*basisMap),
+      std::invalid_argument,
+      "snapshot map differs from the map of the previous snapshots");
+
+  if (pending_.is_null()) {
+    pending_ = rcp(new Epetra_MultiVector(snapshot.Map(), blockSize_, false));
+  }
+
+  *(*pending_)(pendingCount_) = snapshot;
+  ++pendingCount_;
+
+  if (pendingCount_ == blockSize_) {
+    this->flush();
+  }
+}
+
+void IncrementalPOD::flush()
+{
+  if (pendingCount_ == 0) {
+    return;
+  }
+
+  if (pendingCount_ == pending_->NumVectors()) {
+    this->update(*pending_);
+  } else {
+    const Epetra_MultiVector partialBlock(View, *pending_, 0, pendingCount_);
+    this->update(partialBlock);
+  }
+  pendingCount_ = 0;
+}
+
+void IncrementalPOD::write()
+{
+  this->flush();
+
+  if (basis_.is_null()) {
+    return;
+  }
+
+  basisFile_->write(*basis_);
+
+  const Epetra_LocalMap valueMap(static_cast<int>(singularValues_.size()), 0, basis_->Comm());
+  Epetra_Vector values(valueMap, false);
+  for (int i = 0; i < values.MyLength(); ++i) {
+    values[i] = singularValues_[i];
+  }
+  singularValuesFile_->write(values);
+}
+
+double IncrementalPOD::discardedEnergyFraction() const
+{
+  if (totalEnergy_ <= 0.0) {
+    return 0.0;
+  }
+
+  double capturedEnergy = 0.0;
+  for (int i = 0; i < singularValues_.size(); ++i) {
+    capturedEnergy += singularValues_[i] * singularValues_[i];
+  }
+  return std::sqrt(std::max(0.0, (totalEnergy_ - capturedEnergy) / totalEnergy_));
+}
+
+void IncrementalPOD::update(const Epetra_MultiVector &block)
+{
+  const Epetra_Comm &comm = block.Comm();
+  const int k = basis_.is_null() ? 0 : basis_->NumVectors();
+  const int b = block.NumVectors();
+
+  Teuchos::Array<double> blockNorms(b);
+  block.Norm2(blockNorms.getRawPtr());
+  for (int j = 0; j < b; ++j) {
+    totalEnergy_ += blockNorms[j] * blockNorms[j];
+  }
+
+  // P <- U^T C and residual <- C - U P, with a second Gram-Schmidt pass
+  // to recover the orthogonality lost to cancellation
+  Epetra_MultiVector residual(block);
+  RCP<Epetra_MultiVector> projection;
+  if (k > 0) {
+    const Epetra_LocalMap basisCoeffMap(k, 0, comm);
+    projection = rcp(new Epetra_MultiVector(basisCoeffMap, b, true));
+    Epetra_MultiVector correction(basisCoeffMap, b, false);
+    for (int pass = 0; pass < 2; ++pass) {
+      correction.Multiply('T', 'N', 1.0, *basis_, residual, 0.0);
+      residual.Multiply('N', 'N', -1.0, *basis_, correction, 1.0);
+      projection->Update(1.0, correction, 1.0);
+    }
+  }
+
+  // J R <- residual (modified Gram-Schmidt, J overwrites residual)
+  // Columns already in the span of the basis and of the previous columns are zeroed
+  const double rankTolerance = 1.0e-10;
+  Epetra_SerialDenseMatrix R(b, b);
+  for (int j = 0; j < b; ++j) {
+    Epetra_Vector &column = *residual(j);
+    for (int i = 0; i < j; ++i) {
+      double r_ij;
+      column.Dot(*residual(i), &r_ij);
+      R(i, j) = r_ij;
+      column.Update(-r_ij, *residual(i), 1.0);
+    }
+    double r_jj;
+    column.Norm2(&r_jj);
+    if (r_jj > rankTolerance * blockNorms[j]) {
+      column.Scale(1.0 / r_jj);
+      R(j, j) = r_jj;
+    } else {
+      column.PutScalar(0.0);
+    }
+  }
+
+  // K <- [S P; 0 R]
+  const int m = k + b;
+  Epetra_SerialDenseMatrix K(m, m);
+  for (int i = 0; i < k; ++i) {
+    K(i, i) = singularValues_[i];
+    for (int j = 0; j < b; ++j) {
+      K(i, k + j) = (*projection)[j][i];
+    }
+  }
+  for (int i = 0; i < b; ++i) {
+    for (int j = i; j < b; ++j) {
+      K(k + i, k + j) = R(i, j);
+    }
+  }
+
+  // K = U_K S_K V_K^T, only U_K and S_K are needed
+  Teuchos::Array<double> s(m);
+  Epetra_SerialDenseMatrix U_K(m, m);
+  int lwork = 5 * m;
+  Teuchos::Array<double> work(lwork);
+  double unusedVT;
+  int info = 0;
+  Epetra_LAPACK().GESVD('A', 'N', m, m, K.A(), K.LDA(), s.getRawPtr(),
+                        U_K.A(), U_K.LDA(), &unusedVT, 1,
+                        work.getRawPtr(), &lwork, &info);
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      info != 0,
+      std::runtime_error,
+      "SVD of the incremental POD update failed, info = " << info);
+
+  const int rank = this->truncatedRank(s());
+  if (rank == 0) {
+    // Only zero snapshots so far
+    basis_ = Teuchos::null;
+    singularValues_.clear();
+    return;
+  }
+
+  // U <- [U J] U_K(:, 0:rank)
+  const RCP<Epetra_MultiVector> newBasis = rcp(new Epetra_MultiVector(block.Map(), rank, false));
+  if (k > 0) {
+    const Epetra_LocalMap basisCoeffMap(k, 0, comm);
+    const Epetra_MultiVector basisCoeffs(View, basisCoeffMap, U_K.A(), U_K.LDA(), rank);
+    newBasis->Multiply('N', 'N', 1.0, *basis_, basisCoeffs, 0.0);
+  }
+  const Epetra_LocalMap blockCoeffMap(b, 0, comm);
+  const Epetra_MultiVector blockCoeffs(View, blockCoeffMap, U_K.A() + k, U_K.LDA(), rank);
+  newBasis->Multiply('N', 'N', 1.0, residual, blockCoeffs, k > 0 ? 1.0 : 0.0);
+
+  basis_ = newBasis;
+  singularValues_.assign(s.begin(), s.begin() + rank);
+}
+
+int IncrementalPOD::truncatedRank(Teuchos::ArrayView<const double> singularValues) const
+{
+  const int maxRank = std::min(static_cast<int>(singularValues.size()), maxBasisSize_);
+  if (maxRank == 0) {
+    return 0;
+  }
+
+  // Singular values are sorted in decreasing order
+  const double zeroThreshold =
+    singularValues.size() * std::numeric_limits<double>::epsilon() * singularValues[0];
+
+  int rank = 0;
+  double capturedEnergy = 0.0;
+  while (rank < maxRank && singularValues[rank] > zeroThreshold) {
+    const double discarded = std::sqrt(std::max(0.0, (totalEnergy_ - capturedEnergy) / totalEnergy_));
+    if (discarded <= energyTolerance_) {
+      break;
+    }
+    capturedEnergy += singularValues[rank] * singularValues[rank];
+    ++rank;
+  }
+  return rank;
+}
+
+} // namespace MOR
@@ -0,0 +1,77 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#ifndef MOR_INCREMENTALPOD_HPP
+#define MOR_INCREMENTALPOD_HPP
+
+#include "Epetra_MultiVector.h"
+#include "Epetra_Vector.h"
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_Array.hpp"
+#include "Teuchos_ArrayView.hpp"
+
+namespace MOR {
+
+class MultiVectorOutputFile;
+
+// Truncated thin SVD of the snapshot matrix updated as snapshots arrive
+// (M. Brand, Fast low-rank modifications of the thin singular value decomposition, 2006).
+// Snapshots are buffered into blocks of blockSize columns C and each block is folded in as
+//   [U S, C] = [U J] K, with P = U^T C, J R = C - U P (QR), K = [S P; 0 R],
+// followed by the SVD of the small matrix K. The left-singular vectors are kept up to
+// maxBasisSize and as long as the discarded energy fraction exceeds energyTolerance;
+// only the basis and the singular values are stored, never the snapshots.
+class IncrementalPOD {
+public:
+  IncrementalPOD(
+      int blockSize,
+      int maxBasisSize,
+      double energyTolerance,
+      const Teuchos::RCP<MultiVectorOutputFile> &basisFile,
+      const Teuchos::RCP<MultiVectorOutputFile> &singularValuesFile);
+
+  // Throws std::invalid_argument if the map differs from the previous snapshots
+  void addSnapshot(const Epetra_Vector &snapshot);
+
+  // Fold the pending snapshots into the decomposition
+  void flush();
+
+  // Flush, then write the basis and the singular values
+  void write();
+
+  // Null until the first block has been folded in
+  Teuchos::RCP<const Epetra_MultiVector> basis() const { return basis_; }
+  Teuchos::ArrayView<const double> singularValues() const { return singularValues_(); }
+
+  // Fraction (in the sense of computeDiscardedEnergyFractions) of the snapshot energy
+  // not captured by the current basis
+  double discardedEnergyFraction() const;
+
+private:
+  int blockSize_;
+  int maxBasisSize_;
+  double energyTolerance_;
+  Teuchos::RCP<MultiVectorOutputFile> basisFile_;
+  Teuchos::RCP<MultiVectorOutputFile> singularValuesFile_;
+
+  Teuchos::RCP<Epetra_MultiVector> basis_;
+  Teuchos::Array<double> singularValues_;
+  double totalEnergy_;
+
+  Teuchos::RCP<Epetra_MultiVector> pending_;
+  int pendingCount_;
+
+  void update(const Epetra_MultiVector &block);
+  int truncatedRank(Teuchos::ArrayView<const double> singularValues) const;
+
+  // Disallow copy and assignment
+  IncrementalPOD(const IncrementalPOD &);
+  IncrementalPOD &operator=(const IncrementalPOD &);
+};
+
+} // namespace MOR
+
+#endif /* MOR_INCREMENTALPOD_HPP */
@@ -7,6 +7,7 @@
 
 #include "MOR_MultiVectorOutputFile.hpp"
 #include "MOR_MultiVectorOutputFileFactory.hpp"
+#include "MOR_IncrementalPOD.hpp"
 #include "MOR_ReducedSpace.hpp"
 #include "MOR_ReducedSpaceFactory.hpp"
 
@@ -74,6 +75,29 @@ int getSnapshotPeriod(const RCP<ParameterList> &params)
   return params->get("Period", 1);
 }
 
+RCP<ParameterList> getIncrementalPODParameters(const RCP<ParameterList> &snapParams)
+{
+  return sublist(snapParams, "Incremental POD");
+}
+
+bool useIncrementalPOD(const RCP<ParameterList> &snapParams)
+{
+  return getIncrementalPODParameters(snapParams)->get("Activate", false);
+}
+
+RCP<IncrementalPOD> createIncrementalPOD(const RCP<ParameterList> &snapParams)
+{
+  const RCP<ParameterList> params = getIncrementalPODParameters(snapParams);
+  const int blockSize = params->get("Block Size", 4);
+  const int maxBasisSize = params->get("Maximum Basis Size", 100);
+  const double energyTolerance = params->get("Discarded Energy Tolerance", 1.0e-6);
+  const RCP<MultiVectorOutputFile> basisFile =
+    createOutputFile(fillDefaultOutputParams(sublist(params, "Basis Output"), "basis"));
+  const RCP<MultiVectorOutputFile> singularValuesFile =
+    createOutputFile(fillDefaultOutputParams(sublist(params, "Singular Values Output"), "singular_values"));
+  return rcp(new IncrementalPOD(blockSize, maxBasisSize, energyTolerance, basisFile, singularValuesFile));
+}
+
 std::string getGeneralizedCoordinatesFilename(const RCP<ParameterList> &params)
 {
   return params->get("Generalized Coordinates Output File Name", "generalized_coordinates.mtx");
@@ -104,9 +128,14 @@ RCP<NOX::Epetra::Observer> ObserverFactory::create(const RCP<NOX::Epetra::Observ
 
     if (this->collectSnapshots()) {
       const RCP<ParameterList> params = this->getSnapParameters();
-      const RCP<MultiVectorOutputFile> snapOutputFile = createSnapshotOutputFile(params);
       const int period = getSnapshotPeriod(params);
-      composite->addObserver(rcp(new SnapshotCollectionObserver(period, snapOutputFile)));
+      if (useIncrementalPOD(params)) {
+        const RCP<IncrementalPOD> incrementalPOD = createIncrementalPOD(params);
+        composite->addObserver(rcp(new SnapshotCollectionObserver(period, incrementalPOD)));
+      } else {
+        const RCP<MultiVectorOutputFile> snapOutputFile = createSnapshotOutputFile(params);
+        composite->addObserver(rcp(new SnapshotCollectionObserver(period, snapOutputFile)));
+      }
     }
 
     if (this->computeProjectionError()) {
@@ -155,9 +184,14 @@ RCP<Rythmos::IntegrationObserverBase<double> > ObserverFactory::create(const RCP
 
     if (this->collectSnapshots()) {
       const RCP<ParameterList> params = this->getSnapParameters();
-      const RCP<MultiVectorOutputFile> snapOutputFile = createSnapshotOutputFile(params);
       const int period = getSnapshotPeriod(params);
-      composite->addObserver(rcp(new RythmosSnapshotCollectionObserver(period, snapOutputFile)));
+      if (useIncrementalPOD(params)) {
+        const RCP<IncrementalPOD> incrementalPOD = createIncrementalPOD(params);
+        composite->addObserver(rcp(new RythmosSnapshotCollectionObserver(period, incrementalPOD)));
+      } else {
+        const RCP<MultiVectorOutputFile> snapOutputFile = createSnapshotOutputFile(params);
+        composite->addObserver(rcp(new RythmosSnapshotCollectionObserver(period, snapOutputFile)));
+      }
       ++observersInComposite;
     }
 
@@ -32,7 +32,9 @@ ReducedOrderModelEvaluator::ReducedOrderModelEvaluator(const RCP<EpetraExt::Mode
   solutionSpace_(solutionSpace),
   reducedOpFactory_(reducedOpFactory),
   x_init_(null),
-  x_dot_init_(null)
+  x_dot_init_(null),
+  fullResidual_(null),
+  fullJacobian_(null)
 {
   reset_x_and_x_dot_init();
 }
@@ -297,14 +299,18 @@ void ReducedOrderModelEvaluator::evalModel(const InArgs &inArgs, const OutArgs &
     // Prepare reduced residual (f_r)
     if (requestedResidual) {
       const Evaluation<Epetra_Vector> f_r = outArgs.get_f();
-      const Evaluation<Epetra_Vector> f(
-          rcp(new Epetra_Vector(*fullOrderModel_->get_f_map(), false)),
-          f_r.getType());
+      if (is_null(fullResidual_)) {
+        fullResidual_ = rcp(new Epetra_Vector(*fullOrderModel_->get_f_map(), false));
+      }
+      const Evaluation<Epetra_Vector> f(fullResidual_, f_r.getType());
       fullOutArgs.set_f(f);
     }
 
     if (fullJacobianRequired) {
-      fullOutArgs.set_W(fullOrderModel_->create_W());
+      if (is_null(fullJacobian_)) {
+        fullJacobian_ = fullOrderModel_->create_W();
+      }
+      fullOutArgs.set_W(fullJacobian_);
     }
 
     // Prepare reduced sensitivities DgDx_r (Only mv with gradient orientation is supported)
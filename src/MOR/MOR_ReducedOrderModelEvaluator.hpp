@@ -67,6 +67,10 @@ private:
   Teuchos::RCP<Epetra_Vector> x_init_;
   Teuchos::RCP<Epetra_Vector> x_dot_init_;
 
+  // Full-order residual and Jacobian, allocated on first use and refilled by each evaluation
+  mutable Teuchos::RCP<Epetra_Vector> fullResidual_;
+  mutable Teuchos::RCP<Epetra_Operator> fullJacobian_;
+
   // Disallow copy and assignment
   ReducedOrderModelEvaluator(const ReducedOrderModelEvaluator &);
   ReducedOrderModelEvaluator &operator=(const ReducedOrderModelEvaluator &);
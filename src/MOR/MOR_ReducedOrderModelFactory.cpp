@@ -15,6 +15,7 @@
 #include "MOR_ReducedOrderModelEvaluator.hpp"
 #include "MOR_PetrovGalerkinOperatorFactory.hpp"
 #include "MOR_GaussNewtonOperatorFactory.hpp"
+#include "MOR_EpetraSamplingOperator.hpp"
 
 #include "MOR_ContainerUtils.hpp"
 
@@ -38,7 +39,8 @@ ReducedOrderModelFactory::ReducedOrderModelFactory(
     const Teuchos::RCP<ReducedSpaceFactory> &spaceFactory,
     const RCP<ParameterList> &parentParams) :
   spaceFactory_(spaceFactory),
-  params_(extractModelOrderReductionParams(parentParams))
+  params_(extractModelOrderReductionParams(parentParams)),
+  restrictAssembly_(false)
 {
   // Nothing to do
 }
@@ -69,6 +71,21 @@ RCP<EpetraExt::ModelEvaluator> ReducedOrderModelFactory::create(const RCP<Epetra
     const RCP<const ReducedSpace> reducedSpace = spaceFactory_->create(romParams);
     const RCP<const Epetra_MultiVector> basis = spaceFactory_->getBasis(romParams);
 
+    // With collocation, both projections only read the sampled rows of the full-order
+    // residual and Jacobian: the full-order model may skip assembling the other rows
+    restrictAssembly_ = sublist(romParams, "Hyper Reduction")->get("Restrict Assembly To Sample", false);
+    assemblySample_.clear();
+    if (restrictAssembly_) {
+      const RCP<const EpetraSamplingOperator> samplingOperator =
+        Teuchos::rcp_dynamic_cast<const EpetraSamplingOperator>(
+            spaceFactory_->getSamplingOperator(romParams, *child->get_x_map()));
+      TEUCHOS_TEST_FOR_EXCEPTION(Teuchos::is_null(samplingOperator),
+                                 std::logic_error,
+                                 "Restrict Assembly To Sample requires an active Collocation hyper-reduction");
+      const Teuchos::ArrayView<const int> sampleLIDs = samplingOperator->sampleLIDs();
+      assemblySample_.assign(sampleLIDs.begin(), sampleLIDs.end());
+    }
+
     if (projectionType == allowedProjectionTypes[0]) {
       const RCP<const Epetra_MultiVector> projector = spaceFactory_->getProjector(romParams);
       const RCP<ReducedOperatorFactory> opFactory(new PetrovGalerkinOperatorFactory(basis, projector));
@@ -93,6 +110,16 @@ RCP<EpetraExt::ModelEvaluator> ReducedOrderModelFactory::create(const RCP<Epetra
   return result;
 }
 
+bool ReducedOrderModelFactory::assemblyRestrictedToSample() const
+{
+  return restrictAssembly_;
+}
+
+Teuchos::ArrayView<const int> ReducedOrderModelFactory::getAssemblySample() const
+{
+  return assemblySample_();
+}
+
 bool ReducedOrderModelFactory::useReducedOrderModel() const
 {
   return extractReducedOrderModelParams(params_)->get("Activate", false);
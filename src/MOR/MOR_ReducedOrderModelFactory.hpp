@@ -10,6 +10,7 @@
 
 #include "Teuchos_RCP.hpp"
 #include "Teuchos_ParameterList.hpp"
+#include "Teuchos_Array.hpp"
 
 class Epetra_MultiVector;
 class Epetra_Map;
@@ -26,10 +27,20 @@ public:
 
   Teuchos::RCP<EpetraExt::ModelEvaluator> create(const Teuchos::RCP<EpetraExt::ModelEvaluator> &child);
 
+  // True if the last created model only needs the full-order residual and Jacobian
+  // at the sample entries (hyper-reduction with "Restrict Assembly To Sample")
+  bool assemblyRestrictedToSample() const;
+
+  // Sample entries (local indices in the full-order state map) of the last created model
+  Teuchos::ArrayView<const int> getAssemblySample() const;
+
 private:
   Teuchos::RCP<ReducedSpaceFactory> spaceFactory_;
   Teuchos::RCP<Teuchos::ParameterList> params_;
 
+  bool restrictAssembly_;
+  Teuchos::Array<int> assemblySample_;
+
   static Teuchos::RCP<Teuchos::ParameterList> extractModelOrderReductionParams(const Teuchos::RCP<Teuchos::ParameterList> &source);
   static Teuchos::RCP<Teuchos::ParameterList> extractReducedOrderModelParams(const Teuchos::RCP<Teuchos::ParameterList> &source);
 
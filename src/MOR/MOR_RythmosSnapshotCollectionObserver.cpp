@@ -28,6 +28,14 @@ RythmosSnapshotCollectionObserver::RythmosSnapshotCollectionObserver(
   // Nothing to do
 }
 
+RythmosSnapshotCollectionObserver::RythmosSnapshotCollectionObserver(
+    int period,
+    Teuchos::RCP<IncrementalPOD> incrementalPOD) :
+  snapshotCollector_(period, incrementalPOD)
+{
+  // Nothing to do
+}
+
 RCP<Rythmos::IntegrationObserverBase<double> > RythmosSnapshotCollectionObserver::cloneIntegrationObserver() const {
   return Teuchos::null; // TODO
 }
@@ -66,4 +74,9 @@ void RythmosSnapshotCollectionObserver::observeCompletedTimeStep(
   this->observeTimeStep(stepper);
 }
 
+void RythmosSnapshotCollectionObserver::observeEndTimeIntegration(
+    const Rythmos::StepperBase<double> &/*stepper*/) {
+  snapshotCollector_.writeIncrementalPOD();
+}
+
 } // namespace MOR
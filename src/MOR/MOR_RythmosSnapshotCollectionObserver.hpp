@@ -13,6 +13,7 @@
 namespace MOR {
 
 class MultiVectorOutputFile;
+class IncrementalPOD;
 
 class RythmosSnapshotCollectionObserver : public Rythmos::IntegrationObserverBase<double> {
 public:
@@ -20,6 +21,10 @@ public:
       int period,
       Teuchos::RCP<MultiVectorOutputFile> snapshotFile);
 
+  RythmosSnapshotCollectionObserver(
+      int period,
+      Teuchos::RCP<IncrementalPOD> incrementalPOD);
+
   // Overridden
   virtual Teuchos::RCP<Rythmos::IntegrationObserverBase<double> > cloneIntegrationObserver() const;
 
@@ -33,6 +38,9 @@ public:
     const Rythmos::StepControlInfo<double> &stepCtrlInfo,
     const int timeStepIter);
 
+  virtual void observeEndTimeIntegration(
+      const Rythmos::StepperBase<double> &stepper);
+
 private:
   SnapshotCollection snapshotCollector_;
 
@@ -6,9 +6,11 @@
 #include "MOR_SnapshotCollection.hpp"
 
 #include "MOR_MultiVectorOutputFile.hpp"
+#include "MOR_IncrementalPOD.hpp"
 
 #include "Teuchos_TestForException.hpp"
 
+#include <iostream>
 #include <stdexcept>
 
 namespace MOR {
@@ -18,6 +20,21 @@ SnapshotCollection::SnapshotCollection(
     const Teuchos::RCP<MultiVectorOutputFile> &snapshotFile) :
   period_(period),
   snapshotFile_(snapshotFile),
+  incrementalPODWritten_(false),
+  skipCount_(0)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      period <= 0,
+      std::out_of_range,
+      "period = " << period << ", should have period > 0");
+}
+
+SnapshotCollection::SnapshotCollection(
+    int period,
+    const Teuchos::RCP<IncrementalPOD> &incrementalPOD) :
+  period_(period),
+  incrementalPOD_(incrementalPOD),
+  incrementalPODWritten_(false),
   skipCount_(0)
 {
   TEUCHOS_TEST_FOR_EXCEPTION(
@@ -29,6 +46,28 @@ SnapshotCollection::SnapshotCollection(
 // TODO: Avoid doing real work in destructor
 SnapshotCollection::~SnapshotCollection()
 {
+  if (Teuchos::nonnull(incrementalPOD_))
+  {
+    // Observers without an end-of-run hook get here: do not throw
+    if (!incrementalPODWritten_)
+    {
+      try
+      {
+        incrementalPOD_->write();
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "MOR::SnapshotCollection: writing the incremental POD failed: "
+                  << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "MOR::SnapshotCollection: writing the incremental POD failed" << std::endl;
+      }
+    }
+    return;
+  }
+
   const int vectorCount = snapshots_.size();
   if (vectorCount > 0)
   {
@@ -48,8 +87,16 @@ void SnapshotCollection::addVector(double stamp, const Epetra_Vector &value)
 {
   if (skipCount_ == 0)
   {
-    stamps_.push_back(stamp);
-    snapshots_.push_back(value);
+    if (Teuchos::nonnull(incrementalPOD_))
+    {
+      incrementalPOD_->addSnapshot(value);
+      incrementalPODWritten_ = false;
+    }
+    else
+    {
+      stamps_.push_back(stamp);
+      snapshots_.push_back(value);
+    }
     skipCount_ = period_ - 1;
   }
   else
@@ -58,4 +105,13 @@ void SnapshotCollection::addVector(double stamp, const Epetra_Vector &value)
   }
 }
 
+void SnapshotCollection::writeIncrementalPOD()
+{
+  if (Teuchos::nonnull(incrementalPOD_))
+  {
+    incrementalPOD_->write();
+    incrementalPODWritten_ = true;
+  }
+}
+
 } // namespace MOR
@@ -15,6 +15,7 @@
 namespace MOR {
 
 class MultiVectorOutputFile;
+class IncrementalPOD;
 
 class SnapshotCollection {
 public:
@@ -22,12 +23,24 @@ public:
       int period,
       const Teuchos::RCP<MultiVectorOutputFile> &snapshotFile);
 
+  // Feed the selected snapshots to an online POD instead of storing them
+  SnapshotCollection(
+      int period,
+      const Teuchos::RCP<IncrementalPOD> &incrementalPOD);
+
   ~SnapshotCollection();
   void addVector(double stamp, const Epetra_Vector &value);
 
+  // Write the online POD at the end of the run; the destructor only writes it
+  // if this was not called after the last snapshot, and reports failures
+  // instead of throwing
+  void writeIncrementalPOD();
+
 private:
   int period_;
   Teuchos::RCP<MultiVectorOutputFile> snapshotFile_;
+  Teuchos::RCP<IncrementalPOD> incrementalPOD_;
+  bool incrementalPODWritten_;
 
   int skipCount_;
   std::deque<double> stamps_;
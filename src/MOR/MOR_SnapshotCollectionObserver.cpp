@@ -15,6 +15,14 @@ SnapshotCollectionObserver::SnapshotCollectionObserver(
    // Nothing to do
 }
 
+SnapshotCollectionObserver::SnapshotCollectionObserver(
+    int period,
+    const Teuchos::RCP<IncrementalPOD> &incrementalPOD) :
+  snapshotCollector_(period, incrementalPOD)
+{
+   // Nothing to do
+}
+
 void SnapshotCollectionObserver::observeSolution(const Epetra_Vector& solution)
 {
   snapshotCollector_.addVector(0.0, solution);
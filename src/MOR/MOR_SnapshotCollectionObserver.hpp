@@ -15,6 +15,7 @@
 namespace MOR {
 
 class MultiVectorOutputFile;
+class IncrementalPOD;
 
 class SnapshotCollectionObserver : public NOX::Epetra::Observer
 {
@@ -23,6 +24,10 @@ public:
       int period,
       const Teuchos::RCP<MultiVectorOutputFile> &snapshotFile);
 
+  SnapshotCollectionObserver(
+      int period,
+      const Teuchos::RCP<IncrementalPOD> &incrementalPOD);
+
   virtual void observeSolution(const Epetra_Vector& solution);
   virtual void observeSolution(const Epetra_Vector& solution, double time_or_param_val);
 
@@ -0,0 +1,139 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include "MOR_IncrementalPOD.hpp"
+
+#include "Epetra_ConfigDefs.h"
+#include "Epetra_Map.h"
+#ifdef EPETRA_MPI
+#include "Epetra_MpiComm.h"
+#else
+#include "Epetra_SerialComm.h"
+#endif
+
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_LAPACK.hpp"
+#include "Teuchos_UnitTestHarness.hpp"
+#include "Teuchos_UnitTestRepository.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const int rowCount = 30;
+const int snapshotCount = 7;
+
+// Entry (row, col) of a well-conditioned snapshot matrix with distinct
+// singular values
+double snapshotEntry(int row, int col)
+{
+  return std::sin(0.37 * (row + 1) * (col + 1)) + (row == col ? 2.0 * (col + 1) : 0.0);
+}
+
+Teuchos::RCP<const Epetra_Comm> createComm()
+{
+#ifdef EPETRA_MPI
+  return Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+#else
+  return Teuchos::rcp(new Epetra_SerialComm);
+#endif
+}
+
+// Check the online decomposition of the snapshot matrix, fed in blocks of
+// blockSize columns, against the thin SVD computed at once by LAPACK
+void checkAgainstOfflineSVD(
+    int blockSize,
+    Teuchos::FancyOStream &out,
+    bool &success)
+{
+  const Teuchos::RCP<const Epetra_Comm> comm = createComm();
+  const Epetra_Map map(rowCount, 0, *comm);
+
+  MOR::IncrementalPOD pod(blockSize, snapshotCount, 0.0, Teuchos::null, Teuchos::null);
+  for (int col = 0; col < snapshotCount; ++col) {
+    Epetra_Vector snapshot(map, false);
+    for (int i = 0; i < map.NumMyElements(); ++i) {
+      snapshot[i] = snapshotEntry(map.GID(i), col);
+    }
+    pod.addSnapshot(snapshot);
+  }
+  pod.flush();
+
+  // Offline SVD of the replicated snapshot matrix
+  std::vector<double> a(rowCount * snapshotCount);
+  for (int col = 0; col < snapshotCount; ++col) {
+    for (int row = 0; row < rowCount; ++row) {
+      a[row + rowCount * col] = snapshotEntry(row, col);
+    }
+  }
+  std::vector<double> s(snapshotCount), u(rowCount * snapshotCount);
+  double vt;
+  const int lwork = 5 * (rowCount + snapshotCount);
+  std::vector<double> work(lwork), rwork(5 * snapshotCount);
+  int info;
+  Teuchos::LAPACK<int, double>().GESVD(
+      'S', 'N', rowCount, snapshotCount, &a[0], rowCount, &s[0],
+      &u[0], rowCount, &vt, 1, &work[0], lwork, &rwork[0], &info);
+  TEST_EQUALITY_CONST(info, 0);
+
+  // Same singular values
+  const Teuchos::ArrayView<const double> singularValues = pod.singularValues();
+  TEST_EQUALITY(static_cast<int>(singularValues.size()), snapshotCount);
+  for (int k = 0; k < std::min<int>(singularValues.size(), snapshotCount); ++k) {
+    TEST_FLOATING_EQUALITY(singularValues[k], s[k], 1.0e-10);
+  }
+
+  // Same left singular vectors, up to their signs
+  const Teuchos::RCP<const Epetra_MultiVector> basis = pod.basis();
+  TEST_ASSERT(Teuchos::nonnull(basis));
+  if (Teuchos::is_null(basis)) return;
+  TEST_EQUALITY(basis->NumVectors(), snapshotCount);
+
+  Epetra_MultiVector reference(map, snapshotCount, false);
+  for (int k = 0; k < snapshotCount; ++k) {
+    for (int i = 0; i < map.NumMyElements(); ++i) {
+      reference[k][i] = u[map.GID(i) + rowCount * k];
+    }
+  }
+  std::vector<double> dots(snapshotCount);
+  basis->Dot(reference, &dots[0]);
+  for (int k = 0; k < snapshotCount; ++k) {
+    TEST_FLOATING_EQUALITY(std::abs(dots[k]), 1.0, 1.0e-10);
+  }
+}
+
+} // anonymous namespace
+
+TEUCHOS_UNIT_TEST(MOR_IncrementalPOD, SingleBlockMatchesOfflineSVD)
+{
+  checkAgainstOfflineSVD(snapshotCount, out, success);
+}
+
+TEUCHOS_UNIT_TEST(MOR_IncrementalPOD, BrandUpdatesMatchOfflineSVD)
+{
+  // Two full blocks, then a partial one folded in by flush()
+  checkAgainstOfflineSVD(3, out, success);
+}
+
+TEUCHOS_UNIT_TEST(MOR_IncrementalPOD, RejectsSnapshotsOnAnotherMap)
+{
+  const Teuchos::RCP<const Epetra_Comm> comm = createComm();
+  const Epetra_Map map(rowCount, 0, *comm);
+  const Epetra_Map otherMap(rowCount + 1, 0, *comm);
+
+  MOR::IncrementalPOD pod(2, snapshotCount, 0.0, Teuchos::null, Teuchos::null);
+  Epetra_Vector snapshot(map, true);
+  snapshot.PutScalar(1.0);
+  pod.addSnapshot(snapshot);
+  TEST_THROW(pod.addSnapshot(Epetra_Vector(otherMap, true)), std::invalid_argument);
+}
+
+int main(int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
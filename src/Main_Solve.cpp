@@ -11,6 +11,7 @@
 #include "Albany_Utils.hpp"
 #include "Albany_SolverFactory.hpp"
 #include "Albany_Memory.hpp"
+#include "utility/PerformanceContext.hpp"
 
 #include "Piro_PerformSolve.hpp"
 #include "Teuchos_ParameterList.hpp"
@@ -287,6 +288,18 @@ int main(int argc, char *argv[]) {
     if (debugParams.get<bool>("Analyze Memory", false))
       Albany::printMemoryAnalysis(std::cout, comm);
 
+    // Statistics of the instrumented fills ("Performance Monitoring")
+    util::PerformanceContext& perfContext = util::PerformanceContext::instance();
+    if (perfContext.enabled()) {
+      const std::string perfFile = debugParams.get("Performance Summary File", "");
+      const std::string perfFormat = debugParams.get("Performance Summary Format", "JSON");
+      if (perfFile.empty())
+        perfContext.summarizeAll(comm.ptr(), *out);
+      else
+        perfContext.summarizeAll(comm.ptr(), perfFile,
+                                 util::PerformanceContext::summaryFormat(perfFormat));
+    }
+
     if (writeToMatrixMarketSoln == true) { 
 
       //create serial map that puts the whole solution on processor 0
@@ -9,6 +9,31 @@
 
 namespace PHAL {
 
+namespace {
+// With a static FadType, the element derivative dimension must equal the
+// SFad size or fit in the SLFad capacity.
+int checkStaticFadSize (const int ddim, const Albany::MeshSpecsStruct* ms)
+{
+#if defined(ALBANY_STATIC_FAD)
+  TEUCHOS_TEST_FOR_EXCEPTION(
+    ddim != ALBANY_STATIC_FAD_SIZE, std::logic_error,
+    "Element block " << ms->ebName << " (" << ms->ctd.name << ") needs "
+    << ddim << " derivative components, but FadType is SFad<"
+    << ALBANY_STATIC_FAD_SIZE << ">, which has exactly "
+    << ALBANY_STATIC_FAD_SIZE << ". Reconfigure with SFAD_SIZE = " << ddim
+    << ", or with ENABLE_SLFAD if the element blocks need different sizes.\n");
+#elif defined(ALBANY_FAST_FELIX)
+  TEUCHOS_TEST_FOR_EXCEPTION(
+    ddim > ALBANY_SLFAD_SIZE, std::logic_error,
+    "Element block " << ms->ebName << " (" << ms->ctd.name << ") needs "
+    << ddim << " derivative components, but FadType is SLFad<"
+    << ALBANY_SLFAD_SIZE << ">. Reconfigure with SLFAD_SIZE >= " << ddim
+    << ".\n");
+#endif
+  return ddim;
+}
+}
+
 template<> int getDerivativeDimensions<PHAL::AlbanyTraits::Jacobian> (
   const Albany::Application* app, const Albany::MeshSpecsStruct* ms)
 {
@@ -20,10 +45,11 @@ template<> int getDerivativeDimensions<PHAL::AlbanyTraits::Jacobian> (
         int side_node_count = ms->ctd.side[2].topology->node_count;
         int node_count = ms->ctd.node_count;
         int numLevels = app->getDiscretization()->getLayeredMeshNumbering()->numLayers+1;
-        return app->getNumEquations()*(node_count + side_node_count*numLevels);
+        return checkStaticFadSize(
+          app->getNumEquations()*(node_count + side_node_count*numLevels), ms);
       }
   }
-  return app->getNumEquations() * ms->ctd.node_count;
+  return checkStaticFadSize(app->getNumEquations() * ms->ctd.node_count, ms);
 }
 
 template<> int getDerivativeDimensions<PHAL::AlbanyTraits::Tangent> (
@@ -50,7 +76,9 @@ template<> int getDerivativeDimensions<PHAL::AlbanyTraits::Jacobian> (
       int side_node_count = app->getEnrichedMeshSpecs()[ebi].get()->ctd.side[2].topology->node_count;
       int node_count = app->getEnrichedMeshSpecs()[ebi].get()->ctd.node_count;
       int numLevels = app->getDiscretization()->getLayeredMeshNumbering()->numLayers+1;
-      return app->getNumEquations()*(node_count + side_node_count*numLevels);
+      return checkStaticFadSize(
+        app->getNumEquations()*(node_count + side_node_count*numLevels),
+        app->getEnrichedMeshSpecs()[ebi].get());
     }
 #ifdef ALBANY_AERAS
     if ((problemName == "Aeras Hydrostatic")  && (explicit_scheme == true))
@@ -52,7 +52,8 @@ namespace PHAL {
 struct Workset {
 
   Workset() :
-    transientTerms(false), accelerationTerms(false), ignore_residual(false) {}
+    transientTerms(false), accelerationTerms(false), ignore_residual(false),
+    is_adjoint(false), scatter_by_offsets(false) {}
 
   unsigned int numCells;
   unsigned int wsIndex;
@@ -215,6 +216,11 @@ struct Workset {
   // either the Jacobian or the transpose of the Jacobian is scattered.
   bool is_adjoint;
 
+  // Flag indicating whether ScatterResidual<Jacobian> writes directly into
+  // the values of JacT's local matrix using precomputed CSR offsets instead
+  // of calling sumIntoLocalValues (which searches the row) per entry.
+  bool scatter_by_offsets;
+
   // New field manager response stuff
   Teuchos::RCP<const Teuchos::Comm<int> > comm;
 #if defined(ALBANY_EPETRA)
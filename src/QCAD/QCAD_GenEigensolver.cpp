@@ -33,6 +33,8 @@
 #include "AnasaziEpetraAdapter.hpp"
 #include "Epetra_CrsMatrix.h"
 
+#include <algorithm>
+
 
 
 QCAD::GenEigensolver::
@@ -60,6 +62,7 @@ GenEigensolver(const Teuchos::RCP<Teuchos::ParameterList>& eigensolveParams,
   blockSize = myParams->get<int>("Block Size",5);
   maxIters = myParams->get<int>("Maximum Iterations",500);
   conv_tol = myParams->get<double>("Convergece Tolerance",1.0e-8);
+  bReuseEigenvectors = myParams->get<bool>("Reuse Eigenvectors",false);
 
   myComm = comm;
 }
@@ -185,6 +188,14 @@ QCAD::GenEigensolver::evalModel(const InArgs& inArgs,
   Teuchos::RCP<Epetra_MultiVector> ivec = Teuchos::rcp( new Epetra_MultiVector(K->OperatorDomainMap(), blockSize) );
   ivec->Random();
 
+  // Warm start: when K and M change only slightly between evaluations (e.g. successive
+  //  Schrodinger solves of a Poisson-Schrodinger loop) the last eigenvectors are a much
+  //  better initial subspace than random vectors.  Columns beyond them stay random.
+  if(bReuseEigenvectors && lastEvecs != Teuchos::null && lastEvecs->Map().SameAs(ivec->Map())) {
+    int nReused = std::min(blockSize, lastEvecs->NumVectors());
+    for(int i=0; i<nReused; i++) *((*ivec)(i)) = *((*lastEvecs)(i));
+  }
+
   // Create the eigenproblem.
   Teuchos::RCP<Anasazi::BasicEigenproblem<double, MV, OP> > eigenProblem =
     Teuchos::rcp( new Anasazi::BasicEigenproblem<double, MV, OP>(K, M, ivec) );
@@ -222,6 +233,9 @@ QCAD::GenEigensolver::evalModel(const InArgs& inArgs,
   std::vector<Anasazi::Value<double> > evals = sol.Evals;
   Teuchos::RCP<MV> evecs = sol.Evecs;
 
+  if(bReuseEigenvectors && sol.numVecs > 0)
+    lastEvecs = Teuchos::rcp( new Epetra_MultiVector(*evecs) );
+
   std::vector<double> evals_real(sol.numVecs);
   for(int i=0; i<sol.numVecs; i++) evals_real[i] = evals[i].realpart;
 
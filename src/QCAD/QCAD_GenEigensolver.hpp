@@ -74,6 +74,10 @@ namespace QCAD {
     std::string which;
     int nev, blockSize, maxIters;
     double conv_tol;
+
+    //Eigenvectors of the last solve, used as the initial subspace of the next one
+    bool bReuseEigenvectors;
+    mutable Teuchos::RCP<Epetra_MultiVector> lastEvecs;
   };
 }
 #endif
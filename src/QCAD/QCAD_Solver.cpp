@@ -34,6 +34,11 @@ Please remove when issue is resolved
 #include "Albany_StateInfoStruct.hpp"
 #include "Albany_EigendataInfoStruct.hpp"
 
+#include "Epetra_SerialDenseMatrix.h"
+#include "Epetra_SerialDenseSolver.h"
+
+#include <deque>
+
 #ifdef ALBANY_CI
 #include "AnasaziConfigDefs.hpp"
 #include "AnasaziBasicEigenproblem.hpp"
@@ -44,6 +49,15 @@ Please remove when issue is resolved
 
 
 namespace QCAD {
+
+  // Iteration history of Anderson density mixing: differences between successive input
+  //  densities and between successive density residuals (output - input), oldest first
+  struct AndersonHistory {
+    std::deque<std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > > dInDensity;
+    std::deque<std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > > dResidual;
+    std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > lastInDensity;
+    std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > lastResidual;
+  };
   
   void SolveModel(const SolverSubSolver& ss);
   void SolveModel(const SolverSubSolver& ss, 
@@ -89,6 +103,13 @@ namespace QCAD {
 			    std::string stateName);
   double getNorm2(std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& container, const Teuchos::RCP<const Epetra_Comm>& comm);
   int getElementCount(std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& container);
+  void SubtractContainers(std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& a,
+			  std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& b,
+			  std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& dest); // dest = a - b
+  void AndersonMixDensity(std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& inDensity,
+			  std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& outDensity,
+			  AndersonHistory& history, int depth, double mixingFactor, const Teuchos::RCP<const Epetra_Comm>& comm,
+			  std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& mixedDensity);
   
   void ResetEigensolverShift(const Teuchos::RCP<EpetraExt::ModelEvaluator>& Solver, double newShift,
 			     Teuchos::RCP<Teuchos::ParameterList>& eigList);
@@ -111,7 +132,8 @@ QCAD::Solver::
 Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
        const Teuchos::RCP<const Epetra_Comm>& comm,
        const Teuchos::RCP<const Epetra_Vector>& initial_guess) :
-  maxIter(0),ps_converge_tol(1e-6)
+  maxIter(0),ps_converge_tol(1e-6),bReusePSPoisson(false),bCachedPSPoisson(false),
+  andersonDepth(0),andersonMixingFactor(1.0)
 {
   using std::string;
 
@@ -156,6 +178,12 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
     shiftPercentBelowMin = problemParams.get<double>("Eigensolver Percent Shift Below Potential Min", 1.0);
     ps_converge_tol = problemParams.get<double>("Iterative PS Convergence Tolerance", 1e-6);
     fixedPSOcc = problemParams.get<double>("Iterative PS Fixed Occupation", -1.0);
+    bReusePSPoisson = problemParams.get<bool>("Iterative PS Reuse Poisson Solver", false);
+    andersonDepth = problemParams.get<int>("Iterative PS Anderson Depth", 0);
+    andersonMixingFactor = problemParams.get<double>("Iterative PS Anderson Mixing Factor", 0.5);
+    TEUCHOS_TEST_FOR_EXCEPTION(andersonDepth < 0 || andersonMixingFactor <= 0.0 || andersonMixingFactor > 1.0,
+        Teuchos::Exceptions::InvalidParameter, std::endl << "Error!  Iterative PS Anderson Depth must be >= 0 and "
+        << "Iterative PS Anderson Mixing Factor must be in (0,1]" << std::endl);
   }
 
   // Get problem parameters used for Poisson-Schrodinger-CI mode
@@ -1801,9 +1829,22 @@ bool QCAD::Solver::doPSLoop(const std::string& mode, const InArgs& inArgs,
   subSolvers[ "Schrodinger" ] = CreateSubSolver( "Schrodinger", getSubSolverParams("Schrodinger") , *solverComm); // no initial guess
   fillSingleSubSolverParams(inArgs, "Schrodinger", subSolvers[ "Schrodinger" ]);
   
-  //Create Poisson solver & fill its parameters.  Initialize with the solution from the InitPoisson solver
-  Teuchos::RCP<Epetra_Vector> initial_solnVec = subSolvers["InitPoisson"].responses_out->get_g(1); //get the *first* response vector (solution)
-  subSolvers[ "Poisson" ] = CreateSubSolver( "Poisson", getSubSolverParams("Poisson") , *solverComm,  initial_solnVec);
+  //Create Poisson solver & fill its parameters.  Initialize with the solution from the InitPoisson solver,
+  // unless the Poisson solver of a previous P-S loop is cached: its nonlinear solver then continues from
+  // the last self-consistent potential, which is closer to the solution than the initial Poisson one.
+  if(bReusePSPoisson && bCachedPSPoisson && !bDiscretizationDependsOnParameters) {
+    if(bVerbose) *out << "QCAD Solve: Reusing Poisson solver of the previous Poisson-Schrodinger loop" << std::endl;
+    subSolvers[ "Poisson" ] = CreateSubSolver( "Poisson", getSubSolverParams("Poisson") , *solverComm);
+  }
+  else {
+    Teuchos::RCP<Epetra_Vector> initial_solnVec = subSolvers["InitPoisson"].responses_out->get_g(1); //get the *first* response vector (solution)
+    subSolvers[ "Poisson" ] = CreateSubSolver( "Poisson", getSubSolverParams("Poisson") , *solverComm,  initial_solnVec);
+    if(bReusePSPoisson && !bDiscretizationDependsOnParameters) {
+      persistent_subSolvers[ "Poisson" ].app = subSolvers[ "Poisson" ].app;
+      persistent_subSolvers[ "Poisson" ].model = subSolvers[ "Poisson" ].model;
+      bCachedPSPoisson = true;
+    }
+  }
   fillSingleSubSolverParams(inArgs, "Poisson", subSolvers[ "Poisson" ]);  
 
   if(bVerbose) *out << "QCAD Solve: Beginning Poisson-Schrodinger solve loop" << std::endl;
@@ -1818,6 +1859,11 @@ bool QCAD::Solver::doPSLoop(const std::string& mode, const InArgs& inArgs,
   double damping = 0;
   int consecutiveAccepts = 0;
   const int MIN_ITER = 2;
+
+  // Anderson mixing replaces the step-size controlled linear mixing of "mix" mode
+  const bool bAnderson = (mode == "mix" && andersonDepth > 0);
+  QCAD::AndersonHistory andersonHistory;
+  std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > outDensity;
     
   Teuchos::RCP<Teuchos::ParameterList> eigList; //used to hold memory I think - maybe unneeded?
 
@@ -1901,7 +1947,7 @@ bool QCAD::Solver::doPSLoop(const std::string& mode, const InArgs& inArgs,
 	  stepAccepted = true;
 	}
 
-	else if(mode == "mix" && stepSize/STEP_DIVISOR >= minStep) {
+	else if(mode == "mix" && !bAnderson && stepSize/STEP_DIVISOR >= minStep) {
 	  //reduce step size -> new trial density based on mixing with last accepted step
 	  if(bVerbose) *out << "QCAD Solve: Step size " << stepSize << " rejected.  Diff=" 
 			    << global_maxDiff << " (tol=" << ps_converge_tol << ")" << std::endl;
@@ -1936,7 +1982,21 @@ bool QCAD::Solver::doPSLoop(const std::string& mode, const InArgs& inArgs,
       else consecutiveAccepts = 0;
 
 
-      if(mode == "mix" && stepSize+1e-6 < 1.0) {
+      if(bAnderson) {
+	// New trial density from the densities and residuals of the last andersonDepth iterations
+	QCAD::CopyStateToContainer(*pStatesToLoop, "PS Saved Electron Density", outDensity);
+	QCAD::AndersonMixDensity(trialDensity, outDensity, andersonHistory, andersonDepth, andersonMixingFactor,
+				 solverComm, mixDensity);
+	QCAD::CopyContainerToState(mixDensity, *pStatesToPass, "PS Previous Electron Density");
+	QCAD::SetPreviousDensityMixing(subSolvers["Poisson"].params_in, 1.0);
+
+	// Poisson Solve using the Anderson-mixed density
+	if(bVerbose) *out << "QCAD Solve: Poisson Anderson mix iteration " << iter 
+			  << " (history = " << andersonHistory.dResidual.size() << ")" << std::endl;
+	QCAD::SolveModel(subSolvers["Poisson"], pStatesToPass, pStatesToLoop,
+			 eigenDataResult, eigenDataNull);
+      }
+      else if(mode == "mix" && stepSize+1e-6 < 1.0) {
 
 	  // Set mixing based on step size: new trial density = (1-2*stepSize)*acceptedDensity + 2*stepSize * ( trialDensity + currentDensity )/2.0
 	  //  (factors of 2 so that first mixing step (stepSize = 0.5) just gives average of initial trial density and it's resulting density)
@@ -2360,6 +2420,9 @@ QCAD::Solver::getValidProblemParameters() const
   validPL->set<double>("Eigensolver Percent Shift Below Potential Min", 1.0, "Percentage of energy range of potential to subtract from the potential's minimum to obtain the eigensolver's shift");
   validPL->set<double>("Iterative PS Convergence Tolerance", 1e-6, "Convergence criterion for iterative PS solver (max potential difference across mesh)");
   validPL->set<double>("Iterative PS Fixed Occupation", -1.0, "Fixed quantum orbital occupation for iterative PS solver (non equilibrium condition)");
+  validPL->set<bool>("Iterative PS Reuse Poisson Solver", false, "Keep the Poisson solver of an iterative PS loop and continue from its last solution in the next loop (i.e. the next evaluation)");
+  validPL->set<int>("Iterative PS Anderson Depth", 0, "Number of previous iterations used for Anderson (Pulay) mixing of the electron density in the iterative PS solver.  0 = step-size controlled linear mixing");
+  validPL->set<double>("Iterative PS Anderson Mixing Factor", 0.5, "Fraction of the density residual added at each Anderson mixing step (0 < factor <= 1)");
 
   validPL->set<int>("Minimum CI Particles", 0, "Poisson Schrodinger CI mode only: the minimum number of particles to use in the CI phase");
   validPL->set<int>("Maximum CI Particles", 0, "Poisson Schrodinger CI mode only: the maximum number of particles to use in the CI phase");
@@ -3622,6 +3685,117 @@ int QCAD::getElementCount(std::vector<Intrepid2::FieldContainer_Kokkos<RealType,
   return cnt;
 }
 
+// dest = a - b  (dest is allocated if necessary)
+void QCAD::SubtractContainers(std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& a,
+			      std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& b,
+			      std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& dest)
+{
+  int numWorksets = a.size();
+  std::vector<int> dims;
+
+  if(dest.size() != (unsigned int)numWorksets)
+    dest.resize(numWorksets);
+
+  for (int ws = 0; ws < numWorksets; ws++)
+  {
+    a[ws].dimensions(dims);
+    TEUCHOS_TEST_FOR_EXCEPT( dims.size() != 2 );
+    if(dest[ws].size() != a[ws].size()) dest[ws].resize(dims);
+
+    for(int cell=0; cell < dims[0]; cell++)
+      for(int qp=0; qp < dims[1]; qp++)
+	dest[ws](cell,qp) = a[ws](cell,qp) - b[ws](cell,qp);
+  }
+}
+
+// Anderson (Pulay) mixing of the electron density.  With the residual r = outDensity - inDensity
+//  and the history of input differences dX_i and residual differences dR_i, the coefficients g
+//  minimize | r - sum_i g_i dR_i |, and the next input density is
+//    mixedDensity = inDensity + mixingFactor * r - sum_i g_i (dX_i + mixingFactor * dR_i)
+//  With no history (first call) this is linear mixing with mixingFactor.
+void QCAD::AndersonMixDensity(std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& inDensity,
+			      std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& outDensity,
+			      AndersonHistory& history, int depth, double mixingFactor, const Teuchos::RCP<const Epetra_Comm>& comm,
+			      std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >& mixedDensity)
+{
+  std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > residual;
+  QCAD::SubtractContainers(outDensity, inDensity, residual);
+
+  // Update the history
+  if(history.lastInDensity.size() > 0) {
+    history.dInDensity.push_back(std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >());
+    history.dResidual.push_back(std::vector<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> >());
+    QCAD::SubtractContainers(inDensity, history.lastInDensity, history.dInDensity.back());
+    QCAD::SubtractContainers(residual, history.lastResidual, history.dResidual.back());
+    if((int)history.dResidual.size() > depth) {
+      history.dInDensity.pop_front();
+      history.dResidual.pop_front();
+    }
+  }
+  QCAD::CopyContainer(inDensity, history.lastInDensity);
+  QCAD::CopyContainer(residual, history.lastResidual);
+
+  // Linear part: mixedDensity = inDensity + mixingFactor * residual
+  QCAD::CopyContainer(inDensity, mixedDensity);
+  QCAD::AddContainerToContainer(residual, mixedDensity, mixingFactor, 1.0);
+
+  int m = history.dResidual.size();
+  if(m == 0) return;
+
+  // Local parts of the normal equations dR^T dR g = dR^T r, summed over all processors at once
+  std::vector<double> local_dots(m*(m+1)/2 + m, 0.0), global_dots(m*(m+1)/2 + m, 0.0);
+  int numWorksets = residual.size();
+  std::vector<int> dims;
+  for (int ws = 0; ws < numWorksets; ws++)
+  {
+    residual[ws].dimensions(dims);
+    for(int cell=0; cell < dims[0]; cell++) {
+      for(int qp=0; qp < dims[1]; qp++) {
+	int k = 0;
+	for(int i=0; i < m; i++) {
+	  double dRi = history.dResidual[i][ws](cell,qp);
+	  for(int j=0; j <= i; j++) local_dots[k++] += dRi * history.dResidual[j][ws](cell,qp);
+	  local_dots[m*(m+1)/2 + i] += dRi * residual[ws](cell,qp);
+	}
+      }
+    }
+  }
+  comm->SumAll(&local_dots[0], &global_dots[0], (int)global_dots.size());
+
+  Epetra_SerialDenseMatrix A(m,m), rhs(m,1), coeffs(m,1);
+  double trace = 0.0;
+  for(int i=0, k=0; i < m; i++) {
+    for(int j=0; j <= i; j++, k++) A(i,j) = A(j,i) = global_dots[k];
+    rhs(i,0) = global_dots[m*(m+1)/2 + i];
+    trace += A(i,i);
+  }
+  if(trace <= 0.0) return;
+
+  // Residual differences become nearly linearly dependent close to convergence: regularize slightly
+  for(int i=0; i < m; i++) A(i,i) += 1e-10 * trace / m;
+
+  Epetra_SerialDenseSolver solver;
+  solver.SetMatrix(A);
+  solver.SetVectors(coeffs, rhs);
+  solver.FactorWithEquilibration(true);
+  if(solver.Solve() != 0) return; // keep the linear mixing step
+
+  for(int i=0; i < m; i++) {
+    QCAD::AddContainerToContainer(history.dInDensity[i], mixedDensity, -coeffs(i,0), 1.0);
+    QCAD::AddContainerToContainer(history.dResidual[i], mixedDensity, -mixingFactor*coeffs(i,0), 1.0);
+  }
+
+  // The extrapolation can overshoot below zero where the density is small; the linear step above
+  //  cannot, as it interpolates between two non-negative densities.  Poisson needs a physical density.
+  for (int ws = 0; ws < numWorksets; ws++)
+  {
+    mixedDensity[ws].dimensions(dims);
+    for(int cell=0; cell < dims[0]; cell++)
+      for(int qp=0; qp < dims[1]; qp++)
+	mixedDensity[ws](cell,qp) = std::max(mixedDensity[ws](cell,qp), 0.0);
+  }
+}
+
 
 void QCAD::ResetEigensolverShift(const Teuchos::RCP<EpetraExt::ModelEvaluator>& Solver, double newShift, 
 			   Teuchos::RCP<Teuchos::ParameterList>& eigList) 
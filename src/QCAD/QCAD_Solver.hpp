@@ -123,7 +123,7 @@ namespace QCAD {
 			Teuchos::RCP<Teuchos::FancyOStream> out) const;
     
   private:
-    std::map<std::string, QCAD::SolverSubSolver> persistent_subSolvers;
+    mutable std::map<std::string, QCAD::SolverSubSolver> persistent_subSolvers; //mutable so the P-S loop can cache its Poisson solver
 
     int numDims;
     std::string problemNameBase;
@@ -172,6 +172,10 @@ namespace QCAD {
     int    nCIExcitations;        // the number of excitations used in CI calculation
     double fixedPSOcc;
     bool   bUseIntegratedPS;
+    bool   bReusePSPoisson;       // start the Poisson solver of each P-S loop from the one of the previous loop
+    mutable bool bCachedPSPoisson; // persistent_subSolvers["Poisson"] holds the Poisson solver of a previous P-S loop
+    int    andersonDepth;         // number of previous P-S iterations used in Anderson density mixing (0 = linear mixing)
+    double andersonMixingFactor;  // fraction of the density residual added in Anderson density mixing
     bool   bUseTotalSpinSymmetry; // use S2 symmetry in CI calculation
   };
 
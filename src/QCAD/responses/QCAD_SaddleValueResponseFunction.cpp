@@ -14,6 +14,12 @@
 #include "Tpetra_Map.hpp"
 #include "QCAD_GreensFunctionTunneling.hpp"
 #include <fstream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <queue>
 #include "Petra_Converters.hpp" 
 
 //! Helper function prototypes
@@ -1545,13 +1551,12 @@ doLevelSetT(const double current_time,
   return;
 }
 
-#if defined(ALBANY_EPETRA)
-//! Level-set Algorithm for finding saddle point
+//! Level-set Algorithm for finding saddle point: returns the index of the saddle point, or -1
 int QCAD::SaddleValueResponseFunction::
-FindSaddlePoint_LevelSet(std::vector<double>& allFieldVals,
-		std::vector<double>* allCoords, std::vector<int>& ordering,
-		double cutoffDistance, double cutoffFieldVal, double minDepth, int dbMode,
-		Epetra_Vector& g)
+findLevelSetSaddle(const std::vector<double>& allFieldVals,
+		   const std::vector<double>* allCoords, const std::vector<int>& ordering,
+		   double cutoffDistance, double cutoffFieldVal, double minDepth, int dbMode,
+		   int& nMaxTrees) const
 {
   if(dbMode) {
     std::cout << "--- Saddle Level Set: distance cutoff = " << cutoffDistance
@@ -1559,26 +1564,62 @@ FindSaddlePoint_LevelSet(std::vector<double>& allFieldVals,
 	      << ", min depth = " << minDepth << std::endl;
   }
 
-  // Walk through sorted data.  At current point, walk backward in list 
-  //  until either 1) a "close" point is found, as given by tolerance -> join to tree
-  //            or 2) the change in field value exceeds some maximium -> new tree
+  // Walk through sorted data.  Join the current point to the tree of each earlier point that is
+  //  both 1) "close", as given by cutoffDistance, and 2) within cutoffFieldVal in field value,
+  //  merging trees when there are several, or start a new tree if there are none.
+  //  - trees form a disjoint-set forest: a merged tree points to the tree it was merged into
+  //  - the earlier points are looked up in a uniform grid with cells of size cutoffDistance,
+  //    each cell listing its points in sorted order
+  //  - since the field value only increases, a tree never stops being "deep": the shallow trees
+  //    are kept in a heap by minimum field value and the deep ones are counted as they appear
   std::size_t N = allFieldVals.size();
   std::vector<int> treeIDs(N, -1);
+  std::vector<int> parentTrees; //for each tree
   std::vector<double> minFieldVals; //for each tree
   std::vector<int> treeSizes; //for each tree
+  std::vector<bool> deepTrees; //for each tree
   int nextAvailableTreeID = 0;
 
-  int nTrees = 0, nMaxTrees = 0;
-  int nDeepTrees=0, lastDeepTrees=0, treeIDtoReplace;
-  int I, J, K;
+  typedef std::pair<double,int> ValueAndTree;
+  std::priority_queue<ValueAndTree, std::vector<ValueAndTree>, std::greater<ValueAndTree> > shallowTrees;
+
+  auto findTree = [&parentTrees](int t) {
+    while(parentTrees[t] != t) {
+      parentTrees[t] = parentTrees[parentTrees[t]];
+      t = parentTrees[t];
+    }
+    return t;
+  };
+
+  // Slightly larger cells, so that rounding never puts points closer than
+  //  cutoffDistance more than one cell apart
+  typedef std::array<long long, 3> GridCell;
+  std::map<GridCell, std::vector<int> > grid;
+  std::size_t nGridDims = std::min<std::size_t>(numDims, 3);
+  double gridSpacing = cutoffDistance * (1.0 + 1e-6);
+  int nNeighborCells = 1;
+  for(std::size_t k=0; k<nGridDims; k++) nNeighborCells *= 3;
+
+  std::vector<int> neighbors;
+  int nTrees = 0;
+  int nDeepTrees=0, lastDeepTrees=0;
+  int I, J;
+  nMaxTrees = 0;
   for(std::size_t i=0; i < N; i++) {
     I = ordering[i];
 
-    if(dbMode > 1) {
-      nDeepTrees = 0;
-      for(std::size_t t=0; t < treeSizes.size(); t++) {
-	if(treeSizes[t] > 0 && (allFieldVals[I]-minFieldVals[t]) > minDepth) nDeepTrees++;
+    // trees that are deep at this field value
+    while(!shallowTrees.empty()) {
+      const ValueAndTree& top = shallowTrees.top();
+      int t = top.second;
+      if(parentTrees[t] != t || deepTrees[t] || top.first != minFieldVals[t]) { //stale entry
+	shallowTrees.pop();
+	continue;
       }
+      if((allFieldVals[I]-minFieldVals[t]) <= minDepth) break;
+      deepTrees[t] = true;
+      nDeepTrees++;
+      shallowTrees.pop();
     }
 
     if(dbMode > 3) std::cout << "DEBUG: i=" << i << "( I = " << I << "), val="
@@ -1591,75 +1632,80 @@ FindSaddlePoint_LevelSet(std::vector<double>& allFieldVals,
       lastDeepTrees = nDeepTrees;
     }
 
-    for(int j=i-1; j >= 0 && fabs(allFieldVals[I] - allFieldVals[ordering[j]]) < cutoffFieldVal; j--) {
-      J = ordering[j];
+    // close earlier points, latest first (the order of the original backward walk);
+    //  without a cutoff distance there are none and the grid is not used
+    neighbors.clear();
+    if(cutoffDistance > 0) {
+      GridCell cellI = {{0, 0, 0}};
+      for(std::size_t k=0; k<nGridDims; k++)
+	cellI[k] = static_cast<long long>(std::floor(allCoords[k][I] / gridSpacing));
+
+      for(int c=0; c < nNeighborCells; c++) {
+	GridCell cell = cellI;
+	for(std::size_t k=0, rem=c; k<nGridDims; k++, rem /= 3)
+	  cell[k] += static_cast<long long>(rem % 3) - 1;
+
+	std::map<GridCell, std::vector<int> >::const_iterator it = grid.find(cell);
+	if(it == grid.end()) continue;
+	const std::vector<int>& cellPts = it->second;
+	for(int m=cellPts.size()-1; m >= 0 && fabs(allFieldVals[I] - allFieldVals[ordering[cellPts[m]]]) < cutoffFieldVal; m--) {
+	  if( QCAD::distance(allCoords, I, ordering[cellPts[m]], numDims) < cutoffDistance )
+	    neighbors.push_back(cellPts[m]);
+	}
+      }
+      std::sort(neighbors.begin(), neighbors.end(), std::greater<int>());
 
-      if( QCAD::distance(allCoords, I, J, numDims) < cutoffDistance ) {
-	if(treeIDs[I] == -1) {
-	  treeIDs[I] = treeIDs[J];
-	  treeSizes[treeIDs[I]]++;
+      // point i is an earlier point of all the following ones
+      grid[cellI].push_back(i);
+    }
 
-	  if(dbMode > 3) std::cout << " --> tree " << treeIDs[J] 
-			       << " ( size=" << treeSizes[treeIDs[J]] << ", depth=" 
-			       << (allFieldVals[I]-minFieldVals[treeIDs[J]]) << ")" << std::endl;
-	}
-	else if(treeIDs[I] != treeIDs[J]) {
-
-	  //update number of deep trees
-	  nDeepTrees = 0;
-	  for(std::size_t t=0; t < treeSizes.size(); t++) {
-	    if(treeSizes[t] > 0 && (allFieldVals[I]-minFieldVals[t]) > minDepth) nDeepTrees++;
-	  }
-
-	  bool mergingTwoDeepTrees = false;
-	  if((allFieldVals[I]-minFieldVals[treeIDs[I]]) > minDepth && 
-	     (allFieldVals[I]-minFieldVals[treeIDs[J]]) > minDepth) {
-	    mergingTwoDeepTrees = true;
-	    nDeepTrees--;
-	  }
-
-	  treeIDtoReplace = treeIDs[I];
-	  if( minFieldVals[treeIDtoReplace] < minFieldVals[treeIDs[J]] )
-	    minFieldVals[treeIDs[J]] = minFieldVals[treeIDtoReplace];
-
-	  for(int k=i; k >=0; k--) {
-	    K = ordering[k];
-	    if(treeIDs[K] == treeIDtoReplace) {
-	      treeIDs[K] = treeIDs[J];
-	      treeSizes[treeIDs[J]]++;
-	    }
-	  }
-	  treeSizes[treeIDtoReplace] = 0;
-	  nTrees -= 1;
-
-	  if(dbMode > 3) std::cout << "DEBUG:   also --> " << treeIDs[J] 
-			       << " [merged] size=" << treeSizes[treeIDs[J]]
-			       << " (treecount after merge = " << nTrees << ")" << std::endl;
-
-	  if(dbMode > 1) std::cout << "--- Saddle: i=" << i << "merge: nPools=" << nTrees 
-				   << " nDeep=" << nDeepTrees << std::endl;
-
-
-	  if(mergingTwoDeepTrees && nDeepTrees == 1) {
-	    if(dbMode > 3) std::cout << "DEBUG: FOUND SADDLE! exiting." << std::endl;
-	    if(dbMode > 1) std::cout << "--- Saddle: i=" << i << " Found saddle at ";
-
-            //Found saddle at I
-	    g[0] = 0; //TODO - change this g[.] interface to something more readable -- and we don't use g[0] now
-            g[1] = allFieldVals[I];
-            for(std::size_t k=0; k<numDims && k < 3; k++) {
-              g[2+k] = allCoords[k][I];
-              if(dbMode > 1) std::cout << allCoords[k][I] << ", ";
-	    }
-            
-	    if(dbMode > 1) std::cout << "ret=" << g[0] << std::endl;
-            return 0; //success
-	  }
+    for(std::size_t n=0; n < neighbors.size(); n++) {
+      J = ordering[neighbors[n]];
+      int treeJ = findTree(treeIDs[J]);
 
-	}
+      if(treeIDs[I] == -1) {
+	treeIDs[I] = treeJ;
+	treeSizes[treeJ]++;
+
+	if(dbMode > 3) std::cout << " --> tree " << treeJ
+			     << " ( size=" << treeSizes[treeJ] << ", depth=" 
+			     << (allFieldVals[I]-minFieldVals[treeJ]) << ")" << std::endl;
+	continue;
+      }
+
+      int treeI = findTree(treeIDs[I]);
+      if(treeI == treeJ) continue;
+
+      bool mergingTwoDeepTrees = false;
+      if(deepTrees[treeI] && deepTrees[treeJ]) {
+	mergingTwoDeepTrees = true;
+	nDeepTrees--;
+      }
+
+      // merge the tree of I into the tree of J
+      parentTrees[treeI] = treeJ;
+      treeSizes[treeJ] += treeSizes[treeI];
+      treeSizes[treeI] = 0;
+      if(deepTrees[treeI]) deepTrees[treeJ] = true;
+      if( minFieldVals[treeI] < minFieldVals[treeJ] ) {
+	minFieldVals[treeJ] = minFieldVals[treeI];
+	if(!deepTrees[treeJ]) shallowTrees.push(ValueAndTree(minFieldVals[treeJ], treeJ));
       }
+      nTrees -= 1;
 
-    } //end j loop
+      if(dbMode > 3) std::cout << "DEBUG:   also --> " << treeJ 
+			   << " [merged] size=" << treeSizes[treeJ]
+			   << " (treecount after merge = " << nTrees << ")" << std::endl;
+
+      if(dbMode > 1) std::cout << "--- Saddle: i=" << i << "merge: nPools=" << nTrees 
+			       << " nDeep=" << nDeepTrees << std::endl;
+
+      if(mergingTwoDeepTrees && nDeepTrees == 1) {
+	if(dbMode > 3) std::cout << "DEBUG: FOUND SADDLE! exiting." << std::endl;
+	if(dbMode > 1) std::cout << "--- Saddle: i=" << i << " Found saddle at ";
+	return I;
+      }
+    } //end neighbor loop
     
     if(treeIDs[I] == -1) {
       if(dbMode > 3) std::cout << " --> new tree with ID " << nextAvailableTreeID
@@ -1668,8 +1714,11 @@ FindSaddlePoint_LevelSet(std::vector<double>& allFieldVals,
 			       << " nDeep=" << nDeepTrees << std::endl;
 
       treeIDs[I] = nextAvailableTreeID++;
+      parentTrees.push_back(treeIDs[I]);
       minFieldVals.push_back(allFieldVals[I]);
       treeSizes.push_back(1);
+      deepTrees.push_back(false);
+      shallowTrees.push(ValueAndTree(allFieldVals[I], treeIDs[I]));
 
       nTrees += 1;
       if(nTrees > nMaxTrees) nMaxTrees = nTrees;
@@ -1677,8 +1726,35 @@ FindSaddlePoint_LevelSet(std::vector<double>& allFieldVals,
 
   } // end i loop
 
-  // if no saddle found, return all zeros
   if(dbMode > 3) std::cout << "DEBUG: NO SADDLE. exiting." << std::endl;
+  return -1;
+}
+
+#if defined(ALBANY_EPETRA)
+int QCAD::SaddleValueResponseFunction::
+FindSaddlePoint_LevelSet(std::vector<double>& allFieldVals,
+		std::vector<double>* allCoords, std::vector<int>& ordering,
+		double cutoffDistance, double cutoffFieldVal, double minDepth, int dbMode,
+		Epetra_Vector& g)
+{
+  int nMaxTrees;
+  int I = findLevelSetSaddle(allFieldVals, allCoords, ordering,
+			     cutoffDistance, cutoffFieldVal, minDepth, dbMode, nMaxTrees);
+
+  if(I >= 0) {
+    //Found saddle at I
+    g[0] = 0; //TODO - change this g[.] interface to something more readable -- and we don't use g[0] now
+    g[1] = allFieldVals[I];
+    for(std::size_t k=0; k<numDims && k < 3; k++) {
+      g[2+k] = allCoords[k][I];
+      if(dbMode > 1) std::cout << allCoords[k][I] << ", ";
+    }
+    
+    if(dbMode > 1) std::cout << "ret=" << g[0] << std::endl;
+    return 0; //success
+  }
+
+  // if no saddle found, return all zeros
   for(std::size_t k=0; k<5; k++) g[k] = 0;
 
   // if two or more trees where found, then reason for failure is that not
@@ -1696,135 +1772,25 @@ FindSaddlePoint_LevelSetT(std::vector<double>& allFieldVals,
 		double cutoffDistance, double cutoffFieldVal, double minDepth, int dbMode,
 		Tpetra_Vector& gT)
 {
-  Teuchos::ArrayRCP<ST> gT_nonconstView;
-  if(dbMode) {
-    std::cout << "--- Saddle Level Set: distance cutoff = " << cutoffDistance
-	      << ", field cutoff = " << cutoffFieldVal 
-	      << ", min depth = " << minDepth << std::endl;
-  }
-
-  // Walk through sorted data.  At current point, walk backward in list 
-  //  until either 1) a "close" point is found, as given by tolerance -> join to tree
-  //            or 2) the change in field value exceeds some maximium -> new tree
-  std::size_t N = allFieldVals.size();
-  std::vector<int> treeIDs(N, -1);
-  std::vector<double> minFieldVals; //for each tree
-  std::vector<int> treeSizes; //for each tree
-  int nextAvailableTreeID = 0;
-
-  int nTrees = 0, nMaxTrees = 0;
-  int nDeepTrees=0, lastDeepTrees=0, treeIDtoReplace;
-  int I, J, K;
-  for(std::size_t i=0; i < N; i++) {
-    I = ordering[i];
-
-    if(dbMode > 1) {
-      nDeepTrees = 0;
-      for(std::size_t t=0; t < treeSizes.size(); t++) {
-	if(treeSizes[t] > 0 && (allFieldVals[I]-minFieldVals[t]) > minDepth) nDeepTrees++;
-      }
-    }
+  int nMaxTrees;
+  int I = findLevelSetSaddle(allFieldVals, allCoords, ordering,
+			     cutoffDistance, cutoffFieldVal, minDepth, dbMode, nMaxTrees);
 
-    if(dbMode > 3) std::cout << "DEBUG: i=" << i << "( I = " << I << "), val="
-			 << allFieldVals[I] << ", loc=(" << allCoords[0][I] 
-			 << "," << allCoords[1][I] << ")" << " nD=" << nDeepTrees;
-
-    if(dbMode > 1 && lastDeepTrees != nDeepTrees) {
-      std::cout << "--- Saddle: i=" << i << " new deep pool: nPools=" << nTrees 
-		<< " nDeep=" << nDeepTrees << std::endl;
-      lastDeepTrees = nDeepTrees;
+  Teuchos::ArrayRCP<ST> gT_nonconstView = gT.get1dViewNonConst();
+  if(I >= 0) {
+    //Found saddle at I
+    gT_nonconstView[0] = 0; //TODO - change this g[.] interface to something more readable -- and we don't use g[0] now
+    gT_nonconstView[1] = allFieldVals[I];
+    for(std::size_t k=0; k<numDims && k < 3; k++) {
+      gT_nonconstView[2+k] = allCoords[k][I];
+      if(dbMode > 1) std::cout << allCoords[k][I] << ", ";
     }
-
-    for(int j=i-1; j >= 0 && fabs(allFieldVals[I] - allFieldVals[ordering[j]]) < cutoffFieldVal; j--) {
-      J = ordering[j];
-
-      if( QCAD::distance(allCoords, I, J, numDims) < cutoffDistance ) {
-	if(treeIDs[I] == -1) {
-	  treeIDs[I] = treeIDs[J];
-	  treeSizes[treeIDs[I]]++;
-
-	  if(dbMode > 3) std::cout << " --> tree " << treeIDs[J] 
-			       << " ( size=" << treeSizes[treeIDs[J]] << ", depth=" 
-			       << (allFieldVals[I]-minFieldVals[treeIDs[J]]) << ")" << std::endl;
-	}
-	else if(treeIDs[I] != treeIDs[J]) {
-
-	  //update number of deep trees
-	  nDeepTrees = 0;
-	  for(std::size_t t=0; t < treeSizes.size(); t++) {
-	    if(treeSizes[t] > 0 && (allFieldVals[I]-minFieldVals[t]) > minDepth) nDeepTrees++;
-	  }
-
-	  bool mergingTwoDeepTrees = false;
-	  if((allFieldVals[I]-minFieldVals[treeIDs[I]]) > minDepth && 
-	     (allFieldVals[I]-minFieldVals[treeIDs[J]]) > minDepth) {
-	    mergingTwoDeepTrees = true;
-	    nDeepTrees--;
-	  }
-
-	  treeIDtoReplace = treeIDs[I];
-	  if( minFieldVals[treeIDtoReplace] < minFieldVals[treeIDs[J]] )
-	    minFieldVals[treeIDs[J]] = minFieldVals[treeIDtoReplace];
-
-	  for(int k=i; k >=0; k--) {
-	    K = ordering[k];
-	    if(treeIDs[K] == treeIDtoReplace) {
-	      treeIDs[K] = treeIDs[J];
-	      treeSizes[treeIDs[J]]++;
-	    }
-	  }
-	  treeSizes[treeIDtoReplace] = 0;
-	  nTrees -= 1;
-
-	  if(dbMode > 3) std::cout << "DEBUG:   also --> " << treeIDs[J] 
-			       << " [merged] size=" << treeSizes[treeIDs[J]]
-			       << " (treecount after merge = " << nTrees << ")" << std::endl;
-
-	  if(dbMode > 1) std::cout << "--- Saddle: i=" << i << "merge: nPools=" << nTrees 
-				   << " nDeep=" << nDeepTrees << std::endl;
-
-
-	  if(mergingTwoDeepTrees && nDeepTrees == 1) {
-	    if(dbMode > 3) std::cout << "DEBUG: FOUND SADDLE! exiting." << std::endl;
-	    if(dbMode > 1) std::cout << "--- Saddle: i=" << i << " Found saddle at ";
-
-            gT_nonconstView = gT.get1dViewNonConst();
-            //Found saddle at I
-	    gT_nonconstView[0] = 0; //TODO - change this g[.] interface to something more readable -- and we don't use g[0] now
-            gT_nonconstView[1] = allFieldVals[I];
-            for(std::size_t k=0; k<numDims && k < 3; k++) {
-              gT_nonconstView[2+k] = allCoords[k][I];
-              if(dbMode > 1) std::cout << allCoords[k][I] << ", ";
-	    }
-            
-	    if(dbMode > 1) std::cout << "ret=" << gT_nonconstView[0] << std::endl;
-            return 0; //success
-	  }
-
-	}
-      }
-
-    } //end j loop
     
-    if(treeIDs[I] == -1) {
-      if(dbMode > 3) std::cout << " --> new tree with ID " << nextAvailableTreeID
-			       << " (treecount after new = " << (nTrees+1) << ")" << std::endl;
-      if(dbMode > 1) std::cout << "--- Saddle: i=" << i << " new pool: nPools=" << (nTrees+1) 
-			       << " nDeep=" << nDeepTrees << std::endl;
-
-      treeIDs[I] = nextAvailableTreeID++;
-      minFieldVals.push_back(allFieldVals[I]);
-      treeSizes.push_back(1);
-
-      nTrees += 1;
-      if(nTrees > nMaxTrees) nMaxTrees = nTrees;
-    }
-
-  } // end i loop
+    if(dbMode > 1) std::cout << "ret=" << gT_nonconstView[0] << std::endl;
+    return 0; //success
+  }
 
   // if no saddle found, return all zeros
-  gT_nonconstView = gT.get1dViewNonConst();
-  if(dbMode > 3) std::cout << "DEBUG: NO SADDLE. exiting." << std::endl;
   for(std::size_t k=0; k<5; k++) gT_nonconstView[k] = 0;
 
   // if two or more trees where found, then reason for failure is that not
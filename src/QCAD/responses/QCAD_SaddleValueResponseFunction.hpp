@@ -231,6 +231,12 @@ namespace QCAD {
     void doLevelSetT(const double current_time,  const Tpetra_Vector* xdotT,
 		    const Tpetra_Vector& xT,  const Teuchos::Array<ParamVec>& p,
 		    Tpetra_Vector& gT, int dbMode);
+    //! Merges the level-set pools of the points in sorted order; returns the index
+    //!  of the saddle point, or -1 with the largest number of pools in nMaxTrees
+    int findLevelSetSaddle(const std::vector<double>& allFieldVals,
+			   const std::vector<double>* allCoords, const std::vector<int>& ordering,
+			   double cutoffDistance, double cutoffFieldVal, double minDepth, int dbMode,
+			   int& nMaxTrees) const;
 #if defined(ALBANY_EPETRA) 
     int FindSaddlePoint_LevelSet(std::vector<double>& allFieldVals,
 			     std::vector<double>* allCoords, std::vector<int>& ordering,
@@ -7,6 +7,7 @@
 #include "AAdapt_AdaptiveSolutionManagerT.hpp"
 #if defined(HAVE_STK)
 #include "AAdapt_CopyRemeshT.hpp"
+#include "AAdapt_RebalanceT.hpp"
 #if defined(ALBANY_LCM) && defined(ALBANY_BGL)
 #include "AAdapt_TopologyModificationT.hpp"
 #endif
@@ -186,6 +187,13 @@ buildAdapter(const Teuchos::RCP<rc::Manager>& rc_mgr)
         commT_));
   } else
 
+  if (method == "Rebalance") {
+    adapter_ = Teuchos::rcp(new AAdapt::RebalanceT(adaptParams_,
+        paramLib_,
+        stateMgr_,
+        commT_));
+  } else
+
 # if defined(ALBANY_LCM) && defined(ALBANY_BGL)
   if (method == "Topmod") {
     adapter_ = Teuchos::rcp(new AAdapt::TopologyModT(adaptParams_,
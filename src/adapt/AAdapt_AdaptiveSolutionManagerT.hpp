@@ -44,6 +44,12 @@ public:
 
    Teuchos::RCP<const Tpetra_MultiVector> getInitialSolution() const { return current_soln; }
 
+   Teuchos::RCP<Tpetra_MultiVector> getInitialSolution() { return current_soln; }
+
+   //! Reload the initial solution from the discretization, for callers that
+   //! write the solution field directly between solves on an unchanged mesh
+   void resetInitialSolution() { current_soln = disc_->getSolutionMV(); }
+
    Teuchos::RCP<Tpetra_MultiVector> getOverlappedSolution() { return overlapped_soln; }
 
    Teuchos::RCP<const Tpetra_MultiVector> getOverlappedSolution() const { return overlapped_soln; }
@@ -0,0 +1,115 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "AAdapt_RebalanceT.hpp"
+#include "Albany_GenericSTKMeshStruct.hpp"
+
+#include "Teuchos_TimeMonitor.hpp"
+
+namespace AAdapt {
+
+//----------------------------------------------------------------------------
+AAdapt::RebalanceT::
+RebalanceT(const Teuchos::RCP<Teuchos::ParameterList>& params,
+           const Teuchos::RCP<ParamLib>& param_lib,
+           const Albany::StateManager& state_mgr,
+           const Teuchos::RCP<const Teuchos_Comm>& comm) :
+  AAdapt::AbstractAdapterT(params, param_lib, state_mgr, comm),
+  rebalance_file_index_(1) {
+
+  stk_discretization_ =
+    static_cast<Albany::STKDiscretization*>(state_mgr_.getDiscretization().get());
+
+  generic_mesh_struct_ =
+    Teuchos::rcp_dynamic_cast<Albany::GenericSTKMeshStruct>(
+      stk_discretization_->getSTKMeshStruct());
+
+  TEUCHOS_TEST_FOR_EXCEPTION(generic_mesh_struct_.is_null() ||
+      generic_mesh_struct_->getFieldContainer()->getElementWeightField() == NULL,
+      std::logic_error,
+      "Error! Rebalance adaptation requires \"Cost-Weighted Rebalance\" "
+      "in the Discretization list" << std::endl);
+
+  imbalance_threshold_ = adapt_params_->get<double>("Imbalance Threshold", 1.2);
+  check_interval_ = adapt_params_->get<int>("Check Interval", 1);
+
+  // Save the initial output file name
+  base_exo_filename_ = stk_discretization_->getSTKMeshStruct()->exoOutFile;
+
+}
+
+//----------------------------------------------------------------------------
+AAdapt::RebalanceT::
+~RebalanceT() {
+}
+
+//----------------------------------------------------------------------------
+bool
+AAdapt::RebalanceT::queryAdaptationCriteria(int iter) {
+
+  if (teuchos_comm_->getSize() == 1 || iter % check_interval_ != 0)
+    return false;
+
+  const double imbalance = generic_mesh_struct_->measuredImbalance(teuchos_comm_);
+
+  *output_stream_ << "Measured element cost imbalance: " << imbalance << std::endl;
+
+  return imbalance > imbalance_threshold_;
+
+}
+
+//----------------------------------------------------------------------------
+bool
+AAdapt::RebalanceT::adaptMesh(){
+
+  *output_stream_ << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n";
+  *output_stream_ << "Adapting mesh using AAdapt::Rebalance method        \n";
+  *output_stream_ << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n";
+
+  // The partition changes, so results go to a new exodus file: insert the
+  // index before the extension, or append it if the name has none
+
+  std::ostringstream ss;
+  std::string str = base_exo_filename_;
+  ss << "_" << rebalance_file_index_;
+  const std::size_t dot = str.rfind('.');
+  const std::size_t slash = str.rfind('/');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    str += ss.str();
+  else
+    str.insert(dot, ss.str());
+
+  *output_stream_ << "Rebalancing: renaming output file to - " << str << std::endl;
+
+  stk_discretization_->reNameExodusOutput(str);
+
+  rebalance_file_index_++;
+
+  generic_mesh_struct_->rebalanceAdaptedMeshT(adapt_params_, teuchos_comm_);
+
+  // Throw away all the Albany data structures and re-build them
+  // from the mesh
+
+  stk_discretization_->updateMesh();
+
+  return true;
+
+}
+
+//----------------------------------------------------------------------------
+Teuchos::RCP<const Teuchos::ParameterList>
+AAdapt::RebalanceT::getValidAdapterParameters() const {
+  Teuchos::RCP<Teuchos::ParameterList> validPL =
+    this->getGenericAdapterParams("ValidRebalanceParameters");
+
+  validPL->set<double>("Imbalance Threshold", 1.2, "Rebalance when the largest rank cost exceeds this multiple of the mean");
+  validPL->set<int>("Check Interval", 1, "Step interval at which the imbalance is checked");
+  validPL->sublist("Rebalance Options", false, "Zoltan parameters used for the repartitioning");
+
+  return validPL;
+}
+//----------------------------------------------------------------------------
+}
@@ -0,0 +1,85 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#if !defined(AAdapt_RebalanceT_hpp)
+#define AAdapt_RebalanceT_hpp
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_ParameterList.hpp>
+
+#include "AAdapt_AbstractAdapterT.hpp"
+#include "Albany_STKDiscretization.hpp"
+
+namespace AAdapt {
+
+///
+/// Repartitions the STK mesh with Zoltan, weighting each element by its
+/// measured evaluation cost, when the measured load imbalance exceeds a
+/// threshold. Requires "Cost-Weighted Rebalance" in the Discretization list.
+///
+class RebalanceT : public AbstractAdapterT {
+  public:
+
+    ///
+    /// Constructor
+    ///
+    RebalanceT(const Teuchos::RCP<Teuchos::ParameterList>& params,
+               const Teuchos::RCP<ParamLib>& param_lib,
+               const Albany::StateManager& state_mgr,
+               const Teuchos::RCP<const Teuchos_Comm>& comm);
+
+    ///
+    /// Destructor
+    ///
+    ~RebalanceT();
+
+    ///
+    /// True if the measured imbalance exceeds the threshold
+    ///
+    virtual
+    bool
+    queryAdaptationCriteria(int iteration);
+
+    ///
+    /// Rebalance the mesh and rebuild the discretization
+    ///
+    virtual
+    bool
+    adaptMesh();
+
+    ///
+    /// Each adapter must generate it's list of valid parameters
+    ///
+    Teuchos::RCP<const Teuchos::ParameterList>
+    getValidAdapterParameters() const;
+
+  private:
+
+    ///
+    /// Prohibit default constructor
+    ///
+    RebalanceT();
+
+    ///
+    /// Disallow copy and assignment
+    ///
+    RebalanceT(const RebalanceT&);
+    RebalanceT& operator=(const RebalanceT&);
+
+    Albany::STKDiscretization* stk_discretization_;
+
+    Teuchos::RCP<Albany::GenericSTKMeshStruct> generic_mesh_struct_;
+
+    double imbalance_threshold_;
+    int check_interval_;
+    int rebalance_file_index_;
+    std::string base_exo_filename_;
+
+};
+
+}
+
+#endif //AAdapt_RebalanceT_hpp
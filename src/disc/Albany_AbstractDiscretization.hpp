@@ -265,6 +265,23 @@ class AbstractDiscretization {
     //! update the mesh
     virtual void updateMesh(bool shouldTransferIPData = false) = 0;
 
+    //! Version of the mesh geometry, changed whenever the coordinates or the
+    //! connectivity change. Negative if geometry-only data must not be cached.
+    virtual int getMeshVersion() const = 0;
+
+    //! Number of changes of the mesh geometry or connectivity, counted
+    //! whether or not geometry-only data is cached
+    virtual int getMeshChangeCount() const = 0;
+
+    //! Whether cached geometry-only data may be kept in single precision
+    virtual bool singlePrecisionGeometryCache() const = 0;
+
+    //! True if addWorksetCost records the element cost (cost-weighted rebalancing)
+    virtual bool measuresWorksetCost() const = 0;
+
+    //! Spread the measured evaluation time of workset ws over its elements
+    virtual void addWorksetCost(const int ws, const double seconds) = 0;
+
     //! Get Numbering for layered mesh (mesh structred in one direction)
     virtual Teuchos::RCP<LayeredMeshNumbering<LO> > getLayeredMeshNumbering() = 0;
 
@@ -0,0 +1,137 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_AsyncOutputWriter.hpp"
+
+namespace {
+
+std::mutex sharedMutex;
+std::weak_ptr<Albany::AsyncOutputWriter> sharedWriter;
+
+} // anonymous namespace
+
+Albany::AsyncOutputWriter::
+AsyncOutputWriter(std::size_t maxStagedBytes) :
+  maxStagedBytes_(maxStagedBytes),
+  stagedBytes_(0),
+  busy_(false),
+  stop_(false)
+{
+  thread_ = std::thread(&AsyncOutputWriter::run, this);
+}
+
+Albany::AsyncOutputWriter::
+~AsyncOutputWriter()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobDone_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    stop_ = true;
+  }
+  jobReady_.notify_one();
+  thread_.join();
+}
+
+void
+Albany::AsyncOutputWriter::
+submit(std::size_t stagedBytes, const Job& job)
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobDone_.wait(lock, [this, stagedBytes] {
+      return error_ || stagedBytes_ == 0 ||
+             stagedBytes_ + stagedBytes <= maxStagedBytes_;
+    });
+    rethrowError();
+
+    Entry entry;
+    entry.bytes = stagedBytes;
+    entry.job = job;
+    queue_.push_back(entry);
+    stagedBytes_ += stagedBytes;
+  }
+  jobReady_.notify_one();
+}
+
+void
+Albany::AsyncOutputWriter::
+drain()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  jobDone_.wait(lock, [this] { return queue_.empty() && !busy_; });
+  rethrowError();
+}
+
+std::shared_ptr<Albany::AsyncOutputWriter>
+Albany::AsyncOutputWriter::
+shared(std::size_t maxStagedBytes)
+{
+  std::lock_guard<std::mutex> lock(sharedMutex);
+  std::shared_ptr<AsyncOutputWriter> writer = sharedWriter.lock();
+  if (!writer) {
+    writer = std::make_shared<AsyncOutputWriter>(maxStagedBytes);
+    sharedWriter = writer;
+  }
+  return writer;
+}
+
+void
+Albany::AsyncOutputWriter::
+drainShared()
+{
+  std::shared_ptr<AsyncOutputWriter> writer;
+  {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    writer = sharedWriter.lock();
+  }
+  if (writer) writer->drain();
+}
+
+void
+Albany::AsyncOutputWriter::
+rethrowError()
+{
+  // Called with mutex_ held
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = std::exception_ptr();
+    std::rethrow_exception(error);
+  }
+}
+
+void
+Albany::AsyncOutputWriter::
+run()
+{
+  for (;;) {
+    Entry entry;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      jobReady_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      entry = queue_.front();
+      queue_.pop_front();
+      busy_ = true;
+    }
+
+    std::exception_ptr error;
+    try {
+      entry.job();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    // Release the staging memory before waking up submitters
+    entry.job = Job();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_ = false;
+      stagedBytes_ -= entry.bytes;
+      if (error && !error_) error_ = error;
+    }
+    jobDone_.notify_all();
+  }
+}
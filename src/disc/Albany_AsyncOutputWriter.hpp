@@ -0,0 +1,90 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_ASYNCOUTPUTWRITER_HPP
+#define ALBANY_ASYNCOUTPUTWRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Albany {
+
+/** \brief Runs output jobs on a dedicated I/O thread
+
+    The caller copies whatever a write needs into a staging buffer owned by
+    the job (typically captured by the std::function) and submits it with the
+    buffer size. Jobs run in submission order. The total size of the staged
+    jobs is bounded: submit() blocks until enough earlier jobs have finished
+    (back-pressure when the writer falls behind). A single job larger than
+    the bound is accepted once the queue is empty.
+
+    An exception thrown by a job is rethrown by the next submit() or drain().
+
+    The exodus and netCDF libraries are not thread safe: all the output files
+    of a process share the writer returned by shared(), and any direct call
+    into those libraries from another thread must follow drainShared().
+*/
+class AsyncOutputWriter {
+public:
+
+  typedef std::function<void()> Job;
+
+  //! maxStagedBytes bounds the staging memory of queued and running jobs
+  explicit AsyncOutputWriter(std::size_t maxStagedBytes);
+
+  //! Waits for all submitted jobs, then stops the I/O thread
+  ~AsyncOutputWriter();
+
+  //! Queue a job holding stagedBytes of staging memory
+  void submit(std::size_t stagedBytes, const Job& job);
+
+  //! Wait until all submitted jobs have finished
+  void drain();
+
+  //! The writer of the process, created on first use while nobody holds it
+  static std::shared_ptr<AsyncOutputWriter> shared(std::size_t maxStagedBytes);
+
+  //! Drain the writer of the process, if any
+  static void drainShared();
+
+private:
+
+  AsyncOutputWriter(const AsyncOutputWriter&);
+  AsyncOutputWriter& operator=(const AsyncOutputWriter&);
+
+  void run();
+
+  void rethrowError();
+
+  struct Entry {
+    std::size_t bytes;
+    Job job;
+  };
+
+  const std::size_t maxStagedBytes_;
+
+  std::mutex mutex_;
+  std::condition_variable jobReady_;
+  std::condition_variable jobDone_;
+
+  std::deque<Entry> queue_;
+  std::size_t stagedBytes_;
+  bool busy_;
+  bool stop_;
+  std::exception_ptr error_;
+
+  std::thread thread_;
+};
+
+} // namespace Albany
+
+#endif // ALBANY_ASYNCOUTPUTWRITER_HPP
@@ -173,6 +173,31 @@ bool Decorator::supportsMOR() const
   return false;
 }
 
+int Decorator::getMeshVersion() const
+{
+  return discretization->getMeshVersion();
+}
+
+int Decorator::getMeshChangeCount() const
+{
+  return discretization->getMeshChangeCount();
+}
+
+bool Decorator::singlePrecisionGeometryCache() const
+{
+  return discretization->singlePrecisionGeometryCache();
+}
+
+bool Decorator::measuresWorksetCost() const
+{
+  return discretization->measuresWorksetCost();
+}
+
+void Decorator::addWorksetCost(const int ws, const double seconds)
+{
+  discretization->addWorksetCost(ws, seconds);
+}
+
 double Decorator::restartDataTime() const
 {
   return discretization->restartDataTime();
@@ -80,6 +80,16 @@ public:
 
   virtual bool supportsMOR() const;
 
+  int getMeshVersion() const;
+
+  int getMeshChangeCount() const;
+
+  bool singlePrecisionGeometryCache() const;
+
+  bool measuresWorksetCost() const;
+
+  void addWorksetCost(const int ws, const double seconds);
+
   //! If restarting, convenience function to return restart data time
   double restartDataTime() const;
 
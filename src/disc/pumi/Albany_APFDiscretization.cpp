@@ -65,7 +65,8 @@ Albany::APFDiscretization::APFDiscretization(Teuchos::RCP<Albany::APFMeshStruct>
   meshStruct(meshStruct_),
   interleavedOrdering(meshStruct_->interleavedOrdering),
   outputInterval(0),
-  continuationStep(0)
+  continuationStep(0),
+  meshChangeCount(0)
 {
 }
 
@@ -243,6 +244,7 @@ void
 Albany::APFDiscretization::setCoordinates(
     const Teuchos::ArrayRCP<const double>& c)
 {
+  ++meshChangeCount;
   const int spdim = getNumDim();
   double buf[3] = {0};
   apf::Field* f = meshStruct->getMesh()->getCoordinateField();
@@ -1497,6 +1499,7 @@ Albany::APFDiscretization::updateMesh(bool shouldTransferIPData,
   // and then each time the mesh is adapted (called from AAdapt_MeshAdapt_Def.hpp - afterAdapt())
 
   TEUCHOS_FUNC_TIME_MONITOR("AlbanyAdapt: Transfer to Albany");
+  ++meshChangeCount;
   computeOwnedNodesAndUnknowns();
   computeOverlapNodesAndUnknowns();
   setupMLCoords();
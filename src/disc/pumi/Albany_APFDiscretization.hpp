@@ -180,6 +180,15 @@ class APFDiscretization : public Albany::AbstractDiscretization {
     //! PUMI does not support MOR
     virtual bool supportsMOR() const { return false; }
 
+    //! Geometry-only data is not cached on PUMI meshes
+    int getMeshVersion() const { return -1; }
+    int getMeshChangeCount() const { return meshChangeCount; }
+    bool singlePrecisionGeometryCache() const { return false; }
+
+    //! Cost-weighted rebalancing is STK only
+    bool measuresWorksetCost() const { return false; }
+    void addWorksetCost(const int ws, const double seconds) {}
+
     apf::GlobalNumbering* getAPFGlobalNumbering() {return elementNumbering;}
 
     // Before mesh modification, qp data may be needed for solution transfer
@@ -491,6 +500,9 @@ class APFDiscretization : public Albany::AbstractDiscretization {
     // counter for the continuation step number
     int continuationStep;
 
+    // bumped by updateMesh and setCoordinates (see getMeshChangeCount)
+    int meshChangeCount;
+
     // Mesh adaptation stuff.
     Teuchos::RCP<AAdapt::rc::Manager> rcm;
 
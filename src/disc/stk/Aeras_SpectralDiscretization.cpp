@@ -11,8 +11,10 @@
 // Standard includes
 #include <algorithm>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include <string>
 
 // Trilinos includes
@@ -86,7 +88,8 @@ SpectralDiscretization(const Teuchos::RCP<Teuchos::ParameterList>& discParams_,
   discParams(discParams_),
   neq(stkMeshStruct_->neq),
   stkMeshStruct(stkMeshStruct_),
-  interleavedOrdering(stkMeshStruct_->interleavedOrdering)
+  interleavedOrdering(stkMeshStruct_->interleavedOrdering),
+  meshVersion(0)
 {
 #ifdef OUTPUT_TO_SCREEN
   *out << "DEBUG: " << __PRETTY_FUNCTION__ << std::endl;
@@ -479,6 +482,7 @@ Aeras::SpectralDiscretization::transformMesh()
 #ifdef OUTPUT_TO_SCREEN
   *out << "DEBUG: " << __PRETTY_FUNCTION__ << std::endl;
 #endif
+  ++meshVersion;
   using std::cout; using std::endl;
   Albany::AbstractSTKFieldContainer::VectorFieldType* coordinates_field = stkMeshStruct->getCoordinatesField();
   std::string transformType = stkMeshStruct->transformType;
@@ -670,6 +674,7 @@ Aeras::SpectralDiscretization::writeSolution(
     Teuchos::RCP<Albany::AbstractSTKFieldContainer> container = outputStkMeshStruct->getFieldContainer();
 
     container->transferSolutionToCoords();
+    ++meshVersion;
 
     if (!mesh_data.is_null())
     {
@@ -774,6 +779,7 @@ Aeras::SpectralDiscretization::writeSolutionToFileT(const Tpetra_Vector& solnT,
    Teuchos::RCP<Albany::AbstractSTKFieldContainer> container =
      outputStkMeshStruct->getFieldContainer();
    container->transferSolutionToCoords();
+   ++meshVersion;
 
    if (!mesh_data.is_null()) {
      // Mesh coordinates have changed. Rewrite output file by deleting
@@ -828,6 +834,7 @@ Aeras::SpectralDiscretization::writeSolutionMVToFile(const Tpetra_MultiVector& s
    Teuchos::RCP<Albany::AbstractSTKFieldContainer> container =
      outputStkMeshStruct->getFieldContainer();
    container->transferSolutionToCoords();
+   ++meshVersion;
 
    if (!mesh_data.is_null()) {
      // Mesh coordinates have changed. Rewrite output file by deleting
@@ -3164,85 +3171,219 @@ bool point_inside(const Teuchos::ArrayRCP<double*> &coords,
     return ref;
   }
 
-  const std::pair<bool,std::pair<unsigned, unsigned> >
-  point_in_element(
-    const std::pair<double, double> &sphere,
-    const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords,
-    std::pair<double, double> &parametric)
+  //! Range of output grid indices that can fall inside an element. The
+  //! element lies in the spherical cap centered at its corner centroid that
+  //! reaches its farthest corner; the cap is converted to a lat/lon box.
+  //! Longitude indices [j0,j1] may run past either end and wrap around nlon.
+  void element_latlon_range(const Teuchos::ArrayRCP<double*> &coords,
+                            const unsigned nlat, const unsigned nlon,
+                            int &i0, int &i1, int &j0, int &j1)
   {
-    const std::vector<double> sphere_xyz = spherical_to_cart(sphere);
-    std::pair<bool,std::pair<unsigned, unsigned> >
-      element(false,
-              std::pair<unsigned, unsigned>(0,0));
-    for (unsigned i = 0; i < coords.size() && !element.first; ++i)
+    double corner[4][3];
+    double center[3] = {0,0,0};
+    for (unsigned i=0; i<4; ++i)
     {
-      for (unsigned j = 0; j < coords[i].size() && !element.first; ++j)
+      const double r = std::sqrt(coords[i][0]*coords[i][0] +
+                                 coords[i][1]*coords[i][1] +
+                                 coords[i][2]*coords[i][2]);
+      for (unsigned k=0; k<3; ++k)
       {
-        const bool found =  point_inside(coords[i][j], sphere_xyz);
-        if (found)
-        {
-          parametric = parametric_coordinates(coords[i][j], sphere);
-          if (parametric.first  < -1) parametric.first  = -1;
-          if (parametric.second < -1) parametric.second = -1;
-          if (1 < parametric.first  ) parametric.first  =  1;
-          if (1 < parametric.second ) parametric.second =  1;
-          element.first         = true;
-          element.second.first  = i;
-          element.second.second = j;
-        }
+        corner[i][k] = coords[i][k]/r;
+        center[k] += corner[i][k];
       }
     }
-    return element;
+    const double rc = std::sqrt(center[0]*center[0] + center[1]*center[1] + center[2]*center[2]);
+    for (unsigned k=0; k<3; ++k) center[k] /= rc;
+
+    double radius = 0;
+    for (unsigned i=0; i<4; ++i)
+    {
+      const double dot = center[0]*corner[i][0] + center[1]*corner[i][1] + center[2]*corner[i][2];
+      radius = std::max(radius, std::acos(std::min(1.0, dot)));
+    }
+    // pad for the tolerance in point_inside and for round-off
+    radius = 1.05*radius + 1e-10;
+
+    const double latc = std::asin(std::max(-1.0, std::min(1.0, center[2])));
+    const double lonc = std::atan2(center[1], center[0]);
+    const double dlat = pi/(nlat-1);
+    const double dlon = 2*pi/nlon;
+
+    i0 = std::max(0,          (int) std::ceil ((latc - radius + pi/2)/dlat));
+    i1 = std::min((int)nlat-1, (int) std::floor((latc + radius + pi/2)/dlat));
+
+    if (pi/2 <= std::abs(latc) + radius)
+    {
+      // cap contains a pole: any longitude
+      j0 = 0;
+      j1 = nlon-1;
+    }
+    else
+    {
+      const double width = std::asin(std::sin(radius)/std::cos(latc));
+      j0 = (int) std::ceil ((lonc - width)/dlon);
+      j1 = (int) std::floor((lonc + width)/dlon);
+      if ((int)nlon <= j1 - j0) { j0 = 0; j1 = nlon-1; }
+    }
+  }
+
+  //! Weighted sum of the element corner coordinates. Stored with the
+  //! interpolation cache to reject files written for another mesh.
+  double coords_checksum(
+    const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords)
+  {
+    double sum = 0;
+    for (unsigned b=0; b<coords.size(); ++b)
+      for (unsigned e=0; e<coords[b].size(); ++e)
+        for (unsigned i=0; i<4; ++i)
+          for (unsigned k=0; k<3; ++k)
+            sum += (i+1)*(k+1)*coords[b][e][i][k];
+    return sum;
+  }
+
+  std::string latlon_interp_cache_name(const std::string &base,
+                                       const Teuchos::RCP<const Teuchos_Comm> commT)
+  {
+    std::ostringstream name;
+    name << base << "." << commT->getSize() << "." << commT->getRank();
+    return name.str();
+  }
+
+  //! Read this rank's interpolation data. Returns false, leaving interpdata
+  //! empty, if the file is missing or was written for a different grid,
+  //! mesh or partition.
+  bool read_latlon_interp(
+    const std::string &file,
+    const unsigned nlat, const unsigned nlon,
+    const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords,
+    Albany::WorksetArray<Teuchos::ArrayRCP<std::vector<Aeras::SpectralDiscretization::interp> > >::type& interpdata)
+  {
+
+    std::ifstream in(file.c_str());
+    if (!in) return false;
+
+    unsigned file_nlat=0, file_nlon=0, nws=0;
+    double checksum=0;
+    in >> file_nlat >> file_nlon >> nws >> checksum;
+    if (!in || file_nlat != nlat || file_nlon != nlon || nws != coords.size()) return false;
+    const double sum = coords_checksum(coords);
+    if (1e-10*(1+std::abs(sum)) < std::abs(checksum-sum)) return false;
+    for (unsigned b=0; b<nws; ++b)
+    {
+      unsigned nelem=0;
+      in >> nelem;
+      if (!in || nelem != coords[b].size()) return false;
+    }
+
+    bool ok = true;
+    unsigned rb, re;
+    Aeras::SpectralDiscretization::interp interp;
+    while (ok && in >> rb >> re >> interp.latitude_longitude.first >> interp.latitude_longitude.second
+                   >> interp.parametric_coords.first >> interp.parametric_coords.second)
+    {
+      ok = rb < coords.size() && re < coords[rb].size() &&
+           interp.latitude_longitude.first < nlat && interp.latitude_longitude.second < nlon;
+      if (ok) interpdata[rb][re].push_back(interp);
+    }
+    ok = ok && in.eof();
+    if (!ok)
+      for (unsigned b=0; b<interpdata.size(); ++b)
+        for (unsigned e=0; e<interpdata[b].size(); ++e) interpdata[b][e].clear();
+    return ok;
+  }
+
+  void write_latlon_interp(
+    const std::string &file,
+    const unsigned nlat, const unsigned nlon,
+    const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords,
+    const Albany::WorksetArray<Teuchos::ArrayRCP<std::vector<Aeras::SpectralDiscretization::interp> > >::type& interpdata)
+  {
+
+    std::ofstream out(file.c_str());
+    TEUCHOS_TEST_FOR_EXCEPTION(!out, std::runtime_error,
+      "Cannot open NetCDF interpolation cache file " << file << std::endl);
+    out << std::setprecision(17);
+    out << nlat << " " << nlon << " " << coords.size() << " " << coords_checksum(coords) << "\n";
+    for (unsigned b=0; b<coords.size(); ++b) out << coords[b].size() << "\n";
+    for (unsigned b=0; b<interpdata.size(); ++b)
+      for (unsigned e=0; e<interpdata[b].size(); ++e)
+        for (unsigned n=0; n<interpdata[b][e].size(); ++n)
+        {
+          const Aeras::SpectralDiscretization::interp &interp = interpdata[b][e][n];
+          out << b << " " << e << " "
+              << interp.latitude_longitude.first << " " << interp.latitude_longitude.second << " "
+              << interp.parametric_coords.first  << " " << interp.parametric_coords.second  << "\n";
+        }
   }
 
   void setup_latlon_interp(
-    const unsigned nlat,
-    const double nlon,
+    const unsigned nlat, const unsigned nlon,
     const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords,
     Albany::WorksetArray<Teuchos::ArrayRCP<std::vector<Aeras::SpectralDiscretization::interp> > >::type& interpdata,
     const Teuchos::RCP<const Teuchos_Comm> commT)
   {
+
     double err=0;
     const long long unsigned rank = commT->getRank();
     std::vector<double> lat(nlat);
     std::vector<double> lon(nlon);
 
-    unsigned count = 0;
-    for (unsigned i = 0; i < nlat; ++i)
-      lat[i] = -pi/2 + i*pi/(nlat-1);
-    for (unsigned j = 0; j < nlon; ++j)
-      lon[j] = 2*j*pi/nlon;
-    for (unsigned i = 0; i < nlat; ++i)
+    for (unsigned i=0; i<nlat; ++i) lat[i] = -pi/2 + i*pi/(nlat-1);
+    for (unsigned j=0; j<nlon; ++j) lon[j] =       2*j*pi/nlon;
+
+    // Element containing each grid point. Each element only tests the grid
+    // points in its lat/lon box, so the search is linear in the grid size
+    // plus the mesh size. Elements are visited in workset order and the first
+    // one containing a point keeps it, as a scan over all elements would.
+    const unsigned none = std::numeric_limits<unsigned>::max();
+    std::vector<std::pair<unsigned, unsigned> > owner(nlat*nlon, std::pair<unsigned, unsigned>(none,0));
+    for (unsigned b=0; b<coords.size(); ++b)
     {
-      for (unsigned j=0; j<nlon; ++j)
+      for (unsigned e=0; e<coords[b].size(); ++e)
       {
-        const std::pair<double, double> sphere(lat[i],lon[j]);
-        std::pair<double, double> paramtric;
-        const std::pair<bool,std::pair<unsigned, unsigned> >element =
-          point_in_element(sphere, coords, paramtric);
-        if (element.first)
+        int i0, i1, j0, j1;
+        element_latlon_range(coords[b][e], nlat, nlon, i0, i1, j0, j1);
+        for (int i=i0; i<=i1; ++i)
         {
-          // compute error: map 'cart' back to sphere and compare with original
-          // interpolation point:
-          const unsigned b = element.second.first ;
-          const unsigned e = element.second.second;
-          const std::vector<double> sphere2_xyz =
-            spherical_to_cart(ref2sphere(coords[b][e], paramtric));
-          const std::vector<double> sphere_xyz  =
-            spherical_to_cart(sphere);
-          err = std::max(err, ::distance(&sphere2_xyz[0],&sphere_xyz[0]));
-          Aeras::SpectralDiscretization::interp interp;
-          interp.parametric_coords = paramtric;
-          interp.latitude_longitude = std::pair<unsigned,unsigned>(i,j);
-          interpdata[b][e].push_back(interp);
-          ++count;
+          for (int jw=j0; jw<=j1; ++jw)
+          {
+            const unsigned j = (jw % (int)nlon + nlon) % nlon;
+            std::pair<unsigned, unsigned> &o = owner[i*nlon+j];
+            if (o.first != none) continue;
+            const std::pair<double, double> sphere(lat[i],lon[j]);
+            if (point_inside(coords[b][e], spherical_to_cart(sphere)))
+              o = std::pair<unsigned, unsigned>(b,e);
+          }
         }
       }
-      if (!rank && (!(i%64) || i==nlat-1))
-        std::cout << "Finished Latitude " << i << " of " << nlat << std::endl;
     }
-    if (!rank)
-      std::cout<<"Max interpolation point search error: " <<err<<std::endl;
+
+    for (unsigned i=0; i<nlat; ++i)
+    {
+      for (unsigned j=0; j<nlon; ++j)
+      {
+        const std::pair<unsigned, unsigned> &o = owner[i*nlon+j];
+        if (o.first == none) continue;
+        const unsigned b = o.first ;
+        const unsigned e = o.second;
+        const std::pair<double, double> sphere(lat[i],lon[j]);
+        std::pair<double, double> paramtric = parametric_coordinates(coords[b][e], sphere);
+        if (paramtric.first  < -1) paramtric.first  = -1;
+        if (paramtric.second < -1) paramtric.second = -1;
+        if (1 < paramtric.first  ) paramtric.first  =  1;
+        if (1 < paramtric.second ) paramtric.second =  1;
+        // compute error: map 'cart' back to sphere and compare with original
+        // interpolation point:
+        const std::vector<double> sphere2_xyz = spherical_to_cart(ref2sphere(coords[b][e], paramtric));
+        const std::vector<double> sphere_xyz  = spherical_to_cart(sphere);
+        err = std::max(err, ::distance(&sphere2_xyz[0],&sphere_xyz[0]));
+        Aeras::SpectralDiscretization::interp interp;
+        interp.parametric_coords = paramtric;
+        interp.latitude_longitude = std::pair<unsigned,unsigned>(i,j);
+        interpdata[b][e].push_back(interp);
+      }
+    }
+    if (!rank) std::cout<<"Max interpolation point search error: "<<err<<std::endl;
   }
 }
 
@@ -3271,7 +3412,20 @@ void Aeras::SpectralDiscretization::setupNetCDFOutput()
     interpolateData.resize(coords.size());
     for (int b=0; b < coords.size(); b++) interpolateData[b].resize(coords[b].size());
 
-    setup_latlon_interp(nlat, nlon, coords, interpolateData, commT);
+    const std::string cache = stkMeshStruct->cdfInterpCacheFile.empty() ? std::string() :
+      latlon_interp_cache_name(stkMeshStruct->cdfInterpCacheFile, commT);
+    if (!cache.empty() && read_latlon_interp(cache, nlat, nlon, coords, interpolateData))
+    {
+      if (!rank)
+        std::cout << "Read NetCDF interpolation data from "
+                  << stkMeshStruct->cdfInterpCacheFile << std::endl;
+    }
+    else
+    {
+      setup_latlon_interp(nlat, nlon, coords, interpolateData, commT);
+      if (!cache.empty())
+        write_latlon_interp(cache, nlat, nlon, coords, interpolateData);
+    }
 
     const std::string name = stkMeshStruct->cdfOutFile;
     netCDFp=0;
@@ -3420,6 +3574,8 @@ Aeras::SpectralDiscretization::updateMesh(bool /*shouldTransferIPData*/)
 #ifdef OUTPUT_TO_SCREEN
   *out << "DEBUG: " << __PRETTY_FUNCTION__ << std::endl;
 #endif
+  ++meshVersion;
+
   if (spatial_dim == 1)
     enrichMeshLines();
   else if (spatial_dim == 2)
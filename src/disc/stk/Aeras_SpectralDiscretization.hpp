@@ -452,6 +452,23 @@ namespace Aeras
       return false;
     }
 
+    //! Mesh version; -1 unless "Cache Geometry" is set in the discretization
+    int getMeshVersion() const
+    {
+      return stkMeshStruct->cacheGeometry ? meshVersion : -1;
+    }
+
+    int getMeshChangeCount() const { return meshVersion; }
+
+    bool singlePrecisionGeometryCache() const
+    {
+      return stkMeshStruct->singlePrecisionGeometryCache;
+    }
+
+    //! Cost-weighted rebalancing is not supported on spectral elements
+    bool measuresWorksetCost() const { return false; }
+    void addWorksetCost(const int ws, const double seconds) {}
+
     //! If restarting, convenience function to return restart data time
     double restartDataTime() const
     {
@@ -783,6 +800,9 @@ namespace Aeras
 #endif
     bool interleavedOrdering;
 
+    //! Bumped whenever the mesh geometry changes (see getMeshVersion)
+    int meshVersion;
+
   private:
 
   };
@@ -87,6 +87,8 @@ class AbstractSTKFieldContainer : public AbstractFieldContainer {
     VectorFieldType* getCoordinatesField(){ return coordinates_field; }
     IntScalarFieldType* getProcRankField(){ return proc_rank_field; }
     IntScalarFieldType* getRefineField(){ return refine_field; }
+    //! Measured element cost for cost-weighted rebalancing (NULL if disabled)
+    ScalarFieldType* getElementWeightField(){ return element_weight_field; }
 #if defined(ALBANY_LCM)
     IntScalarFieldType* getFractureState(stk::topology::rank_t rank){ return fracture_state[rank]; }
 #endif // ALBANY_LCM
@@ -143,6 +145,7 @@ class AbstractSTKFieldContainer : public AbstractFieldContainer {
     VectorFieldType* coordinates_field;
     IntScalarFieldType* proc_rank_field;
     IntScalarFieldType* refine_field;
+    ScalarFieldType* element_weight_field;
 #if defined(ALBANY_LCM)
     IntScalarFieldType* fracture_state[stk::topology::ELEMENT_RANK];
 #endif // ALBANY_LCM
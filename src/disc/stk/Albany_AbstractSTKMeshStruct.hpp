@@ -59,14 +59,25 @@ namespace Albany {
     bool exoOutput;
     std::string exoOutFile;
     int exoOutputInterval;
+    //! Write Exodus output on a background thread from staged copies of the
+    //! output fields, keeping at most asyncOutputStagingMB of staged data
+    bool asyncOutput;
+    double asyncOutputStagingMB;
     std::string cdfOutFile;
     bool cdfOutput;
     unsigned nLat;
     unsigned nLon;
     int cdfOutputInterval;
+    //! Per-rank file prefix for caching NetCDF interpolation data (empty: off)
+    std::string cdfInterpCacheFile;
 
     bool transferSolutionToCoords;
 
+    //! Cache geometry-only evaluator data (e.g. basis functions) across
+    //! evaluations until the mesh changes, optionally in single precision
+    bool cacheGeometry;
+    bool singlePrecisionGeometryCache;
+
     int num_time_deriv;
 
     // Solution history
@@ -105,6 +105,12 @@ Albany::FromCubitSTKMeshStruct::FromCubitSTKMeshStruct(
        << "  nodesets = " << nsPartVec.size() << endl;
   useElementAsTopRank = false;
 
+  // The mesh mover can change the coordinates; do not cache geometry.
+  cacheGeometry = false;
+  singlePrecisionGeometryCache = false;
+  asyncOutput = false;
+  asyncOutputStagingMB = 0.0;
+
   exoOutput = params->isType<string>("Exodus Output File Name");
   if (exoOutput)
     exoOutFile = params->get<string>("Exodus Output File Name");
@@ -113,6 +119,7 @@ Albany::FromCubitSTKMeshStruct::FromCubitSTKMeshStruct(
     cdfOutFile = params->get<string>("NetCDF Output File Name");
   nLat       =  params->get("NetCDF Output Number of Latitudes",100);
   nLon       =  params->get("NetCDF Output Number of Longitudes",100);
+  cdfInterpCacheFile = params->get<string>("NetCDF Interpolation Cache File", "");
   
   //get the type of transformation of STK mesh (for FELIX problems)
   transformType = params->get("Transform Type", "None"); //get the type of transformation of STK mesh (for FELIX problems)
@@ -147,6 +154,8 @@ Albany::FromCubitSTKMeshStruct::getValidDiscretizationParameters() const
     "Number of samples in Latitude direction for NetCDF output. Default is 100.");
   validPL->set<int>("NetCDF Output Number of Longitudes", 1, 
     "Number of samples in Longitude direction for NetCDF output. Default is 100.");
+  validPL->set<std::string>("NetCDF Interpolation Cache File", "",
+    "Cache the NetCDF output interpolation data in files with this prefix (one per rank) and reuse them on restart");
   validPL->set<std::string>("Method", "",
     "The discretization method, parsed in the Discretization Factory");
   validPL->set<int>("Cubature Degree", 3, "Integration order sent to Intrepid2");
@@ -4,7 +4,9 @@
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
 
+#include <algorithm>
 #include <iostream>
+#include "Teuchos_CommHelpers.hpp"
 #include "Teuchos_VerboseObject.hpp"
 #include "Tpetra_ComputeGatherMap.hpp"
 
@@ -195,6 +197,8 @@ void Albany::GenericSTKMeshStruct::SetupFieldData(
   if (exoOutput)
     exoOutFile = params->get<std::string>("Exodus Output File Name");
   exoOutputInterval = params->get<int>("Exodus Write Interval", 1);
+  asyncOutput = params->get<bool>("Asynchronous Exodus Output", false);
+  asyncOutputStagingMB = params->get<double>("Asynchronous Output Staging MB", 256.0);
   cdfOutput = params->isType<std::string>("NetCDF Output File Name");
   if (cdfOutput)
     cdfOutFile = params->get<std::string>("NetCDF Output File Name");
@@ -202,6 +206,7 @@ void Albany::GenericSTKMeshStruct::SetupFieldData(
   nLat       =  params->get("NetCDF Output Number of Latitudes",100);
   nLon       =  params->get("NetCDF Output Number of Longitudes",100);
   cdfOutputInterval = params->get<int>("NetCDF Write Interval", 1);
+  cdfInterpCacheFile = params->get<std::string>("NetCDF Interpolation Cache File", "");
 
 
   //get the type of transformation of STK mesh (for FELIX problems)
@@ -219,6 +224,9 @@ void Albany::GenericSTKMeshStruct::SetupFieldData(
 
   transferSolutionToCoords = params->get<bool>("Transfer Solution to Coordinates", false);
 
+  cacheGeometry = params->get<bool>("Cache Geometry", false);
+  singlePrecisionGeometryCache = params->get<bool>("Single Precision Geometry Cache", false);
+
 #ifdef ALBANY_STK_PERCEPT
   // Build the eMesh if needed
   if(buildEMesh)
@@ -584,6 +592,79 @@ void Albany::GenericSTKMeshStruct::rebalanceInitialMeshT(const Teuchos::RCP<cons
 }
 
 
+namespace {
+
+// Sum of the element weights of the locally owned elements
+double localElementWeight(stk::mesh::BulkData& bulkData,
+                          Albany::AbstractSTKFieldContainer::ScalarFieldType& weight_field)
+{
+  const stk::mesh::BucketVector& buckets = bulkData.get_buckets(stk::topology::ELEMENT_RANK,
+      bulkData.mesh_meta_data().locally_owned_part());
+  double sum = 0.0;
+  for (std::size_t b = 0; b < buckets.size(); ++b) {
+    const double* w = stk::mesh::field_data(weight_field, *buckets[b]);
+    for (std::size_t i = 0; i < buckets[b]->size(); ++i)
+      sum += w[i];
+  }
+  return sum;
+}
+
+} // namespace
+
+double Albany::GenericSTKMeshStruct::measuredImbalance(const Teuchos::RCP<const Teuchos::Comm<int> >& comm)
+{
+  AbstractSTKFieldContainer::ScalarFieldType* weight_field = fieldContainer->getElementWeightField();
+  if (weight_field == NULL) return 1.0;
+
+  const double local = localElementWeight(*bulkData, *weight_field);
+  double global_max = 0.0, global_sum = 0.0;
+  Teuchos::reduceAll<int, double>(*comm, Teuchos::REDUCE_MAX, local, Teuchos::outArg(global_max));
+  Teuchos::reduceAll<int, double>(*comm, Teuchos::REDUCE_SUM, local, Teuchos::outArg(global_sum));
+
+  if (global_sum <= 0.0) return 1.0;
+  return global_max * comm->getSize() / global_sum;
+}
+
+bool Albany::GenericSTKMeshStruct::prepareElementWeights(const Teuchos::RCP<const Teuchos::Comm<int> >& comm)
+{
+  AbstractSTKFieldContainer::ScalarFieldType* weight_field = fieldContainer->getElementWeightField();
+
+  stk::mesh::Selector owned_selector(metaData->locally_owned_part());
+  const double local_count = stk::mesh::count_selected_entities(owned_selector,
+      bulkData->buckets(stk::topology::ELEMENT_RANK));
+  const double local_sum = localElementWeight(*bulkData, *weight_field);
+  double global_count = 0.0, global_sum = 0.0;
+  Teuchos::reduceAll<int, double>(*comm, Teuchos::REDUCE_SUM, local_count, Teuchos::outArg(global_count));
+  Teuchos::reduceAll<int, double>(*comm, Teuchos::REDUCE_SUM, local_sum, Teuchos::outArg(global_sum));
+
+  if (global_sum <= 0.0) return false;
+
+  // Zoltan does not like zero weights: elements that were never evaluated
+  // (e.g. created by adaptation since the last measurement) get a small
+  // fraction of the mean cost.
+  const double floor = 1.0e-3 * global_sum / global_count;
+  const stk::mesh::BucketVector& buckets = bulkData->get_buckets(stk::topology::ELEMENT_RANK,
+      metaData->universal_part());
+  for (std::size_t b = 0; b < buckets.size(); ++b) {
+    double* w = stk::mesh::field_data(*weight_field, *buckets[b]);
+    for (std::size_t i = 0; i < buckets[b]->size(); ++i)
+      w[i] = std::max(w[i], floor);
+  }
+  return true;
+}
+
+void Albany::GenericSTKMeshStruct::resetElementWeights()
+{
+  AbstractSTKFieldContainer::ScalarFieldType* weight_field = fieldContainer->getElementWeightField();
+
+  const stk::mesh::BucketVector& buckets = bulkData->get_buckets(stk::topology::ELEMENT_RANK,
+      metaData->universal_part());
+  for (std::size_t b = 0; b < buckets.size(); ++b) {
+    double* w = stk::mesh::field_data(*weight_field, *buckets[b]);
+    std::fill(w, w + buckets[b]->size(), 0.0);
+  }
+}
+
 void Albany::GenericSTKMeshStruct::rebalanceAdaptedMeshT(const Teuchos::RCP<Teuchos::ParameterList>& params_,
                                                         const Teuchos::RCP<const Teuchos::Comm<int> >& comm){
 
@@ -615,7 +696,15 @@ void Albany::GenericSTKMeshStruct::rebalanceAdaptedMeshT(const Teuchos::RCP<Teuc
     }
 
 
-    imbalance = stk::rebalance::check_balance(*bulkData, NULL, stk::topology::NODE_RANK, &selector);
+    // Element weights from the measured evaluation cost, if available
+    AbstractSTKFieldContainer::ScalarFieldType* weight_field = fieldContainer->getElementWeightField();
+    if (weight_field != NULL && !prepareElementWeights(comm))
+      weight_field = NULL;
+
+    if (weight_field != NULL)
+      imbalance = stk::rebalance::check_balance(*bulkData, weight_field, stk::topology::ELEMENT_RANK, &owned_selector);
+    else
+      imbalance = stk::rebalance::check_balance(*bulkData, NULL, stk::topology::NODE_RANK, &selector);
 
     if(comm->getRank() == 0)
 
@@ -645,14 +734,22 @@ void Albany::GenericSTKMeshStruct::rebalanceAdaptedMeshT(const Teuchos::RCP<Teuc
     const Teuchos::MpiComm<int>* mpiComm = dynamic_cast<const Teuchos::MpiComm<int>* > (comm.get());
 
     stk::rebalance::Zoltan zoltan_partition(*bulkData, *mpiComm->getRawMpiComm(), numDim, graph_options);
-    stk::rebalance::rebalance(*bulkData, owned_selector, coordinates_field, NULL, zoltan_partition);
+    stk::rebalance::rebalance(*bulkData, owned_selector, coordinates_field, weight_field, zoltan_partition);
 
-    imbalance = stk::rebalance::check_balance(*bulkData, NULL,
-      stk::topology::NODE_RANK, &selector);
+    if (weight_field != NULL)
+      imbalance = stk::rebalance::check_balance(*bulkData, weight_field,
+        stk::topology::ELEMENT_RANK, &owned_selector);
+    else
+      imbalance = stk::rebalance::check_balance(*bulkData, NULL,
+        stk::topology::NODE_RANK, &selector);
 
     if(comm->getRank() == 0)
       std::cout << "After rebalance: Imbalance threshold is = " << imbalance << endl;
 
+    // Start measuring again on the new partition
+    if (weight_field != NULL)
+      resetElementWeights();
+
 #if 0 // Other experiments at rebalancing
 
     // Configure Zoltan to use graph-based partitioning
@@ -1594,6 +1691,10 @@ Albany::GenericSTKMeshStruct::getValidGenericSTKParameters(std::string listname)
       "Name of solution_dotdot dtk written to Exodus file. Requires SEACAS build");
 #endif
   validPL->set<int>("Exodus Write Interval", 3, "Step interval to write solution data to Exodus file");
+  validPL->set<bool>("Asynchronous Exodus Output", false,
+      "Write Exodus output on a background thread from a staged copy of the output fields");
+  validPL->set<double>("Asynchronous Output Staging MB", 256.0,
+      "Bound on the staged output data; the solver waits for the writer beyond it");
   validPL->set<std::string>("NetCDF Output File Name", "",
       "Request NetCDF output to given file name. Requires SEACAS build");
   validPL->set<int>("NetCDF Write Interval", 1, "Step interval to write solution data to NetCDF file");
@@ -1601,6 +1702,8 @@ Albany::GenericSTKMeshStruct::getValidGenericSTKParameters(std::string listname)
       "Number of samples in Latitude direction for NetCDF output. Default is 100.");
   validPL->set<int>("NetCDF Output Number of Longitudes", 1,
       "Number of samples in Longitude direction for NetCDF output. Default is 100.");
+  validPL->set<std::string>("NetCDF Interpolation Cache File", "",
+      "Cache the NetCDF output interpolation data in files with this prefix (one per rank) and reuse them on restart");
   validPL->set<std::string>("Method", "",
     "The discretization method, parsed in the Discretization Factory");
   validPL->set<int>("Cubature Degree", 3, "Integration order sent to Intrepid2");
@@ -1632,6 +1735,10 @@ Albany::GenericSTKMeshStruct::getValidGenericSTKParameters(std::string listname)
 
   validPL->set<bool>("Use Serial Mesh", false, "Read in a single mesh on PE 0 and rebalance");
   validPL->set<bool>("Transfer Solution to Coordinates", false, "Copies the solution vector to the coordinates for output");
+  validPL->set<bool>("Cache Geometry", false,
+                     "Cache geometry-only evaluator data (e.g. basis functions) until the mesh changes");
+  validPL->set<bool>("Single Precision Geometry Cache", false,
+                     "Store the geometry cache in single precision to save memory");
 
   validPL->set<bool>("Use Serial Mesh", false, "Read in a single mesh on PE 0 and rebalance");
   validPL->set<bool>("Use Composite Tet 10", false, "Flag to use the composite tet 10 basis in Intrepid");
@@ -1645,6 +1752,8 @@ Albany::GenericSTKMeshStruct::getValidGenericSTKParameters(std::string listname)
   validPL->set<std::string>("STK Initial Enrich", "", "stk::percept enrichment option to apply after the mesh is input");
   validPL->set<std::string>("STK Initial Convert", "", "stk::percept conversion option to apply after the mesh is input");
   validPL->set<bool>("Rebalance Mesh", false, "Parallel re-load balance initial mesh after generation");
+  validPL->set<bool>("Cost-Weighted Rebalance", false,
+      "Measure the evaluation time of each element and use it as the element weight when rebalancing");
   validPL->set<int>("Number of Refinement Passes", 1, "Number of times to apply the refinement process");
 
   validPL->sublist("Side Set Discretizations", false, "A sublist containing info for storing side discretizations");
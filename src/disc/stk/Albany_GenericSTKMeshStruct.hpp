@@ -43,6 +43,10 @@ namespace Albany {
     void rebalanceAdaptedMeshT(const Teuchos::RCP<Teuchos::ParameterList>& params,
                               const Teuchos::RCP<const Teuchos::Comm<int> >& comm);
 
+    //! Largest over mean per-rank element cost measured since the last
+    //! rebalance ("Cost-Weighted Rebalance"); 1 if nothing was measured
+    double measuredImbalance(const Teuchos::RCP<const Teuchos::Comm<int> >& comm);
+
     bool useCompositeTet(){ return compositeTet; }
 
     //! Process STK mesh for element block specific info
@@ -87,6 +91,12 @@ namespace Albany {
     //! Re-load balance mesh
     void rebalanceInitialMeshT(const Teuchos::RCP<const Teuchos::Comm<int> >& comm);
 
+    //! Give unmeasured elements a small weight; false if nothing was measured
+    bool prepareElementWeights(const Teuchos::RCP<const Teuchos::Comm<int> >& comm);
+
+    //! Zero the measured element cost
+    void resetElementWeights();
+
     //! Determine if a percept mesh object is needed
     bool buildEMesh;
     bool buildPerceptEMesh();
@@ -5,7 +5,10 @@
 //*****************************************************************//
 
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <unordered_map>
 
 #include "Albany_GmshSTKMeshStruct.hpp"
 #include "Teuchos_VerboseObject.hpp"
@@ -20,6 +23,7 @@
 #include <stk_mesh/base/Selector.hpp>
 
 #include <Albany_STKNodeSharing.hpp>
+#include <stk_util/parallel/ParallelComm.hpp>
 
 #ifdef ALBANY_SEACAS
 #include <stk_io/IossBridge.hpp>
@@ -32,11 +36,17 @@
 
 Albany::GmshSTKMeshStruct::GmshSTKMeshStruct (const Teuchos::RCP<Teuchos::ParameterList>& params,
                                               const Teuchos::RCP<const Teuchos_Comm>& commT) :
-  GenericSTKMeshStruct (params, Teuchos::null)
+  GenericSTKMeshStruct (params, Teuchos::null),
+  pts(NULL), hexas(NULL), tetra(NULL), quads(NULL), trias(NULL), lines(NULL),
+  elems(NULL), sides(NULL), parallelRead(false)
 {
   std::string fname = params->get("Gmsh Input Mesh File Name", "mesh.msh");
 
-  if (commT->getRank() == 0)
+  // Every rank checks the format: MSH 4 files are read in parallel
+  bool legacy = false;
+  bool binary = false;
+  float version = 0;
+  int datasize = 0;
   {
     std::ifstream ifile;
     ifile.open(fname.c_str());
@@ -48,9 +58,6 @@ Albany::GmshSTKMeshStruct::GmshSTKMeshStruct (const Teuchos::RCP<Teuchos::Parame
     std::string line;
     std::getline (ifile, line);
 
-    bool legacy = false;
-    bool binary = false;
-
     if (line=="$NOD")
     {
       legacy = true;
@@ -60,16 +67,24 @@ Albany::GmshSTKMeshStruct::GmshSTKMeshStruct (const Teuchos::RCP<Teuchos::Parame
       std::getline (ifile, line);
       std::stringstream iss (line);
 
-      float version;
-      int doublesize;
-      iss >> version >> binary >> doublesize;
+      iss >> version >> binary >> datasize;
     }
     else
     {
       TEUCHOS_TEST_FOR_EXCEPTION (true, Teuchos::Exceptions::InvalidParameter, "Error! Mesh format not recognized.\n");
     }
     ifile.close();
+  }
 
+  if (!legacy && version>=4)
+  {
+    TEUCHOS_TEST_FOR_EXCEPTION (version<4.05 || !binary || datasize!=sizeof(std::size_t), Teuchos::Exceptions::InvalidParameter,
+                                "Error! Gmsh 4 meshes are only supported in MSH 4.1 binary format (gmsh -bin -format msh41).\n");
+    parallelRead = true;
+    loadParallelBinaryMesh (fname, commT);
+  }
+  else if (commT->getRank() == 0)
+  {
     if (legacy)
       loadLegacyMesh (fname);
     else if (binary)
@@ -121,8 +136,11 @@ Albany::GmshSTKMeshStruct::GmshSTKMeshStruct (const Teuchos::RCP<Teuchos::Parame
 
   // Counting boundaries
   std::set<int> bdTags;
-  for (int i(0); i<NumSides; ++i)
-    bdTags.insert(sides[NumSideNodes][i]);
+  if (parallelRead)
+    bdTags = fileBdTags;
+  else
+    for (int i(0); i<NumSides; ++i)
+      bdTags.insert(sides[NumSideNodes][i]);
 
   // Broadcasting the tags
   int numBdTags = bdTags.size();
@@ -184,7 +202,8 @@ Albany::GmshSTKMeshStruct::GmshSTKMeshStruct (const Teuchos::RCP<Teuchos::Parame
       TEUCHOS_TEST_FOR_EXCEPTION (true, std::logic_error, "Error! Invalid number of element nodes (you should have got an error before though).\n");
   }
 
-  numDim = 2;
+  if (!parallelRead)
+    numDim = 2;
   int cub = params->get("Cubature Degree", 3);
   int worksetSizeMax = params->get("Workset Size", 50);
   int worksetSize = this->computeWorksetSize(worksetSizeMax, NumElems);
@@ -202,6 +221,10 @@ Albany::GmshSTKMeshStruct::~GmshSTKMeshStruct()
 {
   delete[] pts;
 
+  // Only allocated by the serial readers, on rank 0
+  if (lines==NULL)
+    return;
+
   for (int i(0); i<5; ++i)
     delete[] tetra[i];
   for (int i(0); i<5; ++i)
@@ -236,8 +259,13 @@ void Albany::GmshSTKMeshStruct::setFieldAndBulkData(
 
   bulkData->modification_begin(); // Begin modifying the mesh
 
+  if (parallelRead)
+  {
+    // Every rank has read a part of the file
+    setParallelBulkData (commT);
+  }
   // Only proc 0 has loaded the file
-  if (commT->getRank()==0)
+  else if (commT->getRank()==0)
   {
     stk::mesh::PartVector singlePartVec(1);
     unsigned int ebNo = 0; //element block #???
@@ -323,8 +351,18 @@ void Albany::GmshSTKMeshStruct::setFieldAndBulkData(
   bulkData->modification_end();
 
 #ifdef ALBANY_ZOLTAN
-  // Gmsh is for sure using a serial mesh. We hard code it here, in case the user did not set it
-  params->set<bool>("Use Serial Mesh", true);
+  if (parallelRead)
+  {
+    // Each rank holds a contiguous range of the file's elements: move them to a
+    // geometric partition (Zoltan, configured by "Rebalance Options")
+    if (commT->getSize() > 1)
+      rebalanceAdaptedMeshT(params, commT);
+  }
+  else
+  {
+    // Gmsh is for sure using a serial mesh. We hard code it here, in case the user did not set it
+    params->set<bool>("Use Serial Mesh", true);
+  }
 
   // Refine the mesh before starting the simulation if indicated
   uniformRefineMesh(commT);
@@ -1015,3 +1053,590 @@ void Albany::GmshSTKMeshStruct::loadBinaryMesh (const std::string& fname)
   // Close the input stream
   ifile.close();
 }
+
+// ------------------------- Parallel MSH 4.1 reader ------------------------ //
+
+namespace
+{
+
+struct GmshBlock
+{
+  int dim;
+  int tag;                // Entity tag; boundary tag for side blocks
+  int type;               // Gmsh element type (element blocks only)
+  std::size_t size;       // Number of nodes/elements in the block
+  std::size_t first;      // Index of the first one, counting all blocks of the same kind
+  int stride;             // Coordinates per node, or nodes per element
+  std::streamoff offset;  // Start of the block data in the file
+};
+
+int gmshElementNodes (const int type)
+{
+  switch (type)
+  {
+    case 1:  return 2; // 2-pt Line
+    case 2:  return 3; // 3-pt Triangle
+    case 3:  return 4; // 4-pt Quad
+    case 4:  return 4; // 4-pt Tetra
+    case 5:  return 8; // 8-pt Hexa
+    case 15: return 1; // Point
+    default:
+      TEUCHOS_TEST_FOR_EXCEPTION (true, Teuchos::Exceptions::InvalidParameter, "Error! Element type " << type << " not supported.\n");
+  }
+  return 0;
+}
+
+template<typename T>
+T readBinary (std::ifstream& ifile)
+{
+  T value;
+  ifile.read (reinterpret_cast<char*> (&value), sizeof(T));
+  return value;
+}
+
+// Calls read(block,lo,hi) with the entries [lo,hi) of each block that fall in
+// the range [begin,end) of the whole list
+template<typename ReadT>
+void readBlockRange (const std::vector<GmshBlock>& blocks, const std::size_t begin,
+                     const std::size_t end, const ReadT& read)
+{
+  for (const GmshBlock& b : blocks)
+  {
+    const std::size_t lo = std::max(begin, b.first);
+    const std::size_t hi = std::min(end, b.first+b.size);
+    if (lo<hi)
+      read (b, lo-b.first, hi-b.first);
+  }
+}
+
+// Sparse all-to-all: pack(comm) is called twice, to size and then to fill the send buffers
+template<typename PackT>
+void exchange (stk::CommAll& comm, const PackT& pack)
+{
+  pack (comm);
+  comm.allocate_buffers (comm.parallel_size()/4);
+  pack (comm);
+  comm.communicate ();
+}
+
+} // namespace
+
+void Albany::GmshSTKMeshStruct::loadParallelBinaryMesh (const std::string& fname,
+                                                        const Teuchos::RCP<const Teuchos_Comm>& commT)
+{
+  std::ifstream ifile;
+  ifile.open(fname.c_str(), std::ios::binary);
+  if (!ifile.is_open())
+  {
+      TEUCHOS_TEST_FOR_EXCEPTION(true, std::runtime_error, "Error! Cannot open mesh file '" << fname << "'.\n");
+  }
+
+  std::string line;
+  std::getline (ifile, line); // $MeshFormat
+  std::getline (ifile, line); // 4.1 file-type data-size
+
+  // Check file endianness
+  TEUCHOS_TEST_FOR_EXCEPTION (readBinary<int>(ifile)!=1, std::runtime_error, "Error! Uncompatible binary format.\n");
+
+  // Scan the sections. Every rank does it, but only reads the block headers and seeks over the data
+  std::map<std::pair<int,int>,int> physicalTags; // (dim,entity tag) -> first physical tag
+  std::vector<GmshBlock> nodeBlocks, elemBlocks;
+  std::size_t numFileNodes(0);
+  while (std::getline (ifile, line))
+  {
+    if (line=="$Entities")
+    {
+      std::size_t numEntities[4]; // points, curves, surfaces, volumes
+      ifile.read (reinterpret_cast<char*> (numEntities), 4*sizeof(std::size_t));
+      for (int dim(0); dim<4; ++dim)
+      {
+        for (std::size_t i(0); i<numEntities[dim]; ++i)
+        {
+          const int tag = readBinary<int>(ifile);
+          ifile.seekg ((dim==0 ? 3 : 6)*sizeof(double), std::ios::cur); // point or bounding box
+          const std::size_t n_phys = readBinary<std::size_t>(ifile);
+          for (std::size_t k(0); k<n_phys; ++k)
+          {
+            const int phys = readBinary<int>(ifile);
+            if (k==0)
+              physicalTags[std::make_pair(dim,tag)] = phys;
+          }
+          if (dim>0)
+          {
+            const std::size_t n_bounding = readBinary<std::size_t>(ifile);
+            ifile.seekg (n_bounding*sizeof(int), std::ios::cur);
+          }
+        }
+      }
+    }
+    else if (line=="$Nodes")
+    {
+      std::size_t header[4]; // blocks, nodes, min tag, max tag
+      ifile.read (reinterpret_cast<char*> (header), 4*sizeof(std::size_t));
+      numFileNodes = header[1];
+      minNodeTag = header[2];
+      maxNodeTag = header[3];
+
+      std::size_t first(0);
+      for (std::size_t ib(0); ib<header[0]; ++ib)
+      {
+        GmshBlock b;
+        b.dim = readBinary<int>(ifile);
+        b.tag = readBinary<int>(ifile);
+        const int parametric = readBinary<int>(ifile);
+        b.size = readBinary<std::size_t>(ifile);
+        b.type = 0;
+        b.first = first;
+        b.stride = 3 + (parametric ? b.dim : 0);
+        b.offset = ifile.tellg();
+        TEUCHOS_TEST_FOR_EXCEPTION (!ifile, std::runtime_error, "Error! Corrupt nodes section.\n");
+
+        // All the node tags of the block, then all the coordinates
+        ifile.seekg (b.size*(sizeof(std::size_t) + b.stride*sizeof(double)), std::ios::cur);
+        first += b.size;
+        nodeBlocks.push_back(b);
+      }
+    }
+    else if (line=="$Elements")
+    {
+      std::size_t header[4]; // blocks, elements, min tag, max tag
+      ifile.read (reinterpret_cast<char*> (header), 4*sizeof(std::size_t));
+
+      for (std::size_t ib(0); ib<header[0]; ++ib)
+      {
+        GmshBlock b;
+        b.dim = readBinary<int>(ifile);
+        b.tag = readBinary<int>(ifile);
+        b.type = readBinary<int>(ifile);
+        b.size = readBinary<std::size_t>(ifile);
+        b.first = 0;
+        b.stride = gmshElementNodes(b.type);
+        b.offset = ifile.tellg();
+        TEUCHOS_TEST_FOR_EXCEPTION (!ifile, std::runtime_error, "Error! Corrupt elements section.\n");
+
+        // Each element is its tag followed by its node tags
+        ifile.seekg (b.size*(1+b.stride)*sizeof(std::size_t), std::ios::cur);
+        elemBlocks.push_back(b);
+      }
+    }
+    else if (line.size()>1 && line[0]=='$' && line.compare(0,4,"$End")!=0)
+    {
+      // A section we do not need (e.g. $PhysicalNames)
+      const std::string end = "$End" + line.substr(1);
+      while (std::getline (ifile, line) && line!=end)
+      {
+        // Keep swallowing lines...
+      }
+    }
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION (nodeBlocks.empty(), std::runtime_error, "Error! Nodes section not found.\n");
+  TEUCHOS_TEST_FOR_EXCEPTION (elemBlocks.empty(), std::runtime_error, "Error! Element section not found.\n");
+
+  // Gmsh lists elements and sides (and some points) all toghether. We support
+  // linear Tetrahedra/Hexahedra in 3D and linear Triangle/Quads in 2D
+  std::size_t nb_tetra(0), nb_hexa(0), nb_tria(0), nb_quad(0);
+  for (const GmshBlock& b : elemBlocks)
+  {
+    switch (b.type)
+    {
+      case 2: nb_tria  += b.size; break;
+      case 3: nb_quad  += b.size; break;
+      case 4: nb_tetra += b.size; break;
+      case 5: nb_hexa  += b.size; break;
+    }
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION (nb_tetra*nb_hexa!=0, std::logic_error, "Error! Cannot mix tetrahedra and hexahedra.\n");
+  TEUCHOS_TEST_FOR_EXCEPTION (nb_tetra+nb_hexa==0 && nb_tria*nb_quad!=0, std::logic_error, "Error! Cannot mix triangles and quadrilaterals.\n");
+  TEUCHOS_TEST_FOR_EXCEPTION (nb_tetra+nb_hexa+nb_tria+nb_quad==0, std::logic_error, "Error! Can only handle 2D and 3D geometries.\n");
+
+  int elemType, sideType;
+  if (nb_tetra>0)
+  {
+    this->numDim = 3;
+    NumElemNodes = 4;
+    NumSideNodes = 3;
+    elemType = 4;
+    sideType = 2;
+  }
+  else if (nb_hexa>0)
+  {
+    this->numDim = 3;
+    NumElemNodes = 8;
+    NumSideNodes = 4;
+    elemType = 5;
+    sideType = 3;
+  }
+  else if (nb_tria>0)
+  {
+    this->numDim = 2;
+    NumElemNodes = 3;
+    NumSideNodes = 2;
+    elemType = 2;
+    sideType = 1;
+  }
+  else
+  {
+    this->numDim = 2;
+    NumElemNodes = 4;
+    NumSideNodes = 2;
+    elemType = 3;
+    sideType = 1;
+  }
+
+  // Split the element blocks into cells and sides. The boundary tag of a side
+  // is the first physical tag of its entity (like tags[0] in MSH 2), or the
+  // entity tag if it has none
+  std::vector<GmshBlock> cellBlocks, sideBlocks;
+  std::size_t numCells(0), numSides(0);
+  for (GmshBlock b : elemBlocks)
+  {
+    if (b.type==elemType)
+    {
+      b.first = numCells;
+      numCells += b.size;
+      cellBlocks.push_back(b);
+    }
+    else if (b.type==sideType && b.dim==this->numDim-1)
+    {
+      std::map<std::pair<int,int>,int>::const_iterator it = physicalTags.find(std::make_pair(b.dim,b.tag));
+      if (it!=physicalTags.end())
+        b.tag = it->second;
+      b.first = numSides;
+      numSides += b.size;
+      sideBlocks.push_back(b);
+      fileBdTags.insert(b.tag);
+    }
+  }
+
+  NumNodes = numFileNodes;
+  NumElems = numCells;
+  NumSides = numSides;
+
+  // Read the contiguous range of nodes, cells and sides of this rank
+  ifile.clear();
+  const std::size_t rank = commT->getRank();
+  const std::size_t size = commT->getSize();
+  std::vector<std::size_t> tmp;
+
+  readBlockRange (nodeBlocks, numFileNodes*rank/size, numFileNodes*(rank+1)/size,
+                  [&](const GmshBlock& b, const std::size_t lo, const std::size_t hi)
+  {
+    const std::size_t n = hi-lo;
+    tmp.resize(n);
+    ifile.seekg (b.offset + static_cast<std::streamoff>(lo*sizeof(std::size_t)));
+    ifile.read (reinterpret_cast<char*> (tmp.data()), n*sizeof(std::size_t));
+    localNodeIds.insert(localNodeIds.end(), tmp.begin(), tmp.end());
+
+    std::vector<double> coords(n*b.stride);
+    ifile.seekg (b.offset + static_cast<std::streamoff>(b.size*sizeof(std::size_t) + lo*b.stride*sizeof(double)));
+    ifile.read (reinterpret_cast<char*> (coords.data()), coords.size()*sizeof(double));
+    for (std::size_t j(0); j<n; ++j)
+      localNodeCoords.insert(localNodeCoords.end(), &coords[j*b.stride], &coords[j*b.stride+3]);
+  });
+
+  readBlockRange (cellBlocks, numCells*rank/size, numCells*(rank+1)/size,
+                  [&](const GmshBlock& b, const std::size_t lo, const std::size_t hi)
+  {
+    const std::size_t length = 1+b.stride; // id, points
+    tmp.resize((hi-lo)*length);
+    ifile.seekg (b.offset + static_cast<std::streamoff>(lo*length*sizeof(std::size_t)));
+    ifile.read (reinterpret_cast<char*> (tmp.data()), tmp.size()*sizeof(std::size_t));
+    for (std::size_t j(0); j<hi-lo; ++j)
+    {
+      localElemIds.push_back(tmp[j*length]);
+      localElemNodes.insert(localElemNodes.end(), &tmp[j*length+1], &tmp[(j+1)*length]);
+    }
+  });
+
+  readBlockRange (sideBlocks, numSides*rank/size, numSides*(rank+1)/size,
+                  [&](const GmshBlock& b, const std::size_t lo, const std::size_t hi)
+  {
+    const std::size_t length = 1+b.stride; // id, points
+    tmp.resize((hi-lo)*length);
+    ifile.seekg (b.offset + static_cast<std::streamoff>(lo*length*sizeof(std::size_t)));
+    ifile.read (reinterpret_cast<char*> (tmp.data()), tmp.size()*sizeof(std::size_t));
+    for (std::size_t j(0); j<hi-lo; ++j)
+    {
+      localSideIds.push_back(tmp[j*length]);
+      localSideNodes.insert(localSideNodes.end(), &tmp[j*length+1], &tmp[(j+1)*length]);
+      localSideTags.push_back(b.tag);
+    }
+  });
+
+  TEUCHOS_TEST_FOR_EXCEPTION (!ifile, std::runtime_error, "Error! Mesh file '" << fname << "' ended unexpectedly.\n");
+
+  // Close the input stream
+  ifile.close();
+}
+
+void Albany::GmshSTKMeshStruct::setParallelBulkData (const Teuchos::RCP<const Teuchos_Comm>& commT)
+{
+  typedef stk::mesh::EntityId EntityId;
+
+  const int rank = commT->getRank();
+  const int size = commT->getSize();
+
+  // The coordinates of the nodes go through a directory: node t is kept by
+  // rank (t-minNodeTag)*size/(maxNodeTag-minNodeTag+1), which also records
+  // the ranks whose elements use it
+  struct DirectoryNode
+  {
+    double coord[3];
+    std::vector<int> ranks;
+  };
+  const EntityId tagRange = maxNodeTag-minNodeTag+1;
+  auto directoryRank = [&](const EntityId tag) -> int { return (tag-minNodeTag)*size/tagRange; };
+
+  std::unordered_map<EntityId,DirectoryNode> directory;
+  {
+    stk::CommAll comm (bulkData->parallel());
+    exchange (comm, [&](stk::CommAll& c)
+    {
+      for (std::size_t i(0); i<localNodeIds.size(); ++i)
+      {
+        stk::CommBuffer& buf = c.send_buffer(directoryRank(localNodeIds[i]));
+        buf.pack<EntityId>(localNodeIds[i]);
+        buf.pack<double>(&localNodeCoords[3*i], 3);
+      }
+    });
+    for (int p(0); p<size; ++p)
+    {
+      stk::CommBuffer& buf = comm.recv_buffer(p);
+      while (buf.remaining())
+      {
+        EntityId tag;
+        buf.unpack<EntityId>(tag);
+        buf.unpack<double>(directory[tag].coord, 3);
+      }
+    }
+  }
+  std::vector<EntityId>().swap(localNodeIds);
+  std::vector<double>().swap(localNodeCoords);
+
+  // The nodes of the local elements
+  std::vector<EntityId> elemNodes(localElemNodes);
+  std::sort(elemNodes.begin(), elemNodes.end());
+  elemNodes.erase(std::unique(elemNodes.begin(), elemNodes.end()), elemNodes.end());
+
+  std::vector<std::vector<EntityId> > requests(size);
+  {
+    stk::CommAll comm (bulkData->parallel());
+    exchange (comm, [&](stk::CommAll& c)
+    {
+      for (EntityId tag : elemNodes)
+        c.send_buffer(directoryRank(tag)).pack<EntityId>(tag);
+    });
+    for (int p(0); p<size; ++p)
+    {
+      stk::CommBuffer& buf = comm.recv_buffer(p);
+      while (buf.remaining())
+      {
+        EntityId tag;
+        buf.unpack<EntityId>(tag);
+        auto it = directory.find(tag);
+        TEUCHOS_TEST_FOR_EXCEPTION (it==directory.end(), std::runtime_error, "Error! Node " << tag << " of an element is not in the nodes section.\n");
+        it->second.ranks.push_back(p);
+        requests[p].push_back(tag);
+      }
+    }
+  }
+
+  // Coordinates of the nodes of the local elements, and the other ranks sharing them
+  std::unordered_map<EntityId,DirectoryNode> nodes;
+  {
+    stk::CommAll comm (bulkData->parallel());
+    exchange (comm, [&](stk::CommAll& c)
+    {
+      for (int p(0); p<size; ++p)
+      {
+        stk::CommBuffer& buf = c.send_buffer(p);
+        for (EntityId tag : requests[p])
+        {
+          const DirectoryNode& dn = directory[tag];
+          buf.pack<EntityId>(tag);
+          buf.pack<double>(dn.coord, 3);
+          buf.pack<int>(dn.ranks.size());
+          buf.pack<int>(dn.ranks.data(), dn.ranks.size());
+        }
+      }
+    });
+    for (int p(0); p<size; ++p)
+    {
+      stk::CommBuffer& buf = comm.recv_buffer(p);
+      while (buf.remaining())
+      {
+        EntityId tag;
+        int num_ranks;
+        buf.unpack<EntityId>(tag);
+        DirectoryNode& node = nodes[tag];
+        buf.unpack<double>(node.coord, 3);
+        buf.unpack<int>(num_ranks);
+        node.ranks.resize(num_ranks);
+        buf.unpack<int>(node.ranks.data(), num_ranks);
+        node.ranks.erase(std::remove(node.ranks.begin(), node.ranks.end(), rank), node.ranks.end());
+      }
+    }
+  }
+  std::vector<std::vector<EntityId> >().swap(requests);
+
+  // Sides go to the directory rank of their smallest node, which forwards them
+  // to all the ranks using that node. Only the rank with the element having
+  // the side keeps it (sides are assumed to be on the boundary, i.e., to have
+  // exactly one element)
+  std::vector<EntityId> sideRecords; // id, tag, nodes
+  const int recordLength = 2+NumSideNodes;
+  {
+    stk::CommAll comm (bulkData->parallel());
+    exchange (comm, [&](stk::CommAll& c)
+    {
+      for (std::size_t i(0); i<localSideIds.size(); ++i)
+      {
+        const EntityId* sideNodes = &localSideNodes[i*NumSideNodes];
+        stk::CommBuffer& buf = c.send_buffer(directoryRank(*std::min_element(sideNodes, sideNodes+NumSideNodes)));
+        buf.pack<EntityId>(localSideIds[i]);
+        buf.pack<EntityId>(localSideTags[i]);
+        buf.pack<EntityId>(sideNodes, NumSideNodes);
+      }
+    });
+    for (int p(0); p<size; ++p)
+    {
+      stk::CommBuffer& buf = comm.recv_buffer(p);
+      while (buf.remaining())
+      {
+        sideRecords.resize(sideRecords.size()+recordLength);
+        buf.unpack<EntityId>(&sideRecords[sideRecords.size()-recordLength], recordLength);
+      }
+    }
+  }
+  std::vector<EntityId>().swap(localSideIds);
+  std::vector<EntityId>().swap(localSideNodes);
+  std::vector<int>().swap(localSideTags);
+  {
+    stk::CommAll comm (bulkData->parallel());
+    exchange (comm, [&](stk::CommAll& c)
+    {
+      for (std::size_t i(0); i<sideRecords.size(); i+=recordLength)
+      {
+        const EntityId* sideNodes = &sideRecords[i+2];
+        auto it = directory.find(*std::min_element(sideNodes, sideNodes+NumSideNodes));
+        if (it==directory.end())
+          continue; // Not a node of any element: caught by the side count below
+        for (int p : it->second.ranks)
+          c.send_buffer(p).pack<EntityId>(&sideRecords[i], recordLength);
+      }
+    });
+    sideRecords.clear();
+    for (int p(0); p<size; ++p)
+    {
+      stk::CommBuffer& buf = comm.recv_buffer(p);
+      while (buf.remaining())
+      {
+        sideRecords.resize(sideRecords.size()+recordLength);
+        buf.unpack<EntityId>(&sideRecords[sideRecords.size()-recordLength], recordLength);
+      }
+    }
+  }
+  directory.clear();
+
+  // Find the local element and its side ordinal for each side
+  const CellTopologyData& ctd = this->meshSpecs[0]->ctd;
+  std::unordered_map<EntityId,std::vector<int> > nodeToElems;
+  for (std::size_t ie(0); ie<localElemIds.size(); ++ie)
+    for (int j(0); j<NumElemNodes; ++j)
+      nodeToElems[localElemNodes[ie*NumElemNodes+j]].push_back(ie);
+
+  std::vector<int> sideElem, sideOrd;
+  std::unordered_map<EntityId,stk::mesh::PartVector> nodeSetParts;
+  for (std::size_t i(0); i<sideRecords.size(); i+=recordLength)
+  {
+    const EntityId* sideNodes = &sideRecords[i+2];
+    const std::vector<int>& candidates = nodeToElems[*std::min_element(sideNodes, sideNodes+NumSideNodes)];
+    int elem(-1), ord(-1);
+    for (std::size_t k(0); k<candidates.size() && elem<0; ++k)
+    {
+      const EntityId* elemNodesK = &localElemNodes[candidates[k]*NumElemNodes];
+      for (int s(0); s<static_cast<int>(ctd.side_count) && elem<0; ++s)
+      {
+        bool match = (static_cast<int>(ctd.side[s].topology->node_count)==NumSideNodes);
+        for (int j(0); j<NumSideNodes && match; ++j)
+          match = std::find(sideNodes, sideNodes+NumSideNodes, elemNodesK[ctd.side[s].node[j]])!=sideNodes+NumSideNodes;
+        if (match)
+        {
+          elem = candidates[k];
+          ord = s;
+        }
+      }
+    }
+    sideElem.push_back(elem);
+    sideOrd.push_back(ord);
+
+    if (elem>=0)
+      for (int j(0); j<NumSideNodes; ++j)
+        nodeSetParts[sideNodes[j]].push_back(nsPartVec[bdTagToNodeSetName[sideRecords[i+1]]]);
+  }
+
+  AbstractSTKFieldContainer::IntScalarFieldType* proc_rank_field = fieldContainer->getProcRankField();
+  AbstractSTKFieldContainer::VectorFieldType* coordinates_field =  fieldContainer->getCoordinatesField();
+
+  // Nodes that no element uses are dropped
+  stk::mesh::PartVector nodePartVec;
+  for (EntityId tag : elemNodes)
+  {
+    nodePartVec.assign(1, nsPartVec["Node"]);
+    std::unordered_map<EntityId,stk::mesh::PartVector>::const_iterator it = nodeSetParts.find(tag);
+    if (it!=nodeSetParts.end())
+      nodePartVec.insert(nodePartVec.end(), it->second.begin(), it->second.end());
+
+    stk::mesh::Entity node = bulkData->declare_entity(stk::topology::NODE_RANK, tag, nodePartVec);
+
+    const DirectoryNode& dn = nodes[tag];
+    for (int p : dn.ranks)
+      bulkData->add_node_sharing(node, p);
+
+    double* coord = stk::mesh::field_data(*coordinates_field, node);
+    for (int d(0); d<numDim; ++d)
+      coord[d] = dn.coord[d];
+  }
+
+  stk::mesh::PartVector singlePartVec(1, partVec[0]);
+  std::vector<stk::mesh::Entity> elements(localElemIds.size());
+  for (std::size_t ie(0); ie<localElemIds.size(); ++ie)
+  {
+    elements[ie] = bulkData->declare_entity(stk::topology::ELEMENT_RANK, localElemIds[ie], singlePartVec);
+    for (int j(0); j<NumElemNodes; ++j)
+    {
+      stk::mesh::Entity node = bulkData->get_entity(stk::topology::NODE_RANK, localElemNodes[ie*NumElemNodes+j]);
+      bulkData->declare_relation(elements[ie], node, j);
+    }
+
+    int* p_rank = stk::mesh::field_data(*proc_rank_field, elements[ie]);
+    p_rank[0] = rank;
+  }
+
+  int numLocalSides(0);
+  stk::mesh::PartVector ssPartVec_i(2);
+  ssPartVec_i[0] = ssPartVec["BoundarySide"]; // The whole boundary side
+  for (std::size_t i(0), k(0); i<sideRecords.size(); i+=recordLength, ++k)
+  {
+    if (sideElem[k]<0)
+      continue;
+
+    ssPartVec_i[1] = ssPartVec[bdTagToSideSetName[sideRecords[i+1]]];
+    stk::mesh::Entity side = bulkData->declare_entity(metaData->side_rank(), sideRecords[i], ssPartVec_i);
+    for (int j(0); j<NumSideNodes; ++j)
+    {
+      stk::mesh::Entity node_j = bulkData->get_entity(stk::topology::NODE_RANK, sideRecords[i+2+j]);
+      bulkData->declare_relation(side, node_j, j);
+    }
+    bulkData->declare_relation(elements[sideElem[k]], side, sideOrd[k]);
+    ++numLocalSides;
+  }
+
+  int numFoundSides(0);
+  Teuchos::reduceAll<int,int>(*commT, Teuchos::REDUCE_SUM, numLocalSides, Teuchos::outArg(numFoundSides));
+  TEUCHOS_TEST_FOR_EXCEPTION (numFoundSides!=NumSides, std::logic_error,
+                              "Error! Found an element for " << numFoundSides << " of the " << NumSides << " sides.\n");
+
+  std::vector<EntityId>().swap(localElemIds);
+  std::vector<EntityId>().swap(localElemNodes);
+}
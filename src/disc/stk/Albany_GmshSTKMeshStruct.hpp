@@ -7,6 +7,9 @@
 
 #include "Albany_GenericSTKMeshStruct.hpp"
 
+#include <set>
+#include <vector>
+
 //#include <Ionit_Initializer.h>
 
 namespace Albany
@@ -44,6 +47,12 @@ class GmshSTKMeshStruct : public GenericSTKMeshStruct
   void loadAsciiMesh (const std::string& fname);
   void loadBinaryMesh (const std::string& fname);
 
+  // MSH 4.1 binary files are read in parallel: each rank reads a contiguous range
+  // of the nodes, elements and sides, then setParallelBulkData exchanges the node
+  // coordinates and sends each side to the rank owning its element
+  void loadParallelBinaryMesh (const std::string& fname, const Teuchos::RCP<const Teuchos_Comm>& commT);
+  void setParallelBulkData (const Teuchos::RCP<const Teuchos_Comm>& commT);
+
   int NumElemNodes; // Number of nodes per element (e.g. 3 for Triangles)
   int NumSideNodes; // Number of nodes per side (e.g. 2 for a Line)
   int NumNodes; //number of nodes
@@ -65,6 +74,19 @@ class GmshSTKMeshStruct : public GenericSTKMeshStruct
   // NOTE: do not call delete on these pointers! Delete the previous ones only!
   int** elems;
   int** sides;
+
+  // Data of a parallel read (only this rank's part of the file)
+  bool parallelRead;
+  std::set<int> fileBdTags;
+  stk::mesh::EntityId minNodeTag;
+  stk::mesh::EntityId maxNodeTag;
+  std::vector<stk::mesh::EntityId> localNodeIds;
+  std::vector<double> localNodeCoords;   // 3 per node
+  std::vector<stk::mesh::EntityId> localElemIds;
+  std::vector<stk::mesh::EntityId> localElemNodes;  // NumElemNodes per element
+  std::vector<stk::mesh::EntityId> localSideIds;
+  std::vector<stk::mesh::EntityId> localSideNodes;  // NumSideNodes per side
+  std::vector<int> localSideTags;
 };
 
 } // Namespace Albany
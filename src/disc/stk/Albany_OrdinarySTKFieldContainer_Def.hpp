@@ -145,6 +145,7 @@ template<bool Interleaved>
 void Albany::OrdinarySTKFieldContainer<Interleaved>::initializeSTKAdaptation() {
 
   typedef typename AbstractSTKFieldContainer::IntScalarFieldType ISFT;
+  typedef typename AbstractSTKFieldContainer::ScalarFieldType SFT;
 
   this->proc_rank_field =
     & this->metaData->template declare_field< ISFT >(stk::topology::ELEMENT_RANK, "proc_rank");
@@ -161,6 +162,16 @@ void Albany::OrdinarySTKFieldContainer<Interleaved>::initializeSTKAdaptation() {
       *this->refine_field,
       this->metaData->universal_part());
 
+  // Measured element cost, the Zoltan object weight of cost-weighted rebalancing
+  this->element_weight_field = NULL;
+  if (this->params->get("Cost-Weighted Rebalance", false)) {
+    this->element_weight_field =
+      & this->metaData->template declare_field< SFT >(stk::topology::ELEMENT_RANK, "element_weight");
+    stk::mesh::put_field(
+        *this->element_weight_field,
+        this->metaData->universal_part());
+  }
+
 #if defined(ALBANY_LCM)
   // Fracture state used for adaptive insertion.
   // It exists for all entities except cells (elements).
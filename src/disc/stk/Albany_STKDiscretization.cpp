@@ -12,9 +12,13 @@
 #include "Albany_STKNodeFieldContainer.hpp"
 #include "Albany_BucketArray.hpp"
 
+#include "Teuchos_TimeMonitor.hpp"
+
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 
 #include <Shards_BasicTopologies.hpp>
 
@@ -35,7 +39,11 @@
 
 #ifdef ALBANY_SEACAS
 #include <Ionit_Initializer.h>
+#include <Ioss_ElementBlock.h>
+#include <Ioss_NodeBlock.h>
+#include <Ioss_Region.h>
 #include <netcdf.h>
+#include <mpi.h>
 
 #ifdef ALBANY_PAR_NETCDF
 extern "C" {
@@ -45,6 +53,7 @@ extern "C" {
 #endif
 
 #include <algorithm>
+#include <memory>
 #if defined(ALBANY_EPETRA)
 #include "Epetra_Export.h"
 #include "EpetraExt_MultiVectorOut.h"
@@ -79,8 +88,12 @@ STKDiscretization(Teuchos::RCP<Albany::AbstractSTKMeshStruct> stkMeshStruct_,
   neq(stkMeshStruct_->neq),
   stkMeshStruct(stkMeshStruct_),
   sideSetEquations(sideSetEquations_),
-  interleavedOrdering(stkMeshStruct_->interleavedOrdering)
+  interleavedOrdering(stkMeshStruct_->interleavedOrdering),
+  meshVersion(0)
 {
+#ifdef ALBANY_SEACAS
+  exoOutputSteps = 0;
+#endif
 #if defined(ALBANY_EPETRA)
   comm = Albany::createEpetraCommFromTeuchosComm(commT_);
 #endif
@@ -91,6 +104,16 @@ STKDiscretization(Teuchos::RCP<Albany::AbstractSTKMeshStruct> stkMeshStruct_,
 Albany::STKDiscretization::~STKDiscretization()
 {
 #ifdef ALBANY_SEACAS
+  // Pending exodus steps write through mesh_data's output region, and the
+  // netCDF library may not be called while the I/O thread writes
+  try {
+    drainAsyncOutput();
+  }
+  catch (const std::exception& e) {
+    *out << "\nWARNING: asynchronous exodus output failed: " << e.what() << std::endl;
+  }
+  asyncWriter.reset();
+
   if (stkMeshStruct->cdfOutput)
       if (netCDFp)
     if (const int ierr = nc_close (netCDFp))
@@ -351,6 +374,7 @@ setReferenceConfigurationManager(const Teuchos::RCP<AAdapt::rc::Manager>& rcm)
 void
 Albany::STKDiscretization::transformMesh()
 {
+  ++meshVersion;
   using std::cout; using std::endl;
   AbstractSTKFieldContainer::VectorFieldType* coordinates_field = stkMeshStruct->getCoordinatesField();
   std::string transformType = stkMeshStruct->transformType;
@@ -697,6 +721,7 @@ writeSolutionToFileT(const Tpetra_Vector& solnT, const double time,
    Teuchos::RCP<AbstractSTKFieldContainer> container = stkMeshStruct->getFieldContainer();
 
    container->transferSolutionToCoords();
+   ++meshVersion;
 
    if (!mesh_data.is_null()) {
      // Mesh coordinates have changed. Rewrite output file by deleting the mesh data object and recreate it
@@ -709,18 +734,7 @@ writeSolutionToFileT(const Tpetra_Vector& solnT, const double time,
 
    double time_label = monotonicTimeLabel(time);
 
-     mesh_data->begin_output_step(outputFileIdx, time_label);
-     int out_step = mesh_data->write_defined_output_fields(outputFileIdx);
-     // Writing mesh global variables
-     for (auto& it : stkMeshStruct->getFieldContainer()->getMeshVectorStates())
-     {
-       mesh_data->write_global (outputFileIdx, it.first, it.second);
-     }
-     for (auto& it : stkMeshStruct->getFieldContainer()->getMeshScalarIntegerStates())
-     {
-       mesh_data->write_global (outputFileIdx, it.first, it.second);
-     }
-     mesh_data->end_output_step(outputFileIdx);
+     int out_step = writeExodusStep(time_label);
 
      if (mapT->getComm()->getRank()==0) {
        *out << "Albany::STKDiscretization::writeSolution: writing time " << time;
@@ -732,6 +746,7 @@ writeSolutionToFileT(const Tpetra_Vector& solnT, const double time,
 
      double time_label = monotonicTimeLabel(time);
 
+     drainAsyncOutput();
      const int out_step = processNetCDFOutputRequestT(solnT);
 
      if (mapT->getComm()->getRank()==0) {
@@ -774,6 +789,7 @@ writeSolutionMVToFile(const Tpetra_MultiVector& solnT, const double time,
    Teuchos::RCP<AbstractSTKFieldContainer> container = stkMeshStruct->getFieldContainer();
 
    container->transferSolutionToCoords();
+   ++meshVersion;
 
    if (!mesh_data.is_null()) {
      // Mesh coordinates have changed. Rewrite output file by deleting the mesh data object and recreate it
@@ -786,18 +802,7 @@ writeSolutionMVToFile(const Tpetra_MultiVector& solnT, const double time,
 
    double time_label = monotonicTimeLabel(time);
 
-     mesh_data->begin_output_step(outputFileIdx, time_label);
-     int out_step = mesh_data->write_defined_output_fields(outputFileIdx);
-     // Writing mesh global variables
-     for (auto& it : stkMeshStruct->getFieldContainer()->getMeshVectorStates())
-     {
-       mesh_data->write_global (outputFileIdx, it.first, it.second);
-     }
-     for (auto& it : stkMeshStruct->getFieldContainer()->getMeshScalarIntegerStates())
-     {
-       mesh_data->write_global (outputFileIdx, it.first, it.second);
-     }
-     mesh_data->end_output_step(outputFileIdx);
+     int out_step = writeExodusStep(time_label);
 
      if (mapT->getComm()->getRank()==0) {
        *out << "Albany::STKDiscretization::writeSolution: writing time " << time;
@@ -809,6 +814,7 @@ writeSolutionMVToFile(const Tpetra_MultiVector& solnT, const double time,
 
      double time_label = monotonicTimeLabel(time);
 
+     drainAsyncOutput();
      const int out_step = processNetCDFOutputRequestMV(solnT);
 
      if (mapT->getComm()->getRank()==0) {
@@ -1372,9 +1378,14 @@ void Albany::STKDiscretization::computeGraphsUpToFillComplete()
   if (commT->getRank()==0)
     *out << "STKDisc: " << cells.size() << " elements on Proc 0 " << std::endl;
 
-  GO row, col;
+  GO row;
   Teuchos::ArrayView<GO> colAV;
 
+  // Column block of the current element (or side): all the eqns of all its
+  // nodes. It is built once per entity and inserted for every row at once,
+  // instead of inserting one index at a time.
+  Teuchos::Array<GO> cols;
+
   // determining the equations that are defined on the whole domain
   std::vector<int> globalEqns;
   for (int k(0); k<neq; ++k)
@@ -1390,6 +1401,16 @@ void Albany::STKDiscretization::computeGraphsUpToFillComplete()
     stk::mesh::Entity const* node_rels = bulkData.begin_nodes(e);
     const size_t num_nodes = bulkData.num_nodes(e);
 
+    // Note: here we cycle through ALL the eqns (not just the global ones),
+    //       since they could all be coupled with this eq
+    cols.resize(num_nodes*neq);
+    for (std::size_t l=0; l < num_nodes; l++)
+    {
+      const GO colNodeGID = gid(node_rels[l]);
+      for (std::size_t m=0; m < neq; m++)
+        cols[l*neq + m] = getGlobalDOF(colNodeGID, m);
+    }
+
     // loop over local nodes
     for (std::size_t j=0; j < num_nodes; j++) {
       stk::mesh::Entity rowNode = node_rels[j];
@@ -1398,16 +1419,7 @@ void Albany::STKDiscretization::computeGraphsUpToFillComplete()
       for (std::size_t k=0; k < globalEqns.size(); ++k)
       {
         row = getGlobalDOF(gid(rowNode), globalEqns[k]);
-        for (std::size_t l=0; l < num_nodes; l++)
-        {
-          stk::mesh::Entity colNode = node_rels[l];
-          for (std::size_t m=0; m < neq; m++) // Note: here we cycle through ALL the eqns (not just the global ones),
-          {                                   //       since they could all be coupled with this eq
-            col = getGlobalDOF(gid(colNode), m);
-            colAV = Teuchos::arrayView(&col, 1);
-            overlap_graphT->insertGlobalIndices(row, colAV);
-          }
-        }
+        overlap_graphT->insertGlobalIndices(row, cols());
       }
     }
   }
@@ -1453,25 +1465,21 @@ void Albany::STKDiscretization::computeGraphsUpToFillComplete()
           stk::mesh::Entity const* node_rels = bulkData.begin_nodes(sidee);
           const size_t num_nodes = bulkData.num_nodes(sidee);
 
+          // all the equations of the side nodes (the eq may be coupled with other eqns)
+          cols.resize(num_nodes*neq);
+          for (std::size_t j=0; j < num_nodes; j++)
+          {
+            const GO colNodeGID = gid(node_rels[j]);
+            for (std::size_t m=0; m < neq; m++)
+              cols[j*neq + m] = getGlobalDOF(colNodeGID, m);
+          }
+
           // loop over local nodes of the side (row)
           for (std::size_t i=0; i < num_nodes; i++)
           {
             stk::mesh::Entity rowNode = node_rels[i];
             row = getGlobalDOF(gid(rowNode), eq);
-
-            // loop over local nodes of the side (col)
-            for (std::size_t j=0; j < num_nodes; j++)
-            {
-              stk::mesh::Entity colNode = node_rels[j];
-
-             // loop on all the equations (the eq may be coupled with other eqns)
-              for (std::size_t m=0; m < neq; m++)
-              {
-                col = getGlobalDOF(gid(colNode), m);
-                colAV = Teuchos::arrayView(&col, 1);
-                overlap_graphT->insertGlobalIndices(row, colAV);
-              }
-            }
+            overlap_graphT->insertGlobalIndices(row, cols());
           }
         }
       }
@@ -1541,6 +1549,16 @@ void Albany::STKDiscretization::insertPeridigmNonzerosIntoGraph()
 #endif
 }
 
+void Albany::STKDiscretization::addWorksetCost(const int ws, const double seconds)
+{
+  if (ws >= wsElementWeights.size()) return;
+  Teuchos::ArrayRCP<double>& weights = wsElementWeights[ws];
+  if (weights.size() == 0) return;
+  const double cost = seconds / weights.size();
+  for (int i=0; i < weights.size(); i++)
+    weights[i] += cost;
+}
+
 void Albany::STKDiscretization::computeWorksetInfo()
 {
 
@@ -1583,6 +1601,13 @@ void Albany::STKDiscretization::computeWorksetInfo()
     }
   }
 
+  // Measured element cost for cost-weighted rebalancing
+  ScalarFieldType* weight_field = stkMeshStruct->getFieldContainer()->getElementWeightField();
+  wsElementWeights.resize(weight_field != NULL ? numBuckets : 0);
+  for (int b=0; b < wsElementWeights.size(); b++)
+    wsElementWeights[b] = Teuchos::ArrayRCP<double>(
+        stk::mesh::field_data(*weight_field, *buckets[b]), 0, buckets[b]->size(), false);
+
   wsPhysIndex.resize(numBuckets);
   if (stkMeshStruct->allElementBlocksHaveSamePhysics)
     for (int i=0; i<numBuckets; i++) wsPhysIndex[i]=0;
@@ -2182,6 +2207,12 @@ void Albany::STKDiscretization::setupExodusOutput()
 #ifdef ALBANY_SEACAS
   if (stkMeshStruct->exoOutput) {
 
+    // Finish the steps still queued for the previous file first
+    drainAsyncOutput();
+    asyncWriter.reset();
+    exoOutputSteps = 0;
+    exoOutputEntities.clear();
+
     outputInterval = 0;
 
     std::string str = stkMeshStruct->exoOutFile;
@@ -2213,6 +2244,23 @@ void Albany::STKDiscretization::setupExodusOutput()
       }
       catch (std::runtime_error const&) { }
     }
+
+    if (stkMeshStruct->asyncOutput) {
+      // The I/O thread calls into the parallel exodus library while the
+      // main thread keeps communicating.
+      int provided = MPI_THREAD_SINGLE;
+      MPI_Query_thread(&provided);
+      if (commT->getSize() > 1 && provided < MPI_THREAD_MULTIPLE) {
+        if (commT->getRank() == 0)
+          *out << "\nWARNING: Asynchronous Exodus Output requires MPI_THREAD_MULTIPLE:"
+               << " writing exodus output synchronously\n" << std::endl;
+      }
+      else {
+        // Shared with the side set discretizations and any other output file
+        const double bytes = stkMeshStruct->asyncOutputStagingMB*1024.0*1024.0;
+        asyncWriter = AsyncOutputWriter::shared(static_cast<std::size_t>(bytes));
+      }
+    }
   }
 #else
   if (stkMeshStruct->exoOutput)
@@ -2222,6 +2270,164 @@ void Albany::STKDiscretization::setupExodusOutput()
 #endif
 }
 
+#ifdef ALBANY_SEACAS
+int Albany::STKDiscretization::writeExodusStep(const double time_label)
+{
+  // The first step defines the output mesh and the transient fields, which
+  // only stk_io knows how to do: always write it synchronously, after the
+  // steps other output files still have queued.
+  if (!asyncWriter || exoOutputSteps == 0) {
+    drainAsyncOutput();
+    mesh_data->begin_output_step(outputFileIdx, time_label);
+    int out_step = mesh_data->write_defined_output_fields(outputFileIdx);
+    // Writing mesh global variables
+    for (auto& it : stkMeshStruct->getFieldContainer()->getMeshVectorStates())
+    {
+      mesh_data->write_global (outputFileIdx, it.first, it.second);
+    }
+    for (auto& it : stkMeshStruct->getFieldContainer()->getMeshScalarIntegerStates())
+    {
+      mesh_data->write_global (outputFileIdx, it.first, it.second);
+    }
+    mesh_data->end_output_step(outputFileIdx);
+    exoOutputSteps = out_step;
+
+    if (asyncWriter && !recordExodusOutputOrder()) {
+      *out << "\nWARNING: cannot recover the entity order of "
+           << stkMeshStruct->exoOutFile
+           << ": writing exodus output synchronously\n" << std::endl;
+      asyncWriter.reset();
+    }
+    return out_step;
+  }
+
+  stageExodusStep(time_label);
+  return ++exoOutputSteps;
+}
+
+bool Albany::STKDiscretization::recordExodusOutputOrder()
+{
+  // stk_io wrote the ids of the node and element blocks with the first
+  // step; the Ioss database keeps them, in the order the field data of the
+  // later steps has to follow.
+  exoOutputEntities.clear();
+
+  Teuchos::RCP<Ioss::Region> region = mesh_data->get_output_io_region(outputFileIdx);
+  std::vector<std::pair<Ioss::GroupingEntity*, stk::mesh::EntityRank> > blocks;
+  for (auto nb : region->get_node_blocks())
+    blocks.push_back(std::make_pair(nb, stk::topology::NODE_RANK));
+  for (auto eb : region->get_element_blocks())
+    blocks.push_back(std::make_pair(eb, stk::topology::ELEMENT_RANK));
+
+  try {
+    for (auto& block : blocks) {
+      Ioss::GroupingEntity* entity = block.first;
+
+      std::vector<stk::mesh::EntityId> ids;
+      if (entity->field_int_type() == Ioss::Field::INT64) {
+        std::vector<int64_t> fileIds;
+        entity->get_field_data("ids", fileIds);
+        ids.assign(fileIds.begin(), fileIds.end());
+      }
+      else {
+        std::vector<int> fileIds;
+        entity->get_field_data("ids", fileIds);
+        ids.assign(fileIds.begin(), fileIds.end());
+      }
+      if (static_cast<int64_t>(ids.size()) != entity->get_property("entity_count").get_int())
+        return false;
+
+      std::vector<stk::mesh::Entity>& entities = exoOutputEntities[entity->name()];
+      entities.reserve(ids.size());
+      for (auto id : ids) {
+        const stk::mesh::Entity e = bulkData.get_entity(block.second, id);
+        if (!bulkData.is_valid(e)) return false;
+        entities.push_back(e);
+      }
+    }
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+void Albany::STKDiscretization::stageExodusStep(const double time_label)
+{
+  // Copy every transient field of the output region out of the STK mesh,
+  // in the entity order of the file's id maps, so that the mesh can change
+  // while the I/O thread writes the copy.
+  struct StagedField {
+    Ioss::GroupingEntity* entity;
+    std::string name;
+    std::vector<double> data;
+  };
+
+  Teuchos::RCP<Ioss::Region> region = mesh_data->get_output_io_region(outputFileIdx);
+  auto staged = std::make_shared<std::vector<StagedField> >();
+  std::size_t bytes = 0;
+
+  std::vector<std::pair<Ioss::GroupingEntity*, stk::mesh::EntityRank> > blocks;
+  for (auto nb : region->get_node_blocks())
+    blocks.push_back(std::make_pair(nb, stk::topology::NODE_RANK));
+  for (auto eb : region->get_element_blocks())
+    blocks.push_back(std::make_pair(eb, stk::topology::ELEMENT_RANK));
+
+  for (auto& block : blocks) {
+    Ioss::GroupingEntity* entity = block.first;
+    const stk::mesh::EntityRank rank = block.second;
+
+    const std::vector<stk::mesh::Entity>& entities = exoOutputEntities.at(entity->name());
+
+    Ioss::NameList names;
+    entity->field_describe(Ioss::Field::TRANSIENT, &names);
+    for (auto& name : names) {
+      const stk::mesh::FieldBase* field = metaData.get_field(rank, name);
+      if (field == NULL || field->type_is<double>() == false) continue;
+
+      const int ncomp = entity->get_field(name).raw_storage()->component_count();
+      StagedField sf;
+      sf.entity = entity;
+      sf.name = name;
+      sf.data.assign(entities.size()*ncomp, 0.0);
+      for (std::size_t i = 0; i < entities.size(); ++i) {
+        const double* values = static_cast<const double*>(stk::mesh::field_data(*field, entities[i]));
+        if (values == NULL) continue;
+        const int n = std::min<int>(ncomp, stk::mesh::field_scalars_per_entity(*field, entities[i]));
+        std::copy(values, values + n, sf.data.begin() + i*ncomp);
+      }
+      bytes += sf.data.size()*sizeof(double);
+      staged->push_back(sf);
+    }
+  }
+
+  auto vectorGlobals = std::make_shared<AbstractSTKFieldContainer::MeshVectorState>(
+      stkMeshStruct->getFieldContainer()->getMeshVectorStates());
+  auto intGlobals = std::make_shared<AbstractSTKFieldContainer::MeshScalarIntegerState>(
+      stkMeshStruct->getFieldContainer()->getMeshScalarIntegerStates());
+
+  // stk_io left the region in transient mode after the first step
+  asyncWriter->submit(bytes, [region, staged, vectorGlobals, intGlobals, time_label]() {
+    const int step = region->add_state(time_label);
+    region->begin_state(step);
+    for (auto& sf : *staged)
+      sf.entity->put_field_data(sf.name, sf.data.data(), sf.data.size()*sizeof(double));
+    for (auto& it : *vectorGlobals)
+      region->put_field_data(it.first, it.second);
+    for (auto& it : *intGlobals)
+      region->put_field_data(it.first, &it.second, sizeof(int));
+    region->end_state(step);
+  });
+}
+
+void Albany::STKDiscretization::drainAsyncOutput()
+{
+  // The writer is shared by all output files, and this discretization may
+  // be about to call the exodus or netCDF library itself
+  AsyncOutputWriter::drainShared();
+}
+#endif
+
 namespace {
   const std::vector<double> spherical_to_cart(const std::pair<double, double> & sphere){
     const double radius_of_earth = 1;
@@ -2476,31 +2682,139 @@ namespace {
     return ref;
   }
 
-  const std::pair<bool,std::pair<unsigned, unsigned> >point_in_element(const std::pair<double, double> &sphere,
-      const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords,
-      std::pair<double, double> &parametric) {
-    const std::vector<double> sphere_xyz = spherical_to_cart(sphere);
-    std::pair<bool,std::pair<unsigned, unsigned> > element(false,std::pair<unsigned, unsigned>(0,0));
-    for (unsigned i=0; i<coords.size() && !element.first; ++i) {
-      for (unsigned j=0; j<coords[i].size() && !element.first; ++j) {
-        const bool found =  point_inside(coords[i][j], sphere_xyz);
-        if (found) {
-          parametric = parametric_coordinates(coords[i][j], sphere);
-          if (parametric.first  < -1) parametric.first  = -1;
-          if (parametric.second < -1) parametric.second = -1;
-          if (1 < parametric.first  ) parametric.first  =  1;
-          if (1 < parametric.second ) parametric.second =  1;
-          element.first         = true;
-          element.second.first  = i;
-          element.second.second = j;
-        }
+  //! Range of output grid indices that can fall inside an element. The
+  //! element lies in the spherical cap centered at its corner centroid that
+  //! reaches its farthest corner; the cap is converted to a lat/lon box.
+  //! Longitude indices [j0,j1] may run past either end and wrap around nlon.
+  void element_latlon_range(const Teuchos::ArrayRCP<double*> &coords,
+                            const unsigned nlat, const unsigned nlon,
+                            int &i0, int &i1, int &j0, int &j1) {
+    double corner[4][3];
+    double center[3] = {0,0,0};
+    for (unsigned i=0; i<4; ++i) {
+      const double r = std::sqrt(coords[i][0]*coords[i][0] +
+                                 coords[i][1]*coords[i][1] +
+                                 coords[i][2]*coords[i][2]);
+      for (unsigned k=0; k<3; ++k) {
+        corner[i][k] = coords[i][k]/r;
+        center[k] += corner[i][k];
       }
     }
-    return element;
+    const double rc = std::sqrt(center[0]*center[0] + center[1]*center[1] + center[2]*center[2]);
+    for (unsigned k=0; k<3; ++k) center[k] /= rc;
+
+    double radius = 0;
+    for (unsigned i=0; i<4; ++i) {
+      const double dot = center[0]*corner[i][0] + center[1]*corner[i][1] + center[2]*corner[i][2];
+      radius = std::max(radius, std::acos(std::min(1.0, dot)));
+    }
+    // pad for the tolerance in point_inside and for round-off
+    radius = 1.05*radius + 1e-10;
+
+    const double latc = std::asin(std::max(-1.0, std::min(1.0, center[2])));
+    const double lonc = std::atan2(center[1], center[0]);
+    const double dlat = pi/(nlat-1);
+    const double dlon = 2*pi/nlon;
+
+    i0 = std::max(0,          (int) std::ceil ((latc - radius + pi/2)/dlat));
+    i1 = std::min((int)nlat-1, (int) std::floor((latc + radius + pi/2)/dlat));
+
+    if (pi/2 <= std::abs(latc) + radius) {
+      // cap contains a pole: any longitude
+      j0 = 0;
+      j1 = nlon-1;
+    } else {
+      const double width = std::asin(std::sin(radius)/std::cos(latc));
+      j0 = (int) std::ceil ((lonc - width)/dlon);
+      j1 = (int) std::floor((lonc + width)/dlon);
+      if ((int)nlon <= j1 - j0) { j0 = 0; j1 = nlon-1; }
+    }
+  }
+
+  //! Weighted sum of the element corner coordinates. Stored with the
+  //! interpolation cache to reject files written for another mesh.
+  double coords_checksum(
+    const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords) {
+    double sum = 0;
+    for (unsigned b=0; b<coords.size(); ++b)
+      for (unsigned e=0; e<coords[b].size(); ++e)
+        for (unsigned i=0; i<4; ++i)
+          for (unsigned k=0; k<3; ++k)
+            sum += (i+1)*(k+1)*coords[b][e][i][k];
+    return sum;
+  }
+
+  std::string latlon_interp_cache_name(const std::string &base,
+                                       const Teuchos::RCP<const Teuchos_Comm> commT) {
+    std::ostringstream name;
+    name << base << "." << commT->getSize() << "." << commT->getRank();
+    return name.str();
+  }
+
+  //! Read this rank's interpolation data. Returns false, leaving interpdata
+  //! empty, if the file is missing or was written for a different grid,
+  //! mesh or partition.
+  bool read_latlon_interp(
+    const std::string &file,
+    const unsigned nlat, const unsigned nlon,
+    const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords,
+    Albany::WorksetArray<Teuchos::ArrayRCP<std::vector<Albany::STKDiscretization::interp> > >::type& interpdata) {
+
+    std::ifstream in(file.c_str());
+    if (!in) return false;
+
+    unsigned file_nlat=0, file_nlon=0, nws=0;
+    double checksum=0;
+    in >> file_nlat >> file_nlon >> nws >> checksum;
+    if (!in || file_nlat != nlat || file_nlon != nlon || nws != coords.size()) return false;
+    const double sum = coords_checksum(coords);
+    if (1e-10*(1+std::abs(sum)) < std::abs(checksum-sum)) return false;
+    for (unsigned b=0; b<nws; ++b) {
+      unsigned nelem=0;
+      in >> nelem;
+      if (!in || nelem != coords[b].size()) return false;
+    }
+
+    bool ok = true;
+    unsigned rb, re;
+    Albany::STKDiscretization::interp interp;
+    while (ok && in >> rb >> re >> interp.latitude_longitude.first >> interp.latitude_longitude.second
+                   >> interp.parametric_coords.first >> interp.parametric_coords.second) {
+      ok = rb < coords.size() && re < coords[rb].size() &&
+           interp.latitude_longitude.first < nlat && interp.latitude_longitude.second < nlon;
+      if (ok) interpdata[rb][re].push_back(interp);
+    }
+    ok = ok && in.eof();
+    if (!ok)
+      for (unsigned b=0; b<interpdata.size(); ++b)
+        for (unsigned e=0; e<interpdata[b].size(); ++e) interpdata[b][e].clear();
+    return ok;
+  }
+
+  void write_latlon_interp(
+    const std::string &file,
+    const unsigned nlat, const unsigned nlon,
+    const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords,
+    const Albany::WorksetArray<Teuchos::ArrayRCP<std::vector<Albany::STKDiscretization::interp> > >::type& interpdata) {
+
+    std::ofstream out(file.c_str());
+    TEUCHOS_TEST_FOR_EXCEPTION(!out, std::runtime_error,
+      "Cannot open NetCDF interpolation cache file " << file << std::endl);
+    out << std::setprecision(17);
+    out << nlat << " " << nlon << " " << coords.size() << " " << coords_checksum(coords) << "\n";
+    for (unsigned b=0; b<coords.size(); ++b) out << coords[b].size() << "\n";
+    for (unsigned b=0; b<interpdata.size(); ++b)
+      for (unsigned e=0; e<interpdata[b].size(); ++e)
+        for (unsigned n=0; n<interpdata[b][e].size(); ++n) {
+          const Albany::STKDiscretization::interp &interp = interpdata[b][e][n];
+          out << b << " " << e << " "
+              << interp.latitude_longitude.first << " " << interp.latitude_longitude.second << " "
+              << interp.parametric_coords.first  << " " << interp.parametric_coords.second  << "\n";
+        }
   }
 
   void setup_latlon_interp(
-    const unsigned nlat, const double nlon,
+    const unsigned nlat, const unsigned nlon,
     const Albany::WorksetArray<Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > >::type& coords,
     Albany::WorksetArray<Teuchos::ArrayRCP<std::vector<Albany::STKDiscretization::interp> > >::type& interpdata,
     const Teuchos::RCP<const Teuchos_Comm> commT) {
@@ -2510,30 +2824,54 @@ namespace {
     std::vector<double> lat(nlat);
     std::vector<double> lon(nlon);
 
-    unsigned count=0;
     for (unsigned i=0; i<nlat; ++i) lat[i] = -pi/2 + i*pi/(nlat-1);
     for (unsigned j=0; j<nlon; ++j) lon[j] =       2*j*pi/nlon;
+
+    // Element containing each grid point. Each element only tests the grid
+    // points in its lat/lon box, so the search is linear in the grid size
+    // plus the mesh size. Elements are visited in workset order and the first
+    // one containing a point keeps it, as a scan over all elements would.
+    const unsigned none = std::numeric_limits<unsigned>::max();
+    std::vector<std::pair<unsigned, unsigned> > owner(nlat*nlon, std::pair<unsigned, unsigned>(none,0));
+    for (unsigned b=0; b<coords.size(); ++b) {
+      for (unsigned e=0; e<coords[b].size(); ++e) {
+        int i0, i1, j0, j1;
+        element_latlon_range(coords[b][e], nlat, nlon, i0, i1, j0, j1);
+        for (int i=i0; i<=i1; ++i) {
+          for (int jw=j0; jw<=j1; ++jw) {
+            const unsigned j = (jw % (int)nlon + nlon) % nlon;
+            std::pair<unsigned, unsigned> &o = owner[i*nlon+j];
+            if (o.first != none) continue;
+            const std::pair<double, double> sphere(lat[i],lon[j]);
+            if (point_inside(coords[b][e], spherical_to_cart(sphere)))
+              o = std::pair<unsigned, unsigned>(b,e);
+          }
+        }
+      }
+    }
+
     for (unsigned i=0; i<nlat; ++i) {
       for (unsigned j=0; j<nlon; ++j) {
+        const std::pair<unsigned, unsigned> &o = owner[i*nlon+j];
+        if (o.first == none) continue;
+        const unsigned b = o.first ;
+        const unsigned e = o.second;
         const std::pair<double, double> sphere(lat[i],lon[j]);
-        std::pair<double, double> paramtric;
-        const std::pair<bool,std::pair<unsigned, unsigned> >element = point_in_element(sphere, coords, paramtric);
-        if (element.first) {
-          // compute error: map 'cart' back to sphere and compare with original
-          // interpolation point:
-          const unsigned b = element.second.first ;
-          const unsigned e = element.second.second;
-          const std::vector<double> sphere2_xyz = spherical_to_cart(ref2sphere(coords[b][e], paramtric));
-          const std::vector<double> sphere_xyz  = spherical_to_cart(sphere);
-          err = std::max(err, ::distance(&sphere2_xyz[0],&sphere_xyz[0]));
-          Albany::STKDiscretization::interp interp;
-          interp.parametric_coords = paramtric;
-          interp.latitude_longitude = std::pair<unsigned,unsigned>(i,j);
-          interpdata[b][e].push_back(interp);
-          ++count;
-        }
+        std::pair<double, double> paramtric = parametric_coordinates(coords[b][e], sphere);
+        if (paramtric.first  < -1) paramtric.first  = -1;
+        if (paramtric.second < -1) paramtric.second = -1;
+        if (1 < paramtric.first  ) paramtric.first  =  1;
+        if (1 < paramtric.second ) paramtric.second =  1;
+        // compute error: map 'cart' back to sphere and compare with original
+        // interpolation point:
+        const std::vector<double> sphere2_xyz = spherical_to_cart(ref2sphere(coords[b][e], paramtric));
+        const std::vector<double> sphere_xyz  = spherical_to_cart(sphere);
+        err = std::max(err, ::distance(&sphere2_xyz[0],&sphere_xyz[0]));
+        Albany::STKDiscretization::interp interp;
+        interp.parametric_coords = paramtric;
+        interp.latitude_longitude = std::pair<unsigned,unsigned>(i,j);
+        interpdata[b][e].push_back(interp);
       }
-      if (!rank && (!(i%64) || i==nlat-1)) std::cout<< "Finished Latitude "<<i<<" of "<<nlat<<std::endl;
     }
     if (!rank) std::cout<<"Max interpolation point search error: "<<err<<std::endl;
   }
@@ -2558,6 +2896,7 @@ void Albany::STKDiscretization::setupNetCDFOutput()
   const long long unsigned rank = commT->getRank();
 #ifdef ALBANY_SEACAS
   if (stkMeshStruct->cdfOutput) {
+    drainAsyncOutput();
     outputInterval = 0;
     const unsigned nlat = stkMeshStruct->nLat;
     const unsigned nlon = stkMeshStruct->nLon;
@@ -2568,7 +2907,14 @@ void Albany::STKDiscretization::setupNetCDFOutput()
     interpolateData.resize(coords.size());
     for (int b=0; b < coords.size(); b++) interpolateData[b].resize(coords[b].size());
 
-    setup_latlon_interp(nlat, nlon, coords, interpolateData, commT);
+    const std::string cache = stkMeshStruct->cdfInterpCacheFile.empty() ? std::string() :
+      latlon_interp_cache_name(stkMeshStruct->cdfInterpCacheFile, commT);
+    if (!cache.empty() && read_latlon_interp(cache, nlat, nlon, coords, interpolateData)) {
+      if (!rank) std::cout<<"Read NetCDF interpolation data from "<<stkMeshStruct->cdfInterpCacheFile<<std::endl;
+    } else {
+      setup_latlon_interp(nlat, nlon, coords, interpolateData, commT);
+      if (!cache.empty()) write_latlon_interp(cache, nlat, nlon, coords, interpolateData);
+    }
 
     const std::string name = stkMeshStruct->cdfOutFile;
     netCDFp=0;
@@ -2692,6 +3038,8 @@ void Albany::STKDiscretization::reNameExodusOutput(std::string& filename)
 #ifdef ALBANY_SEACAS
   if (stkMeshStruct->exoOutput && !mesh_data.is_null()) {
     // Delete the mesh data object and recreate it
+    drainAsyncOutput();
+    asyncWriter.reset();
     mesh_data = Teuchos::null;
 
     stkMeshStruct->exoOutFile = filename;
@@ -2960,6 +3308,8 @@ void Albany::STKDiscretization::buildSideSetProjectors()
 void
 Albany::STKDiscretization::updateMesh(bool /*shouldTransferIPData*/)
 {
+  ++meshVersion;
+
   const Albany::StateInfoStruct& nodal_param_states = stkMeshStruct->getFieldContainer()->getNodalParameterSIS();
   nodalDOFsStructContainer.addEmptyDOFsStruct("ordinary_solution", "", neq);
   nodalDOFsStructContainer.addEmptyDOFsStruct("mesh_nodes", "", 1);
@@ -2975,10 +3325,11 @@ Albany::STKDiscretization::updateMesh(bool /*shouldTransferIPData*/)
     nodalDOFsStructContainer.addEmptyDOFsStruct(param_state.name, param_state.meshPart,numComps);
     }
 
+  { TEUCHOS_FUNC_TIME_MONITOR("> Albany Setup: STKDisc Owned Maps");
   computeNodalMaps(false);
 
-
   computeOwnedNodesAndUnknowns();
+  }
 
 #ifdef OUTPUT_TO_SCREEN
   //write owned maps to matrix market file for debug
@@ -2988,30 +3339,44 @@ Albany::STKDiscretization::updateMesh(bool /*shouldTransferIPData*/)
 
   setupMLCoords();
 
+  { TEUCHOS_FUNC_TIME_MONITOR("> Albany Setup: STKDisc Overlap Maps");
   computeNodalMaps(true);
 
   computeOverlapNodesAndUnknowns();
+  }
 
   transformMesh();
 
+  { TEUCHOS_FUNC_TIME_MONITOR("> Albany Setup: STKDisc Jacobian Graphs");
   computeGraphs();
+  }
 
+  { TEUCHOS_FUNC_TIME_MONITOR("> Albany Setup: STKDisc Worksets");
   computeWorksetInfo();
+  }
 #ifdef OUTPUT_TO_SCREEN
   printConnectivity();
 #endif
 
+  { TEUCHOS_FUNC_TIME_MONITOR("> Albany Setup: STKDisc Node and Side Sets");
   computeNodeSets();
 
   computeSideSets();
+  }
 
+  { TEUCHOS_FUNC_TIME_MONITOR("> Albany Setup: STKDisc Exodus Output Setup");
   setupExodusOutput();
+  }
 
   // Build the node graph needed for the mass matrix for solution transfer and projection operations
   // FIXME this only needs to be called if we are using the L2 Projection response
+  { TEUCHOS_FUNC_TIME_MONITOR("> Albany Setup: STKDisc Node Graph");
   meshToGraph();
+  }
 //  printVertexConnectivity();
+  { TEUCHOS_FUNC_TIME_MONITOR("> Albany Setup: STKDisc NetCDF Output Setup");
   setupNetCDFOutput();
+  }
 //meshToGraph();
 //printVertexConnectivity();
 
@@ -3035,3 +3400,11 @@ Albany::STKDiscretization::updateMesh(bool /*shouldTransferIPData*/)
     buildSideSetProjectors();
   }
 }
+
+void
+Albany::STKDiscretization::updateGeometry()
+{
+  ++meshVersion;
+
+  setupMLCoords();
+}
@@ -36,6 +36,7 @@
 #include <stk_mesh/base/FieldTraits.hpp>
 #ifdef ALBANY_SEACAS
   #include <stk_io/StkMeshIoBroker.hpp>
+  #include "Albany_AsyncOutputWriter.hpp"
 #endif
 
 
@@ -263,12 +264,39 @@ namespace Albany {
     //! STK supports MOR
     virtual bool supportsMOR() const { return true; }
 
+    //! Mesh version; -1 unless "Cache Geometry" is set in the discretization
+    int getMeshVersion() const
+    {
+      return stkMeshStruct->cacheGeometry ? meshVersion : -1;
+    }
+
+    //! Number of geometry changes of the mesh, counted whether or not
+    //! "Cache Geometry" is set
+    int getMeshChangeCount() const { return meshVersion; }
+
+    bool singlePrecisionGeometryCache() const
+    {
+      return stkMeshStruct->singlePrecisionGeometryCache;
+    }
+
+    //! True if "Cost-Weighted Rebalance" is set
+    bool measuresWorksetCost() const { return wsElementWeights.size() > 0; }
+
+    //! Add seconds/(number of elements) to the element weight of each element
+    //! of workset ws. Worksets own distinct elements, so concurrent calls for
+    //! different worksets are safe.
+    void addWorksetCost(const int ws, const double seconds);
+
     //! If restarting, convenience function to return restart data time
     double restartDataTime() const {return stkMeshStruct->restartDataTime();}
 
     //! After mesh modification, need to update the element connectivity and nodal coordinates
     void updateMesh(bool shouldTransferIPData = false);
 
+    //! After the nodal coordinates were changed in place (same mesh topology),
+    //! invalidate cached geometry and refresh the multigrid coordinates
+    void updateGeometry();
+
     //! Function that transforms an STK mesh of a unit cube (for FELIX problems)
     void transformMesh();
 
@@ -359,6 +387,16 @@ namespace Albany {
     void computeSideSets();
     //! Call stk_io for creating exodus output file
     void setupExodusOutput();
+#ifdef ALBANY_SEACAS
+    //! Write the current fields to the exodus file; returns the output step
+    int writeExodusStep(const double time_label);
+    //! Read back the entity order of the output blocks from their id maps
+    bool recordExodusOutputOrder();
+    //! Copy the output fields and hand the step to the asynchronous writer
+    void stageExodusStep(const double time_label);
+    //! Wait for the pending asynchronous writes of every output file
+    void drainAsyncOutput();
+#endif
     //! Call stk_io for creating NetCDF output file
     void setupNetCDFOutput();
 
@@ -511,9 +549,25 @@ namespace Albany {
     int outputInterval;
 
     size_t outputFileIdx;
+
+    //! Process-wide writer used when "Asynchronous Exodus Output" is set
+    std::shared_ptr<AsyncOutputWriter> asyncWriter;
+
+    //! Steps written to the current exodus file
+    int exoOutputSteps;
+
+    //! Locally written entities of each output block, in file order
+    std::map<std::string, std::vector<stk::mesh::Entity> > exoOutputEntities;
 #endif
     bool interleavedOrdering;
 
+    //! Bumped whenever the mesh geometry changes (see getMeshVersion)
+    int meshVersion;
+
+    //! Element weight field data of each workset (empty unless
+    //! "Cost-Weighted Rebalance" is set)
+    Albany::WorksetArray<Teuchos::ArrayRCP<double> >::type wsElementWeights;
+
   private:
 
     Teuchos::RCP<Tpetra_CrsGraph> nodalGraph;
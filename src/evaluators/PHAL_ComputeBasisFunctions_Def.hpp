@@ -92,6 +92,16 @@ evaluateFields(typename Traits::EvalData workset)
   //int containerSize = workset.numCells;
     */
 
+  if (geometryCache.haveStoredData(workset)) {
+    geometryCache.load(weighted_measure);
+    geometryCache.load(jacobian_det);
+    geometryCache.load(BF);
+    geometryCache.load(wBF);
+    geometryCache.load(GradBF);
+    geometryCache.load(wGradBF);
+    return;
+  }
+
   typedef typename Intrepid2::CellTools<MeshScalarT>   ICT;
   typedef Intrepid2::FunctionSpaceTools                IFST;
 
@@ -104,6 +114,14 @@ evaluateFields(typename Traits::EvalData workset)
   IFST::multiplyMeasure<MeshScalarT>    (wBF, weighted_measure, BF);
   IFST::HGRADtransformGRAD<MeshScalarT> (GradBF, jacobian_inv, grad_at_cub_points);
   IFST::multiplyMeasure<MeshScalarT>    (wGradBF, weighted_measure, GradBF);
+
+  geometryCache.store(weighted_measure);
+  geometryCache.store(jacobian_det);
+  geometryCache.store(BF);
+  geometryCache.store(wBF);
+  geometryCache.store(GradBF);
+  geometryCache.store(wGradBF);
+  geometryCache.setStored();
 }
 
 //**********************************************************************
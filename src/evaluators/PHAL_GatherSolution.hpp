@@ -16,6 +16,7 @@
 #include "Phalanx_MDField.hpp"
 
 #include "Albany_Layouts.hpp"
+#include "utility/PerformanceProbe.hpp"
 
 #include "Teuchos_ParameterList.hpp"
 #if defined(ALBANY_EPETRA)
@@ -74,6 +75,16 @@ protected:
   unsigned short int tensorRank;
   bool enableTransient;
   bool enableAcceleration;
+
+  // Instrumentation, named after the evaluator; bytes count the values read
+  // from the global solution vectors
+  util::PerformanceProbe probe;
+  std::size_t gatheredBytes(typename Traits::EvalData workset) const {
+    const std::size_t numVectors = 1
+      + ((workset.transientTerms && enableTransient) ? 1 : 0)
+      + ((workset.accelerationTerms && enableAcceleration) ? 1 : 0);
+    return workset.numCells*numNodes*numFieldsBase*numVectors*sizeof(ST);
+  }
 #ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT 
  typedef typename Kokkos::View<double*,PHX::Device>::execution_space executionSpace;
  Kokkos::vector< PHX::MDField<ScalarT, Cell, Node>, PHX::Device > val_kokkos;
@@ -0,0 +1,189 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef PHAL_GEOMETRYCACHE_HPP
+#define PHAL_GEOMETRYCACHE_HPP
+
+#include <map>
+#include <type_traits>
+#include <vector>
+
+#include "Intrepid2_FieldContainer.hpp"
+#include "Phalanx_MDField.hpp"
+#include "Sacado_Traits.hpp"
+
+#include "Albany_AbstractDiscretization.hpp"
+
+namespace PHAL {
+
+/** \brief Per-workset cache of geometry-only evaluator output
+
+    Evaluators whose output depends only on the mesh coordinates (basis
+    functions, Jacobians, measures, ...) can store their fields or Intrepid2
+    field containers here after computing them and load them on later
+    evaluations of the same workset, as long as the discretization's mesh
+    version does not change. Caching is
+    off when the discretization returns a negative mesh version and when
+    MeshScalarT is not RealType (mesh-dependent derivatives).
+
+    Usage:
+    \code
+      if (cache.haveStoredData(workset)) {
+        cache.load(BF); cache.load(GradBF);
+        return;
+      }
+      ... compute BF, GradBF ...
+      cache.store(BF); cache.store(GradBF);
+      cache.setStored();
+    \endcode
+    Fields must be loaded in the order they were stored.
+*/
+template<typename EvalT, typename Traits>
+class GeometryCache {
+public:
+
+  GeometryCache () :
+    mesh_version_(-1), single_precision_(false), current_(NULL), pos_(0) {}
+
+  //! Returns true if the fields of this workset are cached. If false, and
+  //! caching is possible, subsequent store() calls record the fields.
+  bool haveStoredData (typename Traits::EvalData workset) {
+    current_ = NULL;
+    pos_ = 0;
+    if (!std::is_same<typename EvalT::MeshScalarT, RealType>::value ||
+        workset.disc.is_null())
+      return false;
+
+    const int version = workset.disc->getMeshVersion();
+    if (version < 0) return false;
+    if (version != mesh_version_) {
+      // Mesh changed: everything cached so far is stale.
+      entries_.clear();
+      mesh_version_ = version;
+      single_precision_ = workset.disc->singlePrecisionGeometryCache();
+    }
+
+    current_ = &entries_[workset.wsIndex];
+    if (current_->stored) return true;
+    current_->dvals.clear();
+    current_->fvals.clear();
+    return false;
+  }
+
+  //! Mark the fields stored since haveStoredData() as complete.
+  void setStored () { if (current_) current_->stored = true; }
+
+  template<typename T, typename Tag0, typename Tag1>
+  void store (const PHX::MDField<T,Tag0,Tag1>& f) {
+    if (!current_) return;
+    for (int i=0; i < f.dimension(0); ++i)
+      for (int j=0; j < f.dimension(1); ++j)
+        push(f(i,j));
+  }
+  template<typename T, typename Tag0, typename Tag1, typename Tag2>
+  void store (const PHX::MDField<T,Tag0,Tag1,Tag2>& f) {
+    if (!current_) return;
+    for (int i=0; i < f.dimension(0); ++i)
+      for (int j=0; j < f.dimension(1); ++j)
+        for (int k=0; k < f.dimension(2); ++k)
+          push(f(i,j,k));
+  }
+  template<typename T, typename Tag0, typename Tag1, typename Tag2, typename Tag3>
+  void store (const PHX::MDField<T,Tag0,Tag1,Tag2,Tag3>& f) {
+    if (!current_) return;
+    for (int i=0; i < f.dimension(0); ++i)
+      for (int j=0; j < f.dimension(1); ++j)
+        for (int k=0; k < f.dimension(2); ++k)
+          for (int l=0; l < f.dimension(3); ++l)
+            push(f(i,j,k,l));
+  }
+  template<typename T, typename Tag0, typename Tag1, typename Tag2, typename Tag3,
+           typename Tag4>
+  void store (const PHX::MDField<T,Tag0,Tag1,Tag2,Tag3,Tag4>& f) {
+    if (!current_) return;
+    for (int i=0; i < f.dimension(0); ++i)
+      for (int j=0; j < f.dimension(1); ++j)
+        for (int k=0; k < f.dimension(2); ++k)
+          for (int l=0; l < f.dimension(3); ++l)
+            for (int m=0; m < f.dimension(4); ++m)
+              push(f(i,j,k,l,m));
+  }
+
+  template<typename T>
+  void store (const Intrepid2::FieldContainer_Kokkos<T, PHX::Layout, PHX::Device>& f) {
+    if (!current_) return;
+    for (int i=0; i < f.size(); ++i)
+      push(f[i]);
+  }
+
+  template<typename T, typename Tag0, typename Tag1>
+  void load (PHX::MDField<T,Tag0,Tag1>& f) {
+    for (int i=0; i < f.dimension(0); ++i)
+      for (int j=0; j < f.dimension(1); ++j)
+        f(i,j) = pop();
+  }
+  template<typename T, typename Tag0, typename Tag1, typename Tag2>
+  void load (PHX::MDField<T,Tag0,Tag1,Tag2>& f) {
+    for (int i=0; i < f.dimension(0); ++i)
+      for (int j=0; j < f.dimension(1); ++j)
+        for (int k=0; k < f.dimension(2); ++k)
+          f(i,j,k) = pop();
+  }
+  template<typename T, typename Tag0, typename Tag1, typename Tag2, typename Tag3>
+  void load (PHX::MDField<T,Tag0,Tag1,Tag2,Tag3>& f) {
+    for (int i=0; i < f.dimension(0); ++i)
+      for (int j=0; j < f.dimension(1); ++j)
+        for (int k=0; k < f.dimension(2); ++k)
+          for (int l=0; l < f.dimension(3); ++l)
+            f(i,j,k,l) = pop();
+  }
+  template<typename T, typename Tag0, typename Tag1, typename Tag2, typename Tag3,
+           typename Tag4>
+  void load (PHX::MDField<T,Tag0,Tag1,Tag2,Tag3,Tag4>& f) {
+    for (int i=0; i < f.dimension(0); ++i)
+      for (int j=0; j < f.dimension(1); ++j)
+        for (int k=0; k < f.dimension(2); ++k)
+          for (int l=0; l < f.dimension(3); ++l)
+            for (int m=0; m < f.dimension(4); ++m)
+              f(i,j,k,l,m) = pop();
+  }
+
+  template<typename T>
+  void load (Intrepid2::FieldContainer_Kokkos<T, PHX::Layout, PHX::Device>& f) {
+    for (int i=0; i < f.size(); ++i)
+      f[i] = pop();
+  }
+
+private:
+
+  struct Entry {
+    Entry () : stored(false) {}
+    bool stored;
+    std::vector<double> dvals;
+    std::vector<float> fvals;
+  };
+
+  template<typename T>
+  void push (const T& v) {
+    const double d = Sacado::ScalarValue<T>::eval(v);
+    if (single_precision_) current_->fvals.push_back(static_cast<float>(d));
+    else current_->dvals.push_back(d);
+  }
+
+  RealType pop () {
+    return single_precision_ ? current_->fvals[pos_++] : current_->dvals[pos_++];
+  }
+
+  int mesh_version_;
+  bool single_precision_;
+  std::map<int, Entry> entries_;
+  Entry* current_;
+  std::size_t pos_;
+};
+
+} // namespace PHAL
+
+#endif
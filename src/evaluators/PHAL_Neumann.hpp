@@ -20,6 +20,7 @@
 #include "Albany_ProblemUtils.hpp"
 #include "Sacado_ParameterAccessor.hpp"
 #include "PHAL_AlbanyTraits.hpp"
+#include "PHAL_GeometryCache.hpp"
 
 #include "QCAD_MaterialDatabase.hpp"
 
@@ -174,18 +175,18 @@ protected:
   // The basis
   Teuchos::RCP<Intrepid2::Basis<RealType, Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > > intrepidBasis;
 
-  // Temporary FieldContainers
-  Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> cubPointsSide;
-  Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> refPointsSide;
-  Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> cubWeightsSide;
+  // Reference side data, indexed by local side id
+  Teuchos::Array<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > refPointsSide;
+  Teuchos::Array<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > cubWeightsSide;
+  Teuchos::Array<Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> > basis_refPointsSide;
+
+  // Temporary FieldContainers, sized for one group of sides with the same local side id
   Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> physPointsSide;
   Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> jacobianSide;
-  Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> jacobianSide_det;
 
   Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> physPointsCell;
 
   Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> weighted_measure;
-  Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> basis_refPointsSide;
   Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> trans_basis_refPointsSide;
   Intrepid2::FieldContainer_Kokkos<MeshScalarT, PHX::Layout, PHX::Device> weighted_trans_basis_refPointsSide;
 
@@ -197,6 +198,9 @@ protected:
   
   Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> data;
 
+  //! Side geometry of each workset, reused while the mesh does not change
+  GeometryCache<EvalT, Traits> geometryCache;
+
   // Output:
   Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device>   neumann;
 
@@ -7,6 +7,7 @@
 
 #include "Teuchos_TestForException.hpp"
 #include "Phalanx_DataLayout.hpp"
+#include <map>
 #include <string>
 
 #include "Intrepid2_FunctionSpaceTools.hpp"
@@ -331,14 +332,11 @@ NeumannBase(const Teuchos::ParameterList& p) :
   side_type.resize(numSidesOnElem);
 
   // Build containers that depend on side topology
-  int maxSideDim(0), maxNumQpSide(0);
   const char* sideTypeName;
 
   for(int i=0; i<numSidesOnElem; ++i) {
     sideType[i] = Teuchos::rcp(new shards::CellTopology(elem_top->side[i].topology));
     cubatureSide[i] = cubFactory.create(*sideType[i], cubatureDegree);
-    maxSideDim = std::max( maxSideDim, (int)sideType[i]->getDimension());
-    maxNumQpSide = std::max(maxNumQpSide, (int)cubatureSide[i]->getNumPoints());
     sideTypeName = sideType[i]->getName();
     if(strncasecmp(sideTypeName, "Line", 4) == 0)
       side_type[i] = LINE;
@@ -360,31 +358,32 @@ NeumannBase(const Teuchos::ParameterList& p) :
   numQPs = dim[1];
   cellDims = dim[2];
 
-  // Allocate Temporary FieldContainers
-  physPointsCell.resize(1, numNodes, cellDims);
-  dofCell.resize(1, numNodes);
-  dofCellVec.resize(1, numNodes, numDOFsSet);
+  // Allocate Temporary FieldContainers. The side containers are resized for
+  // each group of sides in evaluateNeumannContribution.
   neumann.resize(containerSize, numNodes, numDOFsSet);
 
-  // Allocate Temporary FieldContainers based on max sizes of sides. Need to be resized later for each side.
-  cubPointsSide.resize(maxNumQpSide, maxSideDim);
-  refPointsSide.resize(maxNumQpSide, cellDims);
-  cubWeightsSide.resize(maxNumQpSide);
-  physPointsSide.resize(1, maxNumQpSide, cellDims);
-  dofSide.resize(1, maxNumQpSide);
-  dofSideVec.resize(1, maxNumQpSide, numDOFsSet);
-
-  // Do the BC one side at a time for now
-  jacobianSide.resize(1, maxNumQpSide, cellDims, cellDims);
-  jacobianSide_det.resize(1, maxNumQpSide);
+  // The side cubature, its image in the reference cell and the basis values
+  // there only depend on the local side id; compute them once here.
+  refPointsSide.resize(numSidesOnElem);
+  cubWeightsSide.resize(numSidesOnElem);
+  basis_refPointsSide.resize(numSidesOnElem);
+  for(int i=0; i<numSidesOnElem; ++i) {
+    int sideDims = sideType[i]->getDimension();
+    int numQPsSide = cubatureSide[i]->getNumPoints();
+    Intrepid2::FieldContainer_Kokkos<RealType, PHX::Layout, PHX::Device> cubPointsSide(numQPsSide, sideDims);
+    refPointsSide[i].resize(numQPsSide, cellDims);
+    cubWeightsSide[i].resize(numQPsSide);
+    basis_refPointsSide[i].resize(numNodes, numQPsSide);
 
-  weighted_measure.resize(1, maxNumQpSide);
-  basis_refPointsSide.resize(numNodes, maxNumQpSide);
-  trans_basis_refPointsSide.resize(1, numNodes, maxNumQpSide);
-  weighted_trans_basis_refPointsSide.resize(1, numNodes, maxNumQpSide);
+    cubatureSide[i]->getCubature(cubPointsSide, cubWeightsSide[i]);
 
-  data.resize(1, maxNumQpSide, numDOFsSet);
+    // Map side cubature points to the reference parent cell based on the appropriate side
+    Intrepid2::CellTools<RealType>::mapToReferenceSubcell
+      (refPointsSide[i], cubPointsSide, sideDims, i, *cellType);
 
+    // Values of the basis functions at side cubature points, in the reference parent cell domain
+    intrepidBasis->getValues(basis_refPointsSide[i], refPointsSide[i], Intrepid2::OPERATOR_VALUE);
+  }
 
   this->setName(name);
 }
@@ -454,94 +453,106 @@ evaluateNeumannContribution(typename Traits::EvalData workset)
 
   const std::vector<Albany::SideStruct>& sideSet = it->second;
 
-  // Loop over the sides that form the boundary condition
+  // Group the sides by local side id (and element block, for the material
+  // scaling) so that each group shares the reference side data and can be
+  // integrated as one batch of cells.
+
+  std::map<std::pair<int,int>, std::vector<int> > sideGroups;
+  for (std::size_t side=0; side < sideSet.size(); ++side)
+    sideGroups[std::make_pair(sideSet[side].side_local_id, sideSet[side].elem_ebIndex)].push_back(side);
 
-  for (std::size_t side=0; side < sideSet.size(); ++side) { // loop over the sides on this ws and name
+  // The side geometry only depends on the coordinates, so on static meshes it
+  // is computed on the first evaluation of each workset and reused afterwards.
+  const bool haveGeometry = geometryCache.haveStoredData(workset);
 
-    // Get the data that corresponds to the side
+  for (std::map<std::pair<int,int>, std::vector<int> >::const_iterator group = sideGroups.begin();
+       group != sideGroups.end(); ++group) {
 
-    const int elem_GID = sideSet[side].elem_GID;
-    const int elem_LID = sideSet[side].elem_LID;
-    const int elem_side = sideSet[side].side_local_id;
+    const int elem_side = group->first.first;
+    const std::vector<int>& sides = group->second;
+    const int numSides = sides.size();
 
     int sideDims = sideType[elem_side]->getDimension();
     int numQPsSide = cubatureSide[elem_side]->getNumPoints();
 
+    //need to resize containers because they depend on side topology and group size
+    physPointsCell.resize(numSides, numNodes, cellDims);
+    physPointsSide.resize(numSides, numQPsSide, cellDims);
+    dofCell.resize(numSides, numNodes);
+    dofSide.resize(numSides, numQPsSide);
+    dofCellVec.resize(numSides, numNodes, numDOFsSet);
+    dofSideVec.resize(numSides, numQPsSide, numDOFsSet);
+
+    jacobianSide.resize(numSides, numQPsSide, cellDims, cellDims);
+
+    weighted_measure.resize(numSides, numQPsSide);
+    trans_basis_refPointsSide.resize(numSides, numNodes, numQPsSide);
+    weighted_trans_basis_refPointsSide.resize(numSides, numNodes, numQPsSide);
+    data.resize(numSides, numQPsSide, numDOFsSet);
+
+    betaOnSide.resize(numSides,numQPsSide);
+    thicknessOnSide.resize(numSides,numQPsSide);
+    bedTopoOnSide.resize(numSides,numQPsSide);
+    elevationOnSide.resize(numSides,numQPsSide);
+
+    if (haveGeometry) {
+      geometryCache.load(jacobianSide);
+      geometryCache.load(physPointsSide);
+      geometryCache.load(trans_basis_refPointsSide);
+      geometryCache.load(weighted_trans_basis_refPointsSide);
+    }
+    else {
 
-    //need to resize containers because they depend on side topology
-    cubPointsSide.resize(numQPsSide, sideDims);
-    refPointsSide.resize(numQPsSide, cellDims);
-    cubWeightsSide.resize(numQPsSide);
-    physPointsSide.resize(1, numQPsSide, cellDims);
-    dofSide.resize(1, numQPsSide);
-    dofSideVec.resize(1, numQPsSide, numDOFsSet);
-
-    // Do the BC one side at a time for now
-    jacobianSide.resize(1, numQPsSide, cellDims, cellDims);
-    jacobianSide_det.resize(1, numQPsSide);
-
-    weighted_measure.resize(1, numQPsSide);
-    basis_refPointsSide.resize(numNodes, numQPsSide);
-    trans_basis_refPointsSide.resize(1, numNodes, numQPsSide);
-    weighted_trans_basis_refPointsSide.resize(1, numNodes, numQPsSide);
-    data.resize(1, numQPsSide, numDOFsSet);
-
-    betaOnSide.resize(1,numQPsSide);
-    thicknessOnSide.resize(1,numQPsSide);
-    bedTopoOnSide.resize(1,numQPsSide);
-    elevationOnSide.resize(1,numQPsSide);
-
-    cubatureSide[elem_side]->getCubature(cubPointsSide, cubWeightsSide);
+      // Copy the coordinate data over to a temp container
 
-    // Copy the coordinate data over to a temp container
+      for (int cell=0; cell < numSides; ++cell) {
+        const int elem_LID = sideSet[sides[cell]].elem_LID;
+        for (std::size_t node=0; node < numNodes; ++node)
+          for (std::size_t dim=0; dim < cellDims; ++dim)
+            physPointsCell(cell, node, dim) = coordVec(elem_LID, node, dim);
+      }
 
-    for (std::size_t node=0; node < numNodes; ++node)
-      for (std::size_t dim=0; dim < cellDims; ++dim)
-        physPointsCell(0, node, dim) = coordVec(elem_LID, node, dim);
+      // Calculate side geometry
+      Intrepid2::CellTools<MeshScalarT>::setJacobian
+         (jacobianSide, refPointsSide[elem_side], physPointsCell, *cellType);
 
+      if (sideDims < 2) { //for 1 and 2D, get weighted edge measure
+        Intrepid2::FunctionSpaceTools::computeEdgeMeasure<MeshScalarT>
+          (weighted_measure, jacobianSide, cubWeightsSide[elem_side], elem_side, *cellType);
+      }
+      else { //for 3D, get weighted face measure
+        Intrepid2::FunctionSpaceTools::computeFaceMeasure<MeshScalarT>
+          (weighted_measure, jacobianSide, cubWeightsSide[elem_side], elem_side, *cellType);
+      }
 
-    // Map side cubature points to the reference parent cell based on the appropriate side (elem_side)
-    Intrepid2::CellTools<RealType>::mapToReferenceSubcell
-      (refPointsSide, cubPointsSide, sideDims, elem_side, *cellType);
+      // Transform values of the basis functions
+      Intrepid2::FunctionSpaceTools::HGRADtransformVALUE<MeshScalarT>
+        (trans_basis_refPointsSide, basis_refPointsSide[elem_side]);
 
-    // Calculate side geometry
-    Intrepid2::CellTools<MeshScalarT>::setJacobian
-       (jacobianSide, refPointsSide, physPointsCell, *cellType);
+      // Multiply with weighted measure
+      Intrepid2::FunctionSpaceTools::multiplyMeasure<MeshScalarT>
+        (weighted_trans_basis_refPointsSide, weighted_measure, trans_basis_refPointsSide);
 
-    Intrepid2::CellTools<MeshScalarT>::setJacobianDet(jacobianSide_det, jacobianSide);
+      // Map cell (reference) cubature points to the appropriate side (elem_side) in physical space
+      Intrepid2::CellTools<RealType>::mapToPhysicalFrame
+        (physPointsSide, refPointsSide[elem_side], physPointsCell, intrepidBasis);
 
-    if (sideDims < 2) { //for 1 and 2D, get weighted edge measure
-      Intrepid2::FunctionSpaceTools::computeEdgeMeasure<MeshScalarT>
-        (weighted_measure, jacobianSide, cubWeightsSide, elem_side, *cellType);
-    }
-    else { //for 3D, get weighted face measure
-      Intrepid2::FunctionSpaceTools::computeFaceMeasure<MeshScalarT>
-        (weighted_measure, jacobianSide, cubWeightsSide, elem_side, *cellType);
+      geometryCache.store(jacobianSide);
+      geometryCache.store(physPointsSide);
+      geometryCache.store(trans_basis_refPointsSide);
+      geometryCache.store(weighted_trans_basis_refPointsSide);
     }
 
-    // Values of the basis functions at side cubature points, in the reference parent cell domain
-    intrepidBasis->getValues(basis_refPointsSide, refPointsSide, Intrepid2::OPERATOR_VALUE);
-
-    // Transform values of the basis functions
-    Intrepid2::FunctionSpaceTools::HGRADtransformVALUE<MeshScalarT>
-      (trans_basis_refPointsSide, basis_refPointsSide);
-
-    // Multiply with weighted measure
-    Intrepid2::FunctionSpaceTools::multiplyMeasure<MeshScalarT>
-      (weighted_trans_basis_refPointsSide, weighted_measure, trans_basis_refPointsSide);
-
-    // Map cell (reference) cubature points to the appropriate side (elem_side) in physical space
-    Intrepid2::CellTools<RealType>::mapToPhysicalFrame
-      (physPointsSide, refPointsSide, physPointsCell, intrepidBasis);
-
-
     // Map cell (reference) degree of freedom points to the appropriate side (elem_side)
     if(bc_type == ROBIN) {
-      for (std::size_t node=0; node < numNodes; ++node)
-        dofCell(0, node) = dof(elem_LID, node);
+      for (int cell=0; cell < numSides; ++cell) {
+        const int elem_LID = sideSet[sides[cell]].elem_LID;
+        for (std::size_t node=0; node < numNodes; ++node)
+          dofCell(cell, node) = dof(elem_LID, node);
+      }
 
       // This is needed, since evaluate currently sums into
-      for (int i=0; i < numQPsSide ; i++) dofSide(0,i) = 0.0;
+      for (int i=0; i < dofSide.size() ; i++) dofSide[i] = 0.0;
 
       // Get dof at cubature points of appropriate side (see DOFInterpolation evaluator)
       Intrepid2::FunctionSpaceTools::
@@ -550,78 +561,77 @@ evaluateNeumannContribution(typename Traits::EvalData workset)
 
     // Map cell (reference) degree of freedom points to the appropriate side (elem_side)
     else if(bc_type == BASAL || bc_type == BASAL_SCALAR_FIELD) {
-      Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> betaOnCell(1, numNodes);
-      Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> thicknessOnCell(1, numNodes);
-      Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> bedTopoOnCell(1, numNodes);
-      for (std::size_t node=0; node < numNodes; ++node)
-      {
-        betaOnCell(0,node) = beta_field(elem_LID,node);
+      Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> betaOnCell(numSides, numNodes);
+      Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> thicknessOnCell(numSides, numNodes);
+      Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> bedTopoOnCell(numSides, numNodes);
+      for (int cell=0; cell < numSides; ++cell) {
+        const int elem_LID = sideSet[sides[cell]].elem_LID;
+        for (std::size_t node=0; node < numNodes; ++node)
+        {
+          betaOnCell(cell,node) = beta_field(elem_LID,node);
 #ifdef ALBANY_FELIX
-        if(bc_type == BASAL) {
-          thicknessOnCell(0,node) = thickness_field(elem_LID,node);
-          bedTopoOnCell(0,node) = bedTopo_field(elem_LID,node);
-        }
+          if(bc_type == BASAL) {
+            thicknessOnCell(cell,node) = thickness_field(elem_LID,node);
+            bedTopoOnCell(cell,node) = bedTopo_field(elem_LID,node);
+          }
 #endif
-        for(int dim = 0; dim < numDOFsSet; dim++)
-              dofCellVec(0,node,dim) = dofVec(elem_LID,node,this->offset[dim]);
+          for(int dim = 0; dim < numDOFsSet; dim++)
+                dofCellVec(cell,node,dim) = dofVec(elem_LID,node,this->offset[dim]);
+        }
       }
 
       // This is needed, since evaluate currently sums into
-      for (int i=0; i < numQPsSide ; i++) betaOnSide(0,i) = 0.0;
-      for (int i=0; i < numQPsSide ; i++) thicknessOnSide(0,i) = 0.0;
-      for (int i=0; i < numQPsSide ; i++) bedTopoOnSide(0,i) = 0.0;
+      for (int i=0; i < betaOnSide.size() ; i++) betaOnSide[i] = 0.0;
+      for (int i=0; i < thicknessOnSide.size() ; i++) thicknessOnSide[i] = 0.0;
+      for (int i=0; i < bedTopoOnSide.size() ; i++) bedTopoOnSide[i] = 0.0;
       for (int i=0; i < dofSideVec.size() ; i++) dofSideVec[i] = 0.0;
 
       // Get dof at cubature points of appropriate side (see DOFVecInterpolation evaluator)
-      for (std::size_t node=0; node < numNodes; ++node) {
-         for (std::size_t qp=0; qp < numQPsSide; ++qp) {
-                 betaOnSide(0, qp)  += betaOnCell(0, node) * trans_basis_refPointsSide(0, node, qp);
-                 thicknessOnSide(0, qp)  += thicknessOnCell(0, node) * trans_basis_refPointsSide(0, node, qp);
-                 bedTopoOnSide(0, qp)  += bedTopoOnCell(0, node) * trans_basis_refPointsSide(0, node, qp);
-            for (int dim = 0; dim < numDOFsSet; dim++) {
-               dofSideVec(0, qp, dim)  += dofCellVec(0, node, dim) * trans_basis_refPointsSide(0, node, qp);
+      for (int cell=0; cell < numSides; ++cell) {
+        for (std::size_t node=0; node < numNodes; ++node) {
+           for (std::size_t qp=0; qp < numQPsSide; ++qp) {
+                   betaOnSide(cell, qp)  += betaOnCell(cell, node) * trans_basis_refPointsSide(cell, node, qp);
+                   thicknessOnSide(cell, qp)  += thicknessOnCell(cell, node) * trans_basis_refPointsSide(cell, node, qp);
+                   bedTopoOnSide(cell, qp)  += bedTopoOnCell(cell, node) * trans_basis_refPointsSide(cell, node, qp);
+              for (int dim = 0; dim < numDOFsSet; dim++) {
+                 dofSideVec(cell, qp, dim)  += dofCellVec(cell, node, dim) * trans_basis_refPointsSide(cell, node, qp);
+              }
             }
-          }
-       }
-
-      // Get dof at cubature points of appropriate side (see DOFVecInterpolation evaluator)
-      //Intrepid2::FunctionSpaceTools::
-        //evaluate<ScalarT>(dofSide, dofCell, trans_basis_refPointsSide);
+         }
+      }
     }
 #ifdef ALBANY_FELIX
     else if(bc_type == LATERAL) {
-          Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> thicknessOnCell(1, numNodes);
-          Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> elevationOnCell(1, numNodes);
-          for (std::size_t node=0; node < numNodes; ++node)
-          {
-                thicknessOnCell(0,node) = thickness_field(elem_LID,node);
-                elevationOnCell(0,node) = elevation_field(elem_LID,node);
-                for(int dim = 0; dim < numDOFsSet; dim++)
-                  dofCellVec(0,node,dim) = dofVec(elem_LID,node,this->offset[dim]);
+          Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> thicknessOnCell(numSides, numNodes);
+          Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Device> elevationOnCell(numSides, numNodes);
+          for (int cell=0; cell < numSides; ++cell) {
+            const int elem_LID = sideSet[sides[cell]].elem_LID;
+            for (std::size_t node=0; node < numNodes; ++node)
+            {
+                  thicknessOnCell(cell,node) = thickness_field(elem_LID,node);
+                  elevationOnCell(cell,node) = elevation_field(elem_LID,node);
+                  for(int dim = 0; dim < numDOFsSet; dim++)
+                    dofCellVec(cell,node,dim) = dofVec(elem_LID,node,this->offset[dim]);
+            }
           }
 
           // This is needed, since evaluate currently sums into
-          for (int i=0; i < numQPsSide ; i++)
-          {
-                  thicknessOnSide(0,i) = 0.0;
-                  elevationOnSide(0,i) = 0.0;
-          }
+          for (int i=0; i < thicknessOnSide.size() ; i++) thicknessOnSide[i] = 0.0;
+          for (int i=0; i < elevationOnSide.size() ; i++) elevationOnSide[i] = 0.0;
           for (int i=0; i < dofSideVec.size() ; i++) dofSideVec[i] = 0.0;
 
           // Get dof at cubature points of appropriate side (see DOFVecInterpolation evaluator)
-          for (std::size_t node=0; node < numNodes; ++node) {
-                 for (std::size_t qp=0; qp < numQPsSide; ++qp) {
-                         thicknessOnSide(0, qp)  += thicknessOnCell(0, node) * trans_basis_refPointsSide(0, node, qp);
-                         elevationOnSide(0, qp)  += elevationOnCell(0, node) * trans_basis_refPointsSide(0, node, qp);
-                        for (int dim = 0; dim < numDOFsSet; dim++) {
-                           dofSideVec(0, qp, dim)  += dofCellVec(0, node, dim) * trans_basis_refPointsSide(0, node, qp);
-                        }
-                  }
-           }
-
-          // Get dof at cubature points of appropriate side (see DOFVecInterpolation evaluator)
-          //Intrepid2::FunctionSpaceTools::
-        //evaluate<ScalarT>(dofSide, dofCell, trans_basis_refPointsSide);
+          for (int cell=0; cell < numSides; ++cell) {
+            for (std::size_t node=0; node < numNodes; ++node) {
+                   for (std::size_t qp=0; qp < numQPsSide; ++qp) {
+                           thicknessOnSide(cell, qp)  += thicknessOnCell(cell, node) * trans_basis_refPointsSide(cell, node, qp);
+                           elevationOnSide(cell, qp)  += elevationOnCell(cell, node) * trans_basis_refPointsSide(cell, node, qp);
+                          for (int dim = 0; dim < numDOFsSet; dim++) {
+                             dofSideVec(cell, qp, dim)  += dofCellVec(cell, node, dim) * trans_basis_refPointsSide(cell, node, qp);
+                          }
+                    }
+             }
+          }
     }
 #endif
   // Transform the given BC data to the physical space QPs in each side (elem_side)
@@ -630,14 +640,14 @@ evaluateNeumannContribution(typename Traits::EvalData workset)
 
       case INTJUMP:
        {
-         const ScalarT elem_scale = matScaling[sideSet[side].elem_ebIndex];
+         const ScalarT elem_scale = matScaling[group->first.second];
          calc_dudn_const(data, physPointsSide, jacobianSide, *cellType, cellDims, elem_side, elem_scale);
          break;
        }
 
       case ROBIN:
        {
-         const ScalarT elem_scale = matScaling[sideSet[side].elem_ebIndex];
+         const ScalarT elem_scale = matScaling[group->first.second];
          calc_dudn_robin(data, physPointsSide, dofSide, jacobianSide, *cellType, cellDims, elem_side, elem_scale, robin_vals);
          break;
        }
@@ -685,16 +695,20 @@ evaluateNeumannContribution(typename Traits::EvalData workset)
 
     }
 
-    // Put this side's contribution into the vector
-
-    for (std::size_t node=0; node < numNodes; ++node)
-      for (std::size_t qp=0; qp < numQPsSide; ++qp)
-         for (std::size_t dim=0; dim < numDOFsSet; ++dim)
-           neumann(elem_LID, node, dim) +=
-                  data(0, qp, dim) * weighted_trans_basis_refPointsSide(0, node, qp);
+    // Put the contributions of this group of sides into the vector
 
+    for (int cell=0; cell < numSides; ++cell) {
+      const int elem_LID = sideSet[sides[cell]].elem_LID;
+      for (std::size_t node=0; node < numNodes; ++node)
+        for (std::size_t qp=0; qp < numQPsSide; ++qp)
+           for (std::size_t dim=0; dim < numDOFsSet; ++dim)
+             neumann(elem_LID, node, dim) +=
+                    data(cell, qp, dim) * weighted_trans_basis_refPointsSide(cell, node, qp);
+    }
 
   }
+
+  if (!haveGeometry) geometryCache.setStored();
 }
 
 template<typename EvalT, typename Traits>
@@ -754,9 +768,10 @@ calc_traction_components(Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout,
       for(int dim = 0; dim < cellDims; dim++)
         traction(cell, pt, dim) = dudx[dim];
 
-  for(int pt = 0; pt < numPoints; pt++)
-    for(int dim = 0; dim < numDOFsSet; dim++)
-      qp_data_returned(0, pt, dim) = -traction(0, pt, dim);
+  for(int cell = 0; cell < numCells; cell++)
+    for(int pt = 0; pt < numPoints; pt++)
+      for(int dim = 0; dim < numDOFsSet; dim++)
+        qp_data_returned(cell, pt, dim) = -traction(cell, pt, dim);
 
 }
 
@@ -802,9 +817,10 @@ calc_gradu_dotn_const(Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX
 //  Intrepid2::FunctionSpaceTools::dotMultiplyDataData<ScalarT>(qp_data_returned,
 //    grad_T, side_normals);
 
-  for(int pt = 0; pt < numPoints; pt++)
-    for(int dim = 0; dim < numDOFsSet; dim++)
-      qp_data_returned(0, pt, dim) = grad_T(0, pt, dim) * side_normals(0, pt, dim);
+  for(int cell = 0; cell < numCells; cell++)
+    for(int pt = 0; pt < numPoints; pt++)
+      for(int dim = 0; dim < numDOFsSet; dim++)
+        qp_data_returned(cell, pt, dim) = grad_T(cell, pt, dim) * side_normals(cell, pt, dim);
 
 }
 
@@ -824,9 +840,10 @@ calc_dudn_const(Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Devi
 
   //std::cout << "DEBUG: applying const dudn to sideset " << this->sideSetID << ": " << (const_val * scale) << std::endl;
 
-  for(int pt = 0; pt < numPoints; pt++)
-    for(int dim = 0; dim < numDOFsSet; dim++)
-      qp_data_returned(0, pt, dim) = -const_val * scale; // User directly specified dTdn, just use it
+  for(int cell = 0; cell < numCells; cell++)
+    for(int pt = 0; pt < numPoints; pt++)
+      for(int dim = 0; dim < numDOFsSet; dim++)
+        qp_data_returned(cell, pt, dim) = -const_val * scale; // User directly specified dTdn, just use it
 
 
 }
@@ -851,9 +868,10 @@ calc_dudn_robin(Intrepid2::FieldContainer_Kokkos<ScalarT, PHX::Layout, PHX::Devi
   const ScalarT& coeff = robin_vals[1];
   const ScalarT& jump = robin_vals[2];
 
-  for(int pt = 0; pt < numPoints; pt++)
-    for(int dim = 0; dim < numDOFsSet; dim++)
-      qp_data_returned(0, pt, dim) = coeff*(dof_side(0,pt) - dof_value) - jump * scale * 2.0;
+  for(int cell = 0; cell < numCells; cell++)
+    for(int pt = 0; pt < numPoints; pt++)
+      for(int dim = 0; dim < numDOFsSet; dim++)
+        qp_data_returned(cell, pt, dim) = coeff*(dof_side(cell,pt) - dof_value) - jump * scale * 2.0;
          // mult by 2 to emulate behavior of an internal side within a single material (element block)
          //  in which case usual Neumann would add contributions from both sides, giving factor of 2
 }
@@ -7,12 +7,16 @@
 #ifndef PHAL_SCATTER_RESIDUAL_HPP
 #define PHAL_SCATTER_RESIDUAL_HPP
 
+#include <map>
+#include <vector>
+
 #include "Phalanx_config.hpp"
 #include "Phalanx_Evaluator_WithBaseImpl.hpp"
 #include "Phalanx_Evaluator_Derived.hpp"
 #include "Phalanx_MDField.hpp"
 
 #include "Albany_Layouts.hpp"
+#include "utility/PerformanceProbe.hpp"
 
 #include "Teuchos_ParameterList.hpp"
 #ifdef ALBANY_EPETRA
@@ -60,6 +64,14 @@ protected:
   std::size_t offset; // Offset of first DOF being gathered when numFields<neq
 
   unsigned short int tensorRank;
+
+  // Instrumentation, named after the evaluator; bytes count the values
+  // written to the global objects, valuesPerDof per scattered dof
+  util::PerformanceProbe probe;
+  std::size_t scatteredBytes(typename Traits::EvalData workset,
+                             const std::size_t valuesPerDof) const {
+    return workset.numCells*numNodes*numFieldsBase*valuesPerDof*sizeof(ST);
+  }
 };
 
 template<typename EvalT, typename Traits> class ScatterResidual;
@@ -164,6 +176,21 @@ private:
   typedef typename PHAL::AlbanyTraits::Jacobian::ScalarT ScalarT;
   //typedef Kokkos::View < ScalarT***, Kokkos::LayoutRight, PHX::Device > temp_view_type;
 
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  typedef typename Tpetra_CrsMatrix::local_matrix_type  LocalMatrixType;
+
+  //! Offsets into the values of JacT's local matrix for every element-local
+  //! (row, col) pair of the workset; transposed pairs if is_adjoint
+  const std::vector<LO>& getScatterOffsets(typename Traits::EvalData workset);
+
+  //! The tables are valid for this graph (held, so that a new graph cannot
+  //! reuse its address) and this mesh change count
+  std::map<int, std::vector<LO> > scatter_offsets;
+  Teuchos::RCP<const Tpetra_CrsGraph> scatter_offsets_graph;
+  int scatter_offsets_mesh;
+  bool scatter_offsets_adjoint;
+#endif
+
 //Kokkos
 #ifdef ALBANY_KOKKOS_UNDER_DEVELOPMENT
 public:
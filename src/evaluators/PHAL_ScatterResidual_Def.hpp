@@ -70,6 +70,7 @@ ScatterResidualBase(const Teuchos::ParameterList& p,
   this->addEvaluatedField(*scatter_operation);
 
   this->setName(fieldName+PHX::typeAsString<EvalT>());
+  probe.setName(this->getName());
 }
 
 // **********************************************************************
@@ -150,6 +151,9 @@ template<typename Traits>
 void ScatterResidual<PHAL::AlbanyTraits::Residual, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
+  util::PerformanceGuard guard(this->probe, workset.numCells,
+                               this->scatteredBytes(workset, 1));
+
 #ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
   Teuchos::RCP<Tpetra_Vector> fT = workset.fT;
 
@@ -220,6 +224,9 @@ ScatterResidual(const Teuchos::ParameterList& p,
                               const Teuchos::RCP<Albany::Layouts>& dl)
   : ScatterResidualBase<PHAL::AlbanyTraits::Jacobian,Traits>(p,dl),
   numFields(ScatterResidualBase<PHAL::AlbanyTraits::Jacobian,Traits>::numFieldsBase)
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  , scatter_offsets_mesh(-1), scatter_offsets_adjoint(false)
+#endif
 {
 }
 // **********************************************************************
@@ -459,12 +466,102 @@ operator()(const ScatterRank2_no_adjoint_Tag& tag, const int& cell) const
 
 }
 #endif
+// **********************************************************************
+#ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+template<typename Traits>
+const std::vector<LO>& ScatterResidual<PHAL::AlbanyTraits::Jacobian, Traits>::
+getScatterOffsets(typename Traits::EvalData workset)
+{
+  const Teuchos::RCP<const Tpetra_CrsGraph> graph = workset.JacT->getCrsGraph();
+  const int mesh = Teuchos::nonnull(workset.disc) ? workset.disc->getMeshChangeCount() : -1;
+  if (graph.get() != scatter_offsets_graph.get() ||
+      mesh != scatter_offsets_mesh ||
+      workset.is_adjoint != scatter_offsets_adjoint) {
+    // New matrix graph or adapted mesh: all tables are stale.
+    scatter_offsets.clear();
+    scatter_offsets_graph = graph;
+    scatter_offsets_mesh = mesh;
+    scatter_offsets_adjoint = workset.is_adjoint;
+  }
+
+  const int neq = workset.wsElNodeEqID[0][0].size();
+  const int nunk = neq*this->numNodes;
+  const std::size_t size = workset.numCells*this->numNodes*numFields*nunk;
+
+  std::vector<LO>& offsets = scatter_offsets[workset.wsIndex];
+  if (offsets.size() == size) return offsets;
+
+  // Locate each (row, col) pair once in the CSR structure. Entries not in
+  // the graph get -1 and are dropped, as sumIntoLocalValues would do.
+  const LocalMatrixType local = workset.JacT->getLocalMatrix();
+  offsets.resize(size);
+  std::size_t k = 0;
+  for (std::size_t cell=0; cell < workset.numCells; ++cell) {
+    const Teuchos::ArrayRCP<Teuchos::ArrayRCP<int> >& nodeID = workset.wsElNodeEqID[cell];
+    for (std::size_t node = 0; node < this->numNodes; ++node) {
+      for (std::size_t eq = 0; eq < numFields; eq++) {
+        const LO rowT = nodeID[node][this->offset + eq];
+        for (unsigned int lunk = 0; lunk < nunk; lunk++, k++) {
+          const LO colT = nodeID[lunk/neq][lunk%neq];
+          const LO row = workset.is_adjoint ? colT : rowT;
+          const LO col = workset.is_adjoint ? rowT : colT;
+          offsets[k] = -1;
+          for (LO j = local.graph.row_map(row); j < local.graph.row_map(row+1); j++)
+            if (local.graph.entries(j) == col) { offsets[k] = j; break; }
+        }
+      }
+    }
+  }
+  return offsets;
+}
+#endif
+
 // **********************************************************************
 template<typename Traits>
 void ScatterResidual<PHAL::AlbanyTraits::Jacobian, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
+  util::PerformanceGuard guard(this->probe);
+  if (guard.active() && workset.numCells > 0) {
+    const std::size_t valuesPerDof = (Teuchos::nonnull(workset.fT) ? 1 : 0)
+      + workset.wsElNodeEqID[0][0].size()*this->numNodes;
+    guard.setWork(workset.numCells, this->scatteredBytes(workset, valuesPerDof));
+  }
+
 #ifndef ALBANY_KOKKOS_UNDER_DEVELOPMENT
+  if (workset.scatter_by_offsets) {
+    Teuchos::RCP<Tpetra_Vector> fT = workset.fT;
+    const bool loadResid = Teuchos::nonnull(fT);
+    const int nunk = workset.wsElNodeEqID[0][0].size()*this->numNodes;
+    int numDim = 0;
+    if (this->tensorRank==2) numDim = this->valTensor[0].dimension(2);
+
+    const std::vector<LO>& offsets = getScatterOffsets(workset);
+    const typename LocalMatrixType::values_type values =
+      workset.JacT->getLocalMatrix().values;
+
+    std::size_t k = 0;
+    for (std::size_t cell=0; cell < workset.numCells; ++cell ) {
+      const Teuchos::ArrayRCP<Teuchos::ArrayRCP<int> >& nodeID = workset.wsElNodeEqID[cell];
+      for (std::size_t node = 0; node < this->numNodes; ++node) {
+        for (std::size_t eq = 0; eq < numFields; eq++, k += nunk) {
+          typename PHAL::Ref<ScalarT>::type
+            valptr = (this->tensorRank == 0 ? this->val[eq](cell,node) :
+                      this->tensorRank == 1 ? this->valVec(cell,node,eq) :
+                      this->valTensor[0](cell,node, eq/numDim, eq%numDim));
+          if (loadResid)
+            fT->sumIntoLocalValue(nodeID[node][this->offset + eq], valptr.val());
+          if (valptr.hasFastAccess()) {
+            for (unsigned int lunk = 0; lunk < nunk; lunk++)
+              if (offsets[k + lunk] >= 0)
+                values(offsets[k + lunk]) += valptr.fastAccessDx(lunk);
+          }
+        }
+      }
+    }
+    return;
+  }
+
   Teuchos::RCP<Tpetra_Vector> fT = workset.fT;
   Teuchos::RCP<Tpetra_CrsMatrix> JacT = workset.JacT;
   const bool loadResid = Teuchos::nonnull(fT);
@@ -578,6 +675,14 @@ template<typename Traits>
 void ScatterResidual<PHAL::AlbanyTraits::Tangent, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
+  util::PerformanceGuard guard(this->probe);
+  if (guard.active()) {
+    const std::size_t valuesPerDof = (Teuchos::nonnull(workset.fT) ? 1 : 0)
+      + (Teuchos::nonnull(workset.JVT) ? workset.JVT->getNumVectors() : 0)
+      + (Teuchos::nonnull(workset.fpT) ? workset.fpT->getNumVectors() : 0);
+    guard.setWork(workset.numCells, this->scatteredBytes(workset, valuesPerDof));
+  }
+
   Teuchos::RCP<Tpetra_Vector> fT = workset.fT;
   Teuchos::RCP<Tpetra_MultiVector> JVT = workset.JVT;
   Teuchos::RCP<Tpetra_MultiVector> fpT = workset.fpT;
@@ -631,6 +736,9 @@ template<typename Traits>
 void ScatterResidual<PHAL::AlbanyTraits::DistParamDeriv, Traits>::
 evaluateFields(typename Traits::EvalData workset)
 {
+  util::PerformanceGuard guard(this->probe, workset.numCells,
+                               this->scatteredBytes(workset, workset.VpT->getNumVectors()));
+
   Teuchos::RCP<Tpetra_MultiVector> fpVT = workset.fpVT;
   bool trans = workset.transpose_dist_param_deriv;
   int num_cols = workset.VpT->getNumVectors();
@@ -698,7 +806,8 @@ evaluateFields(typename Traits::EvalData workset)
   if(level_it == extruded_params_levels->end()) //if parameter is not extruded use usual scatter.
     return ScatterResidual<PHAL::AlbanyTraits::DistParamDeriv, Traits>::evaluateFields(workset);
 
-
+  util::PerformanceGuard guard(this->probe, workset.numCells,
+                               this->scatteredBytes(workset, workset.VpT->getNumVectors()));
 
   int fieldLevel = level_it->second;
   Teuchos::RCP<Tpetra_MultiVector> fpVT = workset.fpVT;
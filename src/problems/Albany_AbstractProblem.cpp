@@ -153,6 +153,17 @@ Albany::AbstractProblem::getGenericProblemParams(std::string listname) const
                      "Ignore residual calculations while computing the Jacobian (only generally appropriate for linear problems)");
   validPL->set<double>("Perturb Dirichlet", 0.0,
                      "Add this (small) perturbation to the diagonal to prevent Mass Matrices from being singular for Dirichlets)");
+  validPL->set<bool>("Reuse Residual", false,
+                     "Return the cached residual when it is requested again at the same x, xdot, time, parameters and mesh. "
+                     "Not valid if inputs are set outside x (e.g. MPAS fields) or if the residual fill saves state variables "
+                     "or responses that are used later");
+  validPL->set<bool>("Cache Residual In Jacobian", false,
+                     "Also compute and cache the residual in Jacobian fills; implies Reuse Residual. "
+                     "Not valid if the residual fill saves state variables that are used later");
+  validPL->set<int>("Number of Fill Threads", 1,
+                    "Number of threads evaluating worksets concurrently in the residual and Jacobian fills");
+  validPL->set<bool>("Scatter Jacobian By Offsets", false,
+                     "Scatter element Jacobians using precomputed CSR offsets instead of per-entry searches");
 
   validPL->sublist("Model Order Reduction", false, "Specify the options relative to model order reduction");
 
@@ -162,6 +173,11 @@ Albany::AbstractProblem::getGenericProblemParams(std::string listname) const
   // Candidates for deprecation. Pertain to the solution rather than the problem definition.
   validPL->set<std::string>("Solution Method", "Steady", "Flag for Steady, Transient, or Continuation");
   validPL->set<double>("Homotopy Restart Step", 1., "Flag for Felix Homotopy Restart Step");
+  validPL->set<bool>("Persistent Solver", false, "Flag for Felix MPAS interface: keep the solver and preconditioner between coupling calls on an unchanged mesh");
+  validPL->set<std::string>("Persistent Solver MueLu Reuse", "none", "MueLu \"reuse: type\" used with Persistent Solver");
+  validPL->set<std::string>("Checkpoint File Name", "", "Write a binary checkpoint of the solution and states to <name>.<nranks>.<rank>");
+  validPL->set<int>("Checkpoint Write Interval", 1, "Number of observed steps between checkpoints");
+  validPL->set<std::string>("Restart Checkpoint File Name", "", "Restart the solution and states from a binary checkpoint written with the same rank count and mesh");
   validPL->set<std::string>("Second Order", "No", "Flag to indicate that a transient problem has two time derivs");
   validPL->set<bool>("Print Response Expansion", true, "");
 
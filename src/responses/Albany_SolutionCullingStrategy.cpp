@@ -8,6 +8,7 @@
 
 #if defined(ALBANY_EPETRA)
 #include "Epetra_BlockMap.h"
+#include "Epetra_Comm.h"
 #include "Epetra_GatherAllV.hpp"
 #endif
 #include "Tpetra_GatherAllV.hpp" 
@@ -20,6 +21,7 @@
 
 
 #include <algorithm>
+#include <vector>
 
 namespace Albany {
 
@@ -36,6 +38,71 @@ private:
 
 } // namespace Albany
 
+namespace {
+
+// Returns the GIDs found at the given positions of the sorted list of all
+// GIDs of a distributed map, without assembling that list. Each position is
+// located by bisection over the GID range [minGID, maxGID]; every step counts
+// the locally owned GIDs not larger than the midpoints (one binary search in
+// the sorted owned GIDs per position) and sums the counts over all ranks in a
+// single reduction. This takes at most log2(maxGID - minGID + 1) reductions of
+// positions.size() values, and memory stays O(owned + positions) per rank.
+template <typename GIDType, typename SumAll>
+Teuchos::Array<GIDType>
+selectRankedGIDs(
+    std::vector<GIDType> myGIDs,
+    GIDType minGID, GIDType maxGID,
+    const Teuchos::Array<GIDType> &positions,
+    SumAll sumAll)
+{
+  std::sort(myGIDs.begin(), myGIDs.end());
+
+  const int n = positions.size();
+
+  // Invariant: count(lo[i]) <= positions[i] < count(hi[i]), with count(g) the
+  // global number of GIDs not larger than g. Converges to hi[i] being the GID
+  // at positions[i]. All ranks hold the same bounds, so the loop is collective.
+  Teuchos::Array<GIDType> lo(n, minGID - 1), hi(n, maxGID);
+  Teuchos::Array<GIDType> mid(n), myCounts(n), counts(n);
+
+  bool converged = false;
+  while (!converged) {
+    converged = true;
+    for (int i = 0; i < n; ++i) {
+      mid[i] = lo[i] + (hi[i] - lo[i]) / 2;
+      myCounts[i] = std::upper_bound(myGIDs.begin(), myGIDs.end(), mid[i]) - myGIDs.begin();
+    }
+    sumAll(myCounts.getRawPtr(), counts.getRawPtr(), n);
+    for (int i = 0; i < n; ++i) {
+      if (hi[i] - lo[i] > 1) {
+        if (counts[i] > positions[i]) hi[i] = mid[i];
+        else lo[i] = mid[i];
+      }
+      if (hi[i] - lo[i] > 1) converged = false;
+    }
+  }
+  return hi;
+}
+
+// Positions 0, stride, 2*stride, ... of at most numValues values spread
+// uniformly over globalCount GIDs. Positions past the last GID are dropped.
+template <typename GIDType>
+Teuchos::Array<GIDType>
+uniformPositions(GIDType globalCount, int numValues)
+{
+  if (globalCount == 0 || numValues <= 0) return Teuchos::Array<GIDType>();
+
+  const GIDType stride = 1 + (globalCount - 1) / numValues;
+  const GIDType count = std::min<GIDType>(numValues, 1 + (globalCount - 1) / stride);
+  Teuchos::Array<GIDType> positions(count);
+  for (GIDType i = 0; i < count; ++i) {
+    positions[i] = i * stride;
+  }
+  return positions;
+}
+
+} // namespace
+
 Albany::UniformSolutionCullingStrategy::
 UniformSolutionCullingStrategy(int numValues) :
   numValues_(numValues)
@@ -47,22 +114,20 @@ Teuchos::Array<GO>
 Albany::UniformSolutionCullingStrategy::
 selectedGIDsT(Teuchos::RCP<const Tpetra_Map> sourceMapT) const
 {
-  Teuchos::Array<GO> allGIDs(sourceMapT->getGlobalNumElements());
-  {
-    const int ierr = Tpetra::GatherAllV(
-        sourceMapT->getComm(),
-        sourceMapT->getNodeElementList().getRawPtr(), sourceMapT->getNodeNumElements(),
-        allGIDs.getRawPtr(), allGIDs.size());
-    TEUCHOS_ASSERT(ierr == 0);
-  }
-  std::sort(allGIDs.begin(), allGIDs.end());
-
-  Teuchos::Array<GO> result(numValues_);
-  const int stride = 1 + (allGIDs.size() - 1) / numValues_;
-  for (int i = 0; i < numValues_; ++i) {
-    result[i] = allGIDs[i * stride];
-  }
-  return result;
+  const Teuchos::Array<GO> positions =
+    uniformPositions<GO>(sourceMapT->getGlobalNumElements(), numValues_);
+  if (positions.size() == 0) return positions;
+
+  const Teuchos::ArrayView<const GO> myGIDs = sourceMapT->getNodeElementList();
+  const Teuchos::RCP<const Teuchos::Comm<int> > commT = sourceMapT->getComm();
+
+  return selectRankedGIDs<GO>(
+      std::vector<GO>(myGIDs.begin(), myGIDs.end()),
+      sourceMapT->getMinAllGlobalIndex(), sourceMapT->getMaxAllGlobalIndex(),
+      positions,
+      [&commT](GO *myCounts, GO *counts, int n) {
+        Teuchos::reduceAll<int, GO>(*commT, Teuchos::REDUCE_SUM, n, myCounts, counts);
+      });
 }
 
 #if defined(ALBANY_EPETRA)
@@ -70,22 +135,20 @@ Teuchos::Array<int>
 Albany::UniformSolutionCullingStrategy::
 selectedGIDs(const Epetra_BlockMap &sourceMap) const
 {
-  Teuchos::Array<int> allGIDs(sourceMap.NumGlobalElements());
-  {
-    const int ierr = Epetra::GatherAllV(
-        sourceMap.Comm(),
-        sourceMap.MyGlobalElements(), sourceMap.NumMyElements(),
-        allGIDs.getRawPtr(), allGIDs.size());
-    TEUCHOS_ASSERT(ierr == 0);
-  }
-  std::sort(allGIDs.begin(), allGIDs.end());
-
-  Teuchos::Array<int> result(numValues_);
-  const int stride = 1 + (allGIDs.size() - 1) / numValues_;
-  for (int i = 0; i < numValues_; ++i) {
-    result[i] = allGIDs[i * stride];
-  }
-  return result;
+  const Teuchos::Array<int> positions =
+    uniformPositions<int>(sourceMap.NumGlobalElements(), numValues_);
+  if (positions.size() == 0) return positions;
+
+  const Epetra_Comm &comm = sourceMap.Comm();
+
+  return selectRankedGIDs<int>(
+      std::vector<int>(sourceMap.MyGlobalElements(),
+                       sourceMap.MyGlobalElements() + sourceMap.NumMyElements()),
+      sourceMap.MinAllGID(), sourceMap.MaxAllGID(),
+      positions,
+      [&comm](int *myCounts, int *counts, int n) {
+        comm.SumAll(myCounts, counts, n);
+      });
 }
 #endif
 
@@ -50,6 +50,11 @@ public:
 
   void summarize (std::ostream &out = std::cout);
 
+  //! The monitored items of this rank, sorted by name
+  const monitor_map& items () const {
+    return itemMap_;
+  }
+
 protected:
   
   virtual string getStringValue (const monitored_type& val) = 0;
@@ -8,8 +8,140 @@
 
 #include "PerformanceContext.hpp"
 
+#include <Teuchos_Array.hpp>
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_PerformanceMonitorBase.hpp>
+#include <Teuchos_TestForException.hpp>
+#include <Teuchos_TimeMonitor.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
 namespace util {
 
+namespace {
+
+struct Statistics {
+  double min, mean, max, sum;
+};
+
+struct Summary {
+  string kind;
+  string name;
+  Statistics value;
+  Statistics calls;
+  bool hasCalls;
+};
+
+// Names of the items on any rank, in the same order on every rank
+template<class Monitor>
+Teuchos::Array<string> globalNames (const Teuchos::Comm<int>& comm,
+                                    const Monitor& monitor) {
+  Teuchos::Array<string> localNames;
+  for (auto& item : monitor.items())
+    localNames.push_back(item.first);
+  Teuchos::Array<string> names;
+  Teuchos::mergeCounterNames(comm, localNames, names, Teuchos::Union);
+  return names;
+}
+
+Teuchos::Array<Statistics> reduceStatistics (const Teuchos::Comm<int>& comm,
+                                             const Teuchos::Array<double>& local) {
+  const int n = local.size();
+  Teuchos::Array<Statistics> stats(n);
+  if (n == 0)
+    return stats;
+
+  Teuchos::Array<double> min(n), sum(n), max(n);
+  Teuchos::reduceAll<int, double>(comm, Teuchos::REDUCE_MIN, n, local.getRawPtr(), min.getRawPtr());
+  Teuchos::reduceAll<int, double>(comm, Teuchos::REDUCE_SUM, n, local.getRawPtr(), sum.getRawPtr());
+  Teuchos::reduceAll<int, double>(comm, Teuchos::REDUCE_MAX, n, local.getRawPtr(), max.getRawPtr());
+  for (int i = 0; i < n; ++i) {
+    stats[i].min = min[i];
+    stats[i].mean = sum[i] / comm.getSize();
+    stats[i].max = max[i];
+    stats[i].sum = sum[i];
+  }
+  return stats;
+}
+
+string jsonString (const string& s) {
+  std::ostringstream os;
+  os << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+         << static_cast<int>(c) << std::dec << std::setfill(' ');
+    else
+      os << c;
+  }
+  os << '"';
+  return os.str();
+}
+
+string csvString (const string& s) {
+  if (s.find_first_of(",\"\n") == string::npos)
+    return s;
+  string quoted = "\"";
+  for (char c : s) {
+    if (c == '"')
+      quoted += '"';
+    quoted += c;
+  }
+  return quoted + '"';
+}
+
+void writeJSON (std::ostream& os, const Statistics& stats) {
+  os << "{\"min\": " << stats.min << ", \"mean\": " << stats.mean
+     << ", \"max\": " << stats.max << ", \"sum\": " << stats.sum << "}";
+}
+
+void writeJSON (std::ostream& os, const int numRanks,
+                const std::vector<Summary>& rows) {
+  const char* kinds[] = { "timers", "counters", "teuchos timers" };
+  os << "{\n  \"ranks\": " << numRanks;
+  for (const char* kind : kinds) {
+    os << ",\n  " << jsonString(kind) << ": [";
+    bool first = true;
+    for (auto& row : rows) {
+      if (row.kind != kind)
+        continue;
+      os << (first ? "\n    " : ",\n    ") << "{\"name\": " << jsonString(row.name);
+      os << ", " << (row.hasCalls ? "\"time\": " : "\"value\": ");
+      writeJSON(os, row.value);
+      if (row.hasCalls) {
+        os << ", \"calls\": ";
+        writeJSON(os, row.calls);
+      }
+      os << "}";
+      first = false;
+    }
+    os << (first ? "]" : "\n  ]");
+  }
+  os << "\n}\n";
+}
+
+void writeCSV (std::ostream& os, const std::vector<Summary>& rows) {
+  os << "kind,name,min,mean,max,sum,calls min,calls mean,calls max\n";
+  for (auto& row : rows) {
+    os << csvString(row.kind) << ',' << csvString(row.name) << ','
+       << row.value.min << ',' << row.value.mean << ','
+       << row.value.max << ',' << row.value.sum << ',';
+    if (row.hasCalls)
+      os << row.calls.min << ',' << row.calls.mean << ',' << row.calls.max;
+    else
+      os << ",,";
+    os << '\n';
+  }
+}
+
+}
+
 PerformanceContext PerformanceContext::instance_ = PerformanceContext();
 
 PerformanceContext& PerformanceContext::instance () {
@@ -17,6 +149,16 @@ PerformanceContext& PerformanceContext::instance () {
   return instance_;
 }
 
+PerformanceContext::SummaryFormat PerformanceContext::summaryFormat (
+    const string& name) {
+  if (name == "JSON")
+    return JSON;
+  TEUCHOS_TEST_FOR_EXCEPTION(name != "CSV", std::invalid_argument,
+      "Unknown performance summary format " << name
+      << ", valid formats are JSON and CSV" << std::endl);
+  return CSV;
+}
+
 void PerformanceContext::summarizeAll (
     Teuchos::Ptr<const Teuchos::Comm<int> > comm, std::ostream& out) {
   timeMonitor_.summarize(comm, out);
@@ -32,4 +174,89 @@ void PerformanceContext::summarizeAll (std::ostream& out) {
   summarizeAll(comm.ptr(), out);
 }
 
+void PerformanceContext::summarizeAll (
+    Teuchos::Ptr<const Teuchos::Comm<int> > comm, const string& fileName,
+    SummaryFormat format) {
+  std::vector<Summary> rows;
+
+  // Timers of this context; missing items count as zero on a rank
+  {
+    const Teuchos::Array<string> names = globalNames(*comm, timeMonitor_);
+    Teuchos::Array<double> times(names.size(), 0.0), calls(names.size(), 0.0);
+    for (int i = 0; i < names.size(); ++i) {
+      auto pos = timeMonitor_.items().find(names[i]);
+      if (pos == timeMonitor_.items().end())
+        continue;
+      times[i] = pos->second->totalElapsedTime();
+      calls[i] = pos->second->numCalls();
+    }
+    const Teuchos::Array<Statistics> timeStats = reduceStatistics(*comm, times);
+    const Teuchos::Array<Statistics> callStats = reduceStatistics(*comm, calls);
+    for (int i = 0; i < names.size(); ++i) {
+      Summary row = { "timers", names[i], timeStats[i], callStats[i], true };
+      rows.push_back(row);
+    }
+  }
+
+  {
+    const Teuchos::Array<string> names = globalNames(*comm, counterMonitor_);
+    Teuchos::Array<double> values(names.size(), 0.0);
+    for (int i = 0; i < names.size(); ++i) {
+      auto pos = counterMonitor_.items().find(names[i]);
+      if (pos != counterMonitor_.items().end())
+        values[i] = pos->second->value();
+    }
+    const Teuchos::Array<Statistics> stats = reduceStatistics(*comm, values);
+    for (int i = 0; i < names.size(); ++i) {
+      Summary row = { "counters", names[i], stats[i], Statistics(), false };
+      rows.push_back(row);
+    }
+  }
+
+  // The global Teuchos timers, which include the linear solve
+  {
+    Teuchos::TimeMonitor::stat_map_type statData;
+    std::vector<std::string> statNames;
+    Teuchos::TimeMonitor::computeGlobalTimerStatistics(statData, statNames,
+                                                       comm, Teuchos::Union);
+    const int minIndex = std::find(statNames.begin(), statNames.end(), "MinOverProcs") - statNames.begin();
+    const int meanIndex = std::find(statNames.begin(), statNames.end(), "MeanOverProcs") - statNames.begin();
+    const int maxIndex = std::find(statNames.begin(), statNames.end(), "MaxOverProcs") - statNames.begin();
+    const int numStats = statNames.size();
+    if (minIndex < numStats && meanIndex < numStats && maxIndex < numStats) {
+      for (auto& timer : statData) {
+        const std::vector<std::pair<double, double> >& s = timer.second;
+        Summary row;
+        row.kind = "teuchos timers";
+        row.name = timer.first;
+        row.value.min = s[minIndex].first;
+        row.value.mean = s[meanIndex].first;
+        row.value.max = s[maxIndex].first;
+        row.value.sum = s[meanIndex].first * comm->getSize();
+        row.calls.min = s[minIndex].second;
+        row.calls.mean = s[meanIndex].second;
+        row.calls.max = s[maxIndex].second;
+        row.calls.sum = s[meanIndex].second * comm->getSize();
+        row.hasCalls = true;
+        rows.push_back(row);
+      }
+    }
+  }
+
+  int ok = 1;
+  if (comm->getRank() == 0) {
+    std::ofstream os(fileName.c_str());
+    os << std::setprecision(12);
+    if (format == JSON)
+      writeJSON(os, comm->getSize(), rows);
+    else
+      writeCSV(os, rows);
+    os.close();
+    ok = os ? 1 : 0;
+  }
+  Teuchos::broadcast<int, int>(*comm, 0, Teuchos::outArg(ok));
+  TEUCHOS_TEST_FOR_EXCEPTION(!ok, std::runtime_error,
+      "Could not write the performance summary " << fileName << std::endl);
+}
+
 }
@@ -23,12 +23,40 @@ namespace util {
 class PerformanceContext {
 public:
   
+  enum SummaryFormat {
+    JSON, CSV
+  };
+
   static PerformanceContext& instance();
   
+  //! "JSON" or "CSV"; throws on anything else
+  static SummaryFormat summaryFormat (const string& name);
+
   void summarizeAll (Teuchos::Ptr<const Teuchos::Comm<int> > comm,
                      std::ostream &out = std::cout);
   void summarizeAll (std::ostream &out = std::cout);
 
+  /**
+   *  \brief Write the statistics over all ranks to fileName (collective)
+   *
+   *  Timers are reported with the min/mean/max over the ranks of their
+   *  time and calls, counters with the min/mean/max and the sum over the
+   *  ranks. The timers of Teuchos::TimeMonitor (e.g. those of the linear
+   *  solvers) are appended with the same statistics, so that one file
+   *  covers the run. Rank 0 writes the file.
+   */
+  void summarizeAll (Teuchos::Ptr<const Teuchos::Comm<int> > comm,
+                     const string& fileName, SummaryFormat format);
+
+  //! Whether the PerformanceProbe instrumentation records anything
+  bool enabled () const {
+    return enabled_;
+  }
+
+  void setEnabled (bool enabled) {
+    enabled_ = enabled;
+  }
+
   TimeMonitor& timeMonitor () {
     return timeMonitor_;
   }
@@ -43,8 +71,13 @@ public:
   
 private:
   
+  PerformanceContext ()
+      : enabled_(false) {
+  }
+
   static PerformanceContext instance_;
   
+  bool            enabled_;
   TimeMonitor     timeMonitor_;
   CounterMonitor  counterMonitor_;
   VariableMonitor variableMonitor_;
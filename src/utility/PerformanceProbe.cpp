@@ -0,0 +1,54 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+// @HEADER
+
+#include "PerformanceProbe.hpp"
+#include "PerformanceContext.hpp"
+
+#include <Teuchos_TestForException.hpp>
+
+namespace util {
+
+void PerformanceProbe::setName (const string& name) {
+  TEUCHOS_TEST_FOR_EXCEPTION(depth_ != 0, std::logic_error,
+      "PerformanceProbe " << name_ << " renamed while running" << std::endl);
+  name_ = name;
+  timer_ = Teuchos::null;
+  cells_ = Teuchos::null;
+  bytes_ = Teuchos::null;
+}
+
+bool PerformanceProbe::start () {
+  PerformanceContext& context = PerformanceContext::instance();
+  if (!context.enabled())
+    return false;
+
+  if (timer_.is_null()) {
+    timer_ = context.timeMonitor()[name_];
+    cells_ = context.counterMonitor()[name_ + ": Cells"];
+    bytes_ = context.counterMonitor()[name_ + ": Bytes"];
+  }
+
+  if (depth_++ == 0) {
+    timer_->start();
+    timer_->incrementNumCalls();
+  }
+  return true;
+}
+
+void PerformanceProbe::stop (Counter::counter_type cells,
+                             Counter::counter_type bytes) {
+  if (depth_ == 0)
+    return;
+
+  if (--depth_ == 0)
+    timer_->stop();
+  cells_->add(cells);
+  bytes_->add(bytes);
+}
+
+}
@@ -0,0 +1,111 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+// @HEADER
+
+#ifndef UTIL_PERFORMANCEPROBE_HPP
+#define UTIL_PERFORMANCEPROBE_HPP
+
+/**
+ *  \file PerformanceProbe.hpp
+ *
+ *  \brief Low-overhead instrumentation of hot code regions
+ */
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Time.hpp>
+
+#include "Counter.hpp"
+#include "string.hpp"
+
+namespace util {
+
+/**
+ *  \brief Wall time, calls, cells and bytes of one instrumented region
+ *
+ *  The probe accumulates into the timer "<name>" and the counters
+ *  "<name>: Cells" and "<name>: Bytes" of PerformanceContext::instance().
+ *  They are looked up on the first start() after instrumentation has been
+ *  enabled, so a probe of a disabled context only costs a flag test.
+ *  Nested start()/stop() pairs of the same probe are timed once.
+ *
+ *  Probes are not thread safe; Albany::Application falls back to the serial
+ *  fill while instrumentation is enabled.
+ */
+class PerformanceProbe {
+public:
+
+  PerformanceProbe ()
+      : depth_(0) {
+  }
+
+  explicit PerformanceProbe (const string& name)
+      : name_(name), depth_(0) {
+  }
+
+  //! Rename the probe; only valid while it is not running
+  void setName (const string& name);
+
+  const string& name () const {
+    return name_;
+  }
+
+  //! Start timing; returns false, and does nothing, when disabled
+  bool start ();
+
+  //! Stop timing and record the work done since the matching start()
+  void stop (Counter::counter_type cells = 0, Counter::counter_type bytes = 0);
+
+private:
+
+  string name_;
+  int depth_;
+  Teuchos::RCP<Teuchos::Time> timer_;
+  Teuchos::RCP<Counter> cells_;
+  Teuchos::RCP<Counter> bytes_;
+};
+
+/**
+ *  \brief Scoped start()/stop() of a PerformanceProbe
+ */
+class PerformanceGuard {
+public:
+
+  PerformanceGuard (PerformanceProbe& probe, Counter::counter_type cells = 0,
+                    Counter::counter_type bytes = 0)
+      : probe_(probe.start() ? &probe : NULL), cells_(cells), bytes_(bytes) {
+  }
+
+  //! True when the probe is running, i.e. the work will be recorded
+  bool active () const {
+    return probe_ != NULL;
+  }
+
+  //! Set the work recorded on destruction, for counts only worth computing
+  //! when active()
+  void setWork (Counter::counter_type cells, Counter::counter_type bytes) {
+    cells_ = cells;
+    bytes_ = bytes;
+  }
+
+  ~PerformanceGuard () {
+    if (probe_ != NULL)
+      probe_->stop(cells_, bytes_);
+  }
+
+private:
+
+  PerformanceGuard (const PerformanceGuard&);
+  PerformanceGuard& operator= (const PerformanceGuard&);
+
+  PerformanceProbe* probe_;
+  Counter::counter_type cells_;
+  Counter::counter_type bytes_;
+};
+
+}
+
+#endif  // UTIL_PERFORMANCEPROBE_HPP
@@ -0,0 +1,338 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include "utility/PerformanceContext.hpp"
+#include "utility/PerformanceProbe.hpp"
+
+#include "Teuchos_DefaultComm.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "Teuchos_UnitTestHarness.hpp"
+#include "Teuchos_UnitTestRepository.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int repeats = 3;
+
+// Minimal JSON reader, enough to check the structure of the summary
+struct JsonValue {
+  enum Type { Number, String, Array, Object } type;
+  double number;
+  std::string string;
+  std::vector<std::string> keys;
+  std::vector<std::shared_ptr<JsonValue> > items;
+
+  const JsonValue& operator[] (const std::string& key) const {
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      if (keys[i] == key)
+        return *items[i];
+    throw std::runtime_error("Missing JSON key " + key);
+  }
+};
+
+class JsonParser {
+public:
+
+  explicit JsonParser (const std::string& text)
+      : text_(text), pos_(0) {
+  }
+
+  std::shared_ptr<JsonValue> parse () {
+    std::shared_ptr<JsonValue> value = parseValue();
+    skipSpace();
+    if (pos_ != text_.size())
+      throw std::runtime_error("Trailing characters after the JSON value");
+    return value;
+  }
+
+private:
+
+  void skipSpace () {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_])))
+      ++pos_;
+  }
+
+  void expect (char c) {
+    skipSpace();
+    if (pos_ >= text_.size() || text_[pos_] != c)
+      throw std::runtime_error(std::string("Expected '") + c + "' in JSON");
+    ++pos_;
+  }
+
+  bool accept (char c) {
+    skipSpace();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  std::string parseString () {
+    expect('"');
+    std::string s;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char c = text_[pos_++];
+      if (c == '\\') {
+        if (pos_ >= text_.size())
+          break;
+        c = text_[pos_++];
+        if (c == 'u') {
+          c = static_cast<char>(std::strtol(text_.substr(pos_, 4).c_str(), NULL, 16));
+          pos_ += 4;
+        }
+      }
+      s += c;
+    }
+    expect('"');
+    return s;
+  }
+
+  std::shared_ptr<JsonValue> parseValue () {
+    std::shared_ptr<JsonValue> value(new JsonValue());
+    skipSpace();
+    if (pos_ >= text_.size())
+      throw std::runtime_error("Unexpected end of JSON");
+    if (text_[pos_] == '{') {
+      value->type = JsonValue::Object;
+      expect('{');
+      if (!accept('}')) {
+        do {
+          value->keys.push_back(parseString());
+          expect(':');
+          value->items.push_back(parseValue());
+        } while (accept(','));
+        expect('}');
+      }
+    }
+    else if (text_[pos_] == '[') {
+      value->type = JsonValue::Array;
+      expect('[');
+      if (!accept(']')) {
+        do {
+          value->items.push_back(parseValue());
+        } while (accept(','));
+        expect(']');
+      }
+    }
+    else if (text_[pos_] == '"') {
+      value->type = JsonValue::String;
+      value->string = parseString();
+    }
+    else {
+      value->type = JsonValue::Number;
+      const char* begin = text_.c_str() + pos_;
+      char* end;
+      value->number = std::strtod(begin, &end);
+      if (end == begin)
+        throw std::runtime_error("Malformed JSON number");
+      pos_ += end - begin;
+    }
+    return value;
+  }
+
+  const std::string& text_;
+  std::size_t pos_;
+};
+
+std::string readFile (const std::string& fileName) {
+  std::ifstream is(fileName.c_str());
+  if (!is)
+    throw std::runtime_error("Could not open " + fileName);
+  std::ostringstream os;
+  os << is.rdbuf();
+  return os.str();
+}
+
+// Fields of one CSV line, with "" inside quotes standing for "
+std::vector<std::string> splitCSV (const std::string& line) {
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (std::size_t i = 0; i < line.size(); ++i) {
+    const char c = line[i];
+    if (quoted && c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+      fields.back() += line[++i];
+    else if (c == '"')
+      quoted = !quoted;
+    else if (c == ',' && !quoted)
+      fields.push_back(std::string());
+    else
+      fields.back() += c;
+  }
+  return fields;
+}
+
+// Each rank records the work of rank+1 cells, repeats times, through a
+// probe whose name needs escaping in both formats
+void recordWork (const std::string& probeName,
+                 const Teuchos::Comm<int>& comm) {
+  util::PerformanceContext::instance().setEnabled(true);
+  util::PerformanceProbe probe(probeName);
+  const util::Counter::counter_type cells = comm.getRank() + 1;
+  for (int i = 0; i < repeats; ++i) {
+    util::PerformanceGuard guard(probe);
+    if (guard.active())
+      guard.setWork(cells, 8*cells);
+  }
+  util::PerformanceContext::instance().setEnabled(false);
+
+  Teuchos::RCP<Teuchos::Time> timer =
+    Teuchos::TimeMonitor::getNewTimer(probeName + " Teuchos");
+  Teuchos::TimeMonitor timeMonitor(*timer);
+}
+
+// Expected statistics of the per-rank cell counts repeats*(rank+1)
+double cellsMin () {
+  return repeats;
+}
+
+double cellsMax (int numRanks) {
+  return repeats*numRanks;
+}
+
+double cellsSum (int numRanks) {
+  return repeats*numRanks*(numRanks + 1)/2;
+}
+
+} // namespace
+
+TEUCHOS_UNIT_TEST(util_PerformanceContext, SummaryFormatNames)
+{
+  TEST_EQUALITY(util::PerformanceContext::summaryFormat("JSON"),
+                util::PerformanceContext::JSON);
+  TEST_EQUALITY(util::PerformanceContext::summaryFormat("CSV"),
+                util::PerformanceContext::CSV);
+  TEST_THROW(util::PerformanceContext::summaryFormat("XML"), std::invalid_argument);
+}
+
+TEUCHOS_UNIT_TEST(util_PerformanceContext, JSONSummary)
+{
+  const Teuchos::RCP<const Teuchos::Comm<int> > comm =
+    Teuchos::DefaultComm<int>::getComm();
+  const int numRanks = comm->getSize();
+  const std::string probeName = "JSON \"Scatter\"\\Probe";
+  recordWork(probeName, *comm);
+
+  const std::string fileName = "utPerformanceContext.json";
+  util::PerformanceContext::instance().summarizeAll(
+    comm.ptr(), fileName, util::PerformanceContext::JSON);
+
+  const std::string text = readFile(fileName);
+  const std::shared_ptr<JsonValue> summary = JsonParser(text).parse();
+  TEST_EQUALITY(summary->type, JsonValue::Object);
+  TEST_EQUALITY((*summary)["ranks"].number, numRanks);
+
+  bool foundTimer = false;
+  const JsonValue& timers = (*summary)["timers"];
+  for (std::size_t i = 0; i < timers.items.size(); ++i) {
+    const JsonValue& timer = *timers.items[i];
+    if (timer["name"].string != probeName)
+      continue;
+    foundTimer = true;
+    TEST_EQUALITY(timer["calls"]["min"].number, repeats);
+    TEST_EQUALITY(timer["calls"]["max"].number, repeats);
+    TEST_EQUALITY(timer["calls"]["sum"].number, repeats*numRanks);
+    TEST_COMPARE(timer["time"]["min"].number, >=, 0.0);
+    TEST_COMPARE(timer["time"]["max"].number, >=, timer["time"]["mean"].number);
+  }
+  TEST_ASSERT(foundTimer);
+
+  int foundCounters = 0;
+  const JsonValue& counters = (*summary)["counters"];
+  for (std::size_t i = 0; i < counters.items.size(); ++i) {
+    const JsonValue& counter = *counters.items[i];
+    const double scale = counter["name"].string == probeName + ": Cells" ? 1 :
+                         counter["name"].string == probeName + ": Bytes" ? 8 : 0;
+    if (scale == 0)
+      continue;
+    ++foundCounters;
+    TEST_EQUALITY(counter["value"]["min"].number, scale*cellsMin());
+    TEST_EQUALITY(counter["value"]["max"].number, scale*cellsMax(numRanks));
+    TEST_EQUALITY(counter["value"]["sum"].number, scale*cellsSum(numRanks));
+    TEST_FLOATING_EQUALITY(counter["value"]["mean"].number,
+                           scale*cellsSum(numRanks)/numRanks, 1e-12);
+  }
+  TEST_EQUALITY(foundCounters, 2);
+
+  bool foundTeuchosTimer = false;
+  const JsonValue& teuchosTimers = (*summary)["teuchos timers"];
+  for (std::size_t i = 0; i < teuchosTimers.items.size(); ++i) {
+    const JsonValue& timer = *teuchosTimers.items[i];
+    if (timer["name"].string != probeName + " Teuchos")
+      continue;
+    foundTeuchosTimer = true;
+    TEST_EQUALITY(timer["calls"]["max"].number, 1);
+  }
+  TEST_ASSERT(foundTeuchosTimer);
+}
+
+TEUCHOS_UNIT_TEST(util_PerformanceContext, CSVSummary)
+{
+  const Teuchos::RCP<const Teuchos::Comm<int> > comm =
+    Teuchos::DefaultComm<int>::getComm();
+  const int numRanks = comm->getSize();
+  const std::string probeName = "CSV \"Scatter\", Probe";
+  recordWork(probeName, *comm);
+
+  const std::string fileName = "utPerformanceContext.csv";
+  util::PerformanceContext::instance().summarizeAll(
+    comm.ptr(), fileName, util::PerformanceContext::CSV);
+
+  std::istringstream is(readFile(fileName));
+  std::string line;
+  TEST_ASSERT(std::getline(is, line));
+  const std::vector<std::string> header = splitCSV(line);
+  TEST_EQUALITY(header.size(), 9u);
+  TEST_EQUALITY(header[0], "kind");
+  TEST_EQUALITY(header[1], "name");
+
+  bool foundTimer = false, foundTeuchosTimer = false;
+  int foundCounters = 0;
+  while (std::getline(is, line)) {
+    const std::vector<std::string> row = splitCSV(line);
+    TEST_EQUALITY(row.size(), header.size());
+    if (row.size() != header.size())
+      continue;
+    const std::string& kind = row[0];
+    const std::string& name = row[1];
+    if (kind == "timers" && name == probeName) {
+      foundTimer = true;
+      TEST_EQUALITY(std::atof(row[6].c_str()), repeats);
+      TEST_EQUALITY(std::atof(row[8].c_str()), repeats);
+    }
+    else if (kind == "counters" && (name == probeName + ": Cells" ||
+                                    name == probeName + ": Bytes")) {
+      ++foundCounters;
+      const double scale = name == probeName + ": Cells" ? 1 : 8;
+      TEST_EQUALITY(std::atof(row[2].c_str()), scale*cellsMin());
+      TEST_EQUALITY(std::atof(row[4].c_str()), scale*cellsMax(numRanks));
+      TEST_EQUALITY(std::atof(row[5].c_str()), scale*cellsSum(numRanks));
+      // Counters have no call statistics
+      TEST_ASSERT(row[6].empty() && row[7].empty() && row[8].empty());
+    }
+    else if (kind == "teuchos timers" && name == probeName + " Teuchos") {
+      foundTeuchosTimer = true;
+      TEST_EQUALITY(std::atof(row[8].c_str()), 1);
+    }
+  }
+  TEST_ASSERT(foundTimer);
+  TEST_EQUALITY(foundCounters, 2);
+  TEST_ASSERT(foundTeuchosTimer);
+}
+
+int main(int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}